@@ -2,12 +2,20 @@
 #include <stdlib.h>
 
 #include "arvore_llrb.h"
+#include "../set/estatisticas.h"
+#include "../set/executor.h"
 
 typedef NO *ARVLLRB;
 
 #define RED 1
 #define BLACK 0
 
+// Abaixo desse tamanho a subárvore é construída na própria thread
+#define CONSTRUCAO_MIN_PARALELO 16384
+
+// Profundidade máxima de um caminho: altura <= 2 * log2(n + 1)
+#define LLRB_ALTURA_MAX 128
+
 // Struct Nó
 typedef struct no {
   struct no *esq;
@@ -16,6 +24,18 @@ typedef struct no {
   int cor;
 } NO;
 
+// Subárvore de uma construção em lote entregue ao grupo de threads
+typedef struct construcao_llrb {
+  const int *chaves;
+  size_t n;
+  int altura_negra;
+  int threads;
+  int falha;
+  NO *raiz;
+  ESTATISTICAS *estat; // Contadores da thread que criou a tarefa
+  TAREFA tarefa;
+} CONSTRUCAO_LLRB;
+
 // Protocolo das Funções
 
 // Auxiliares
@@ -26,10 +46,6 @@ NO *rotacionar_direita_llrb(NO *root);
 NO *move2_esq_red(NO *root);
 NO *move2_dir_red(NO *root);
 NO *balancear_no_llrb(NO *root);
-NO *insere_no_llrb(NO *root, int chave, int *resp);
-NO *remove_no_llrb(NO *root, int chave);
-NO *removerMenor(NO *root);
-NO *procuraMenor(NO *root);
 
 int arvllrb_consultar(ARVLLRB *raiz, int chave);
 
@@ -38,7 +54,22 @@ void no_apagar_llrb(NO *no);
 
 NO *obter_esquerda_llrb(NO *no);
 NO *obter_direita_llrb(NO *no);
-int obter_valor_llrb(NO *no);
+int obter_valor_llrb(NO *no, int *valor);
+
+void no_empilhar_esquerda_llrb(ITERADOR *it, NO *no);
+
+NO *criar_no_llrb(int chave, int cor, int *falha);
+size_t max_nos_llrb(int altura_negra);
+int no_altura_llrb(NO *no);
+NO *no_construir_llrb(const int *chaves, size_t n, int altura_negra,
+                      int threads, int *falha);
+void construir_llrb_tarefa(void *arg);
+
+int altura_negra_llrb(NO *no);
+NO *no_juntar_llrb(NO *menores, int hm, NO *meio, NO *maiores, int hM,
+                   int *altura);
+void no_dividir_llrb(NO *no, int h, int chave, NO **menores, int *hm,
+                     NO **maiores, int *hM);
 
 // Principais
 
@@ -49,6 +80,19 @@ void arvllrb_imprimir(ARVLLRB *raiz);
 void arvllrb_apagar(ARVLLRB **raiz);
 ARVLLRB *arvllrb_criar(void);
 
+void arvllrb_iterador(ARVLLRB *raiz, ITERADOR *it);
+int arvllrb_iterador_proximo(ITERADOR *it, int *valor);
+int arvllrb_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+int arvllrb_construir(ARVLLRB *raiz, const int *chaves, size_t n,
+                      int threads);
+int arvllrb_altura(ARVLLRB *raiz);
+
+int arvllrb_dividir(ARVLLRB *raiz, int chave, ARVLLRB *menores,
+                    ARVLLRB *maiores);
+int arvllrb_juntar(ARVLLRB *A, ARVLLRB *B);
+int arvllrb_extremos(ARVLLRB *raiz, int *menor, int *maior);
+
 // Função para criar arvllrb
 ARVLLRB *arvllrb_criar(void) {
   ARVLLRB *raiz = (ARVLLRB *)malloc(sizeof(ARVLLRB));
@@ -70,6 +114,8 @@ int cor_no(NO *H) {
 
 // Função para trocar a cor do nó, e de seus filhos.
 void troca_cor(NO *h) {
+  ESTAT_CONTAR(trocas_cor, 1);
+
   // Faz a troca para o inverso da cor atual (apenas 2 possibilidades)
   h->cor = !h->cor;
 
@@ -88,6 +134,8 @@ void troca_cor(NO *h) {
 
 // Rotação à direita - nós tendendo à esquerda
 NO *rotacionar_direita_llrb(NO *root) {
+  ESTAT_CONTAR(rotacoes_llrb, 1);
+
   // Defini-se o novoRoot
   NO *novoRoot = root->esq;
 
@@ -106,6 +154,7 @@ NO *rotacionar_direita_llrb(NO *root) {
 
 // Rotação à esquerda - nós tendendo à direita
 NO *rotacionar_esquerda_llrb(NO *root) {
+  ESTAT_CONTAR(rotacoes_llrb, 1);
   NO *novoRoot = root->dir;
   root->dir = novoRoot->esq;
 
@@ -125,6 +174,8 @@ NO *rotacionar_esquerda_llrb(NO *root) {
  * @return Ponteiro para o nó ajustado após o movimento.
  */
 NO *move2_esq_red(NO *root) {
+  ESTAT_CONTAR(movimentos_red, 1);
+
   // Troca as cores do nó atual e seus filhos (simula "emprestar" cor).
   troca_cor(root);
   /*
@@ -157,6 +208,8 @@ NO *move2_esq_red(NO *root) {
  * @return Ponteiro para o nó ajustado após o movimento.
  */
 NO *move2_dir_red(NO *root) {
+  ESTAT_CONTAR(movimentos_red, 1);
+
   // Troca as cores do nó atual e seus filhos.
   troca_cor(root);
   /*
@@ -174,7 +227,7 @@ NO *move2_dir_red(NO *root) {
   */
 
   if (cor_no(root->esq->esq) == RED) {
-    root = rotacionar_esquerda_llrb(root); // Rotaciona o nó atual à esquerda.
+    root = rotacionar_direita_llrb(root); // Rotaciona o nó atual à direita.
     troca_cor(root);                  // Restaura as cores.
   }
 
@@ -200,7 +253,7 @@ NO *balancear_no_llrb(NO *root) {
           B     B
   */
 
-  if (cor_no(root->dir) == RED) {
+  if (cor_no(root->dir) == RED && cor_no(root->esq) == BLACK) {
     root = rotacionar_esquerda_llrb(root);
   }
 
@@ -217,8 +270,7 @@ NO *balancear_no_llrb(NO *root) {
           /   \
          B     B
   */
-  if (root->esq != NULL && cor_no(root->dir) == RED &&
-      cor_no(root->esq->esq) == RED) {
+  if (cor_no(root->esq) == RED && cor_no(root->esq->esq) == RED) {
     root = rotacionar_direita_llrb(root);
   }
 
@@ -241,169 +293,149 @@ NO *balancear_no_llrb(NO *root) {
   return root;
 }
 
-/**
- * @brief Insere uma chave na árvore Rubro-Negra.
- *
- * @param raiz Ponteiro para o ponteiro da raiz da árvore.
- * @param chave Chave a ser inserida.
- * @return 1 se a inserção for bem-sucedida, 0 caso contrário.
- */
+/*
+    Inserção iterativa: a descida guarda em `pilha` o endereço de cada
+    ponteiro percorrido (a raiz ou o campo esq/dir do pai), então a subida
+    rebalanceia cada nível reescrevendo o ponteiro no lugar, sem recursão.
+*/
 int arvllrb_inserir(ARVLLRB *raiz, int chave) {
-  int resp;
-
-  // Insere a chave na subárvore.
-  *(raiz) = insere_no_llrb(*raiz, chave, &resp);
-
-  // Garante que a raiz sempre será preta após a inserção.
-  if ((*raiz) != NULL)
-    (*raiz)->cor = BLACK;
-
-  return resp;
-}
-
-/**
- * @brief Insere um nó em uma subárvore Rubro-Negra.
- *
- * @param root Ponteiro para a raiz da subárvore.
- * @param chave Chave a ser inserida.
- * @param resp Ponteiro para o código de resposta da operação.
- * @return Ponteiro para o nó raiz ajustado após a inserção.
- */
-NO *insere_no_llrb(NO *root, int chave, int *resp) {
-  if (root == NULL) {
-    // Cria um novo nó vermelho com a chave.
-    NO *novo = (NO *)malloc(sizeof(NO));
-
-    if (!novo) {
-      fprintf(stderr, "Erro: Falha na alocação de memória\n");
-      *resp = 0;
-      return NULL;
-    }
-
-    novo->chave = chave;
-    novo->cor = RED;
-    novo->dir = novo->esq = NULL;
-    *resp = 1;
-    return novo;
+  NO **pilha[LLRB_ALTURA_MAX];
+  int topo = 0;
+  NO **link = raiz;
+
+  while (*link != NULL) {
+    NO *h = *link;
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(chave == h->chave))
+      return 0; // Chave já existe: a árvore não foi alterada
+    pilha[topo++] = link;
+    link = ESTAT_CMP(chave < h->chave) ? &h->esq : &h->dir;
   }
 
-  // Verifica se a chave já existe.
-  if (chave == root->chave)
-    *resp = 0;
-  else {
-    // Insere na subárvore esquerda ou direita.
-    if (chave < root->chave)
-      root->esq = insere_no_llrb(root->esq, chave, resp);
-    else
-      root->dir = insere_no_llrb(root->dir, chave, resp);
+  // Cria um novo nó vermelho com a chave.
+  NO *novo = (NO *)malloc(sizeof(NO));
+  if (!novo) {
+    fprintf(stderr, "Erro: Falha na alocação de memória\n");
+    return 0;
   }
+  ESTAT_ALOCAR(sizeof(NO));
+  novo->chave = chave;
+  novo->cor = RED;
+  novo->dir = novo->esq = NULL;
+  *link = novo;
 
-  // Balanceia a árvore após a inserção.
-  if (cor_no(root->dir) == RED && cor_no(root->esq) == BLACK) {
-    root = rotacionar_esquerda_llrb(root);
-  }
+  // O novo nó ficou abaixo de todos os nós visitados na descida
+  ESTAT_ALTURA(topo + 1);
 
-  if (cor_no(root->esq) == RED && cor_no(root->esq->esq) == RED) {
-    root = rotacionar_direita_llrb(root);
-  }
-
-  if (cor_no(root->esq) == RED && cor_no(root->dir) == RED) {
-    troca_cor(root);
+  /*
+    Balanceia subindo. Uma subárvore que termina preta não muda nada para
+    o pai (ela não é filho vermelho nem pode formar dois vermelhos
+    seguidos), então a subida para ali.
+  */
+  while (topo > 0) {
+    link = pilha[--topo];
+    *link = balancear_no_llrb(*link);
+    if ((*link)->cor == BLACK)
+      break;
   }
 
-  return root;
-}
-int arvllrb_remover(ARVLLRB *root, int chave) {
-  // Verifica se a chave existe na árvore antes de tentar removê-la
-  if (arvllrb_consultar(root, chave)) {
-    NO *h = *root; // Salva a raiz atual
-
-    // Remove o nó com a chave especificada e reorganiza a árvore
-    *root = remove_no_llrb(h, chave);
-
-    // Se a árvore não estiver vazia, garante que a raiz seja preta
-    if (*root != NULL)
-      (*root)->cor = BLACK;
-
-    return 1; // Retorna sucesso
-  } else {
-    return 0; // Retorna falha (chave não encontrada)
-  }
+  // Garante que a raiz sempre será preta após a inserção.
+  (*raiz)->cor = BLACK;
+  return 1;
 }
 
-NO *remove_no_llrb(NO *root, int chave) {
-  if (chave < root->chave) {
-    // Navega para a subárvore esquerda se a chave for menor
-    if (cor_no(root->esq) == BLACK && cor_no(root->esq->esq) == BLACK)
-      root = move2_esq_red(root); // Prepara a subárvore esquerda para remoção
+/*
+    Remoção iterativa de cima para baixo em uma única descida, sem consulta
+    prévia: a cada nível o nó seguinte do caminho é preparado (move2_*_red)
+    para não ser um nó preto isolado, então a folha removida nunca deixa a
+    árvore desbalanceada. Se a chave não existir a descida para em uma
+    folha; as preparações já feitas são desfeitas pela subida normal.
+*/
+int arvllrb_remover(ARVLLRB *raiz, int chave) {
+  NO **pilha[LLRB_ALTURA_MAX];
+  int topo = 0, removido = 0;
+  NO **link = raiz;
+
+  while (*link != NULL) {
+    NO *h = *link;
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(chave < h->chave)) {
+      if (h->esq == NULL)
+        break; // Chave não encontrada
+
+      // Prepara a subárvore esquerda para remoção
+      if (cor_no(h->esq) == BLACK && cor_no(h->esq->esq) == BLACK)
+        *link = h = move2_esq_red(h);
+      pilha[topo++] = link;
+      link = &h->esq;
+      continue;
+    }
 
-    // Continua a remoção recursivamente na subárvore esquerda
-    root->esq = remove_no_llrb(root->esq, chave);
-  } else {
-    // Garante que a subárvore direita esteja balanceada
-    if (cor_no(root->esq) == RED)
-      root = rotacionar_direita_llrb(root); // Rotaciona para a direita se necessário
-
-    // Caso a chave seja encontrada e o nó não tenha subárvores
-    if (chave == root->chave && (root->dir == NULL)) {
-      free(root);  // Libera o nó atual
-      return NULL; // Retorna nulo para "remover" o nó
+    // Garante que a subárvore direita possa emprestar um nó vermelho
+    if (cor_no(h->esq) == RED)
+      *link = h = rotacionar_direita_llrb(h);
+
+    // Chave encontrada em uma folha
+    if (ESTAT_CMP(chave == h->chave) && h->dir == NULL) {
+      free(h);
+      ESTAT_LIBERAR(sizeof(NO));
+      *link = NULL;
+      removido = 1;
+      break;
     }
+    if (h->dir == NULL)
+      break; // Chave não encontrada
 
     // Prepara a subárvore direita se necessário
-    if (cor_no(root->dir) == BLACK && cor_no(root->dir->esq) == BLACK)
-      root = move2_dir_red(root);
-
-    // Caso a chave seja encontrada, substitui pelo sucessor
-    if (chave == root->chave) {
-      NO *sucessor =
-          procuraMenor(root->dir);   // Encontra o menor na subárvore direita
-      root->chave = sucessor->chave; // Substitui a chave do nó atual
-      root->dir = removerMenor(root->dir); // Remove o sucessor
-    } else {
-      // Continua a remoção recursivamente na subárvore direita
-      root->dir = remove_no_llrb(root->dir, chave);
+    if (cor_no(h->dir) == BLACK && cor_no(h->dir->esq) == BLACK)
+      *link = h = move2_dir_red(h);
+    pilha[topo++] = link;
+    link = &h->dir;
+
+    if (ESTAT_CMP(chave == h->chave)) {
+      // Substitui pela menor chave da subárvore direita e remove aquele nó,
+      // continuando a mesma descida
+      NO *m;
+      while ((m = *link)->esq != NULL) {
+        ESTAT_VISITAR();
+        if (cor_no(m->esq) == BLACK && cor_no(m->esq->esq) == BLACK)
+          *link = m = move2_esq_red(m);
+        pilha[topo++] = link;
+        link = &m->esq;
+      }
+      h->chave = m->chave;
+      free(m);
+      ESTAT_LIBERAR(sizeof(NO));
+      *link = NULL;
+      removido = 1;
+      break;
     }
   }
 
-  // Após qualquer alteração, garante que a árvore permaneça balanceada
-  return balancear_no_llrb(root);
-}
+  // Nó onde a descida parou sem remover também pode ter sido rotacionado
+  if (*link != NULL)
+    *link = balancear_no_llrb(*link);
 
-NO *removerMenor(NO *root) {
-  // Se o nó atual é o menor (não possui filho à esquerda)
-  if (root->esq == NULL) {
-    free(root);  // Libera o nó atual
-    return NULL; // Retorna nulo para "remover" o nó
+  // Após qualquer alteração, garante que a árvore permaneça balanceada
+  while (topo > 0) {
+    link = pilha[--topo];
+    *link = balancear_no_llrb(*link);
   }
 
-  // Prepara a subárvore esquerda, se necessário
-  if (cor_no(root->esq) == BLACK && cor_no(root->esq->esq) == BLACK)
-    root = move2_esq_red(root);
-
-  // Continua a remoção recursivamente na subárvore esquerda
-  root->esq = removerMenor(root->esq);
-
-  // Garante que a árvore esteja balanceada após a remoção
-  return balancear_no_llrb(root);
-}
-
-NO *procuraMenor(NO *root) {
-  NO *busca_no = root;
-
-  // Navega para a esquerda até encontrar o menor nó
-  while (busca_no->esq != NULL)
-    busca_no = busca_no->esq;
+  // Se a árvore não estiver vazia, garante que a raiz seja preta
+  if (*raiz != NULL)
+    (*raiz)->cor = BLACK;
 
-  return busca_no; // Retorna o menor nó encontrado
+  return removido;
 }
 
 int arvllrb_consultar(ARVLLRB *raiz, int chave) {
   NO *atual = *raiz;
   while (atual != NULL) {
-    if (chave == atual->chave)
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(chave == atual->chave))
       return 1; // Chave encontrada
-    if (chave < atual->chave)
+    if (ESTAT_CMP(chave < atual->chave))
       atual = atual->esq;
     else
       atual = atual->dir;
@@ -434,6 +466,7 @@ void no_apagar_llrb(NO *no) {
     no_apagar_llrb(no->esq);
     no_apagar_llrb(no->dir);
     free(no);
+    ESTAT_LIBERAR(sizeof(NO));
   }
 }
 
@@ -441,6 +474,7 @@ void no_apagar_llrb(NO *no) {
 void arvllrb_apagar(ARVLLRB **raiz) {
   if (raiz != NULL && *raiz != NULL) {
     no_apagar_llrb(**raiz);
+    free(*raiz);
     *raiz = NULL; // Garante que a raiz seja setada para NULL
   }
 }
@@ -457,12 +491,376 @@ NO *obter_direita_llrb(NO *no) {
     return no->dir;
 }
 
-int obter_valor_llrb(NO *no) {
-    if (!no) {
-        printf("Erro: nó LLRB inválido.\n");
-        return -1;
+int obter_valor_llrb(NO *no, int *valor) {
+    if (!no)
+        return 0;
+    *valor = no->chave;
+    return 1;
+}
+
+// Empilha o nó e todo o seu caminho mais à esquerda
+void no_empilhar_esquerda_llrb(ITERADOR *it, NO *no) {
+  while (no != NULL) {
+    iterador_empilhar(it, no);
+    no = no->esq;
+  }
+}
+
+// Iterador em ordem com pilha explícita (mesma ideia da AVL)
+void arvllrb_iterador(ARVLLRB *raiz, ITERADOR *it) {
+  iterador_iniciar(it, raiz);
+  if (raiz != NULL)
+    no_empilhar_esquerda_llrb(it, *raiz);
+}
+
+int arvllrb_iterador_proximo(ITERADOR *it, int *valor) {
+  NO *no = (NO *)iterador_desempilhar(it);
+  if (no == NULL)
+    return 0;
+
+  *valor = no->chave;
+  no_empilhar_esquerda_llrb(it, no->dir);
+  return 1;
+}
+
+int arvllrb_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  while (it->topo > 0) {
+    NO *topo = (NO *)iterador_topo(it);
+    if (topo->chave >= alvo)
+      return arvllrb_iterador_proximo(it, valor);
+
+    iterador_desempilhar(it);
+
+    // Subárvore direita inteira menor que o alvo: descarta sem descer
+    NO *abaixo = (NO *)iterador_topo(it);
+    if (abaixo != NULL && abaixo->chave < alvo)
+      continue;
+
+    NO *no = topo->dir;
+    while (no != NULL) {
+      if (no->chave >= alvo) {
+        iterador_empilhar(it, no);
+        no = no->esq;
+      } else {
+        no = no->dir;
+      }
+    }
+  }
+  return 0;
+}
+
+// Cria um nó isolado da cor pedida (usado na construção em lote)
+NO *criar_no_llrb(int chave, int cor, int *falha) {
+  NO *novo = (NO *)malloc(sizeof(NO));
+  if (!novo) {
+    *falha = 1;
+    return NULL;
+  }
+  ESTAT_ALOCAR(sizeof(NO));
+  novo->chave = chave;
+  novo->cor = cor;
+  novo->esq = novo->dir = NULL;
+  return novo;
+}
+
+// Maior quantidade de nós de uma LLRB com a altura negra dada (3^h - 1),
+// ou seja, de uma árvore 2-3 só com nós de 2 chaves
+size_t max_nos_llrb(int altura_negra) {
+  size_t p = 1;
+  for (int i = 0; i < altura_negra; i++)
+    p *= 3;
+  return p - 1;
+}
+
+/*
+    Construção em lote pensando na árvore 2-3 equivalente: uma subárvore de
+    altura negra h tem entre 2^h - 1 e 3^h - 1 chaves. Se as chaves cabem
+    em um nó de 1 chave (nó preto com dois filhos de altura h - 1), usa-se
+    ele; senão, um nó de 2 chaves (nó preto com filho esquerdo vermelho) e
+    três filhos de altura h - 1. Assim a árvore já nasce válida e caída à
+    esquerda, sem rotações nem trocas de cor.
+*/
+NO *no_construir_llrb(const int *chaves, size_t n, int altura_negra,
+                      int threads, int *falha) {
+  if (n == 0 || altura_negra == 0)
+    return NULL;
+
+  size_t max_filho = max_nos_llrb(altura_negra - 1);
+  CONSTRUCAO_LLRB esq = {chaves, 0,    altura_negra - 1, threads / 2,
+                         0,      NULL, ESTAT_ATUAL()};
+  NO *raiz, *pai_esq;
+
+  if (n - 1 <= 2 * max_filho) {
+    // Nó de 1 chave: [esq] chave [dir]
+    size_t a = n / 2;
+    raiz = criar_no_llrb(chaves[a], BLACK, falha);
+    if (!raiz)
+      return NULL;
+    esq.n = a;
+    pai_esq = raiz;
+    chaves += a + 1;
+    n -= a + 1;
+  } else {
+    // Nó de 2 chaves: [x] k1 [y] k2 [z]
+    size_t resto = n - 2;
+    size_t x = (resto + 2) / 3, y = (resto + 1) / 3;
+    raiz = criar_no_llrb(chaves[x + 1 + y], BLACK, falha);
+    NO *vermelho = criar_no_llrb(chaves[x], RED, falha);
+    if (!raiz || !vermelho) {
+      no_apagar_llrb(raiz);
+      no_apagar_llrb(vermelho);
+      return NULL;
+    }
+    raiz->esq = vermelho;
+    vermelho->dir =
+        no_construir_llrb(chaves + x + 1, y, altura_negra - 1, 1, falha);
+    esq.n = x;
+    pai_esq = vermelho;
+    chaves += x + 1 + y + 1;
+    n -= x + 1 + y + 1;
+  }
+
+  int paralelo = threads > 1 && esq.n >= CONSTRUCAO_MIN_PARALELO;
+  if (paralelo) {
+    tarefa_iniciar(&esq.tarefa, construir_llrb_tarefa, &esq);
+    tarefa_lancar(&esq.tarefa);
+  } else {
+    pai_esq->esq = no_construir_llrb(esq.chaves, esq.n, altura_negra - 1,
+                                     threads / 2, falha);
+  }
+
+  raiz->dir = no_construir_llrb(chaves, n, altura_negra - 1,
+                                threads - threads / 2, falha);
+
+  if (paralelo) {
+    tarefa_esperar(&esq.tarefa);
+    pai_esq->esq = esq.raiz;
+    if (esq.falha)
+      *falha = 1;
+  }
+
+  return raiz;
+}
+
+void construir_llrb_tarefa(void *arg) {
+  CONSTRUCAO_LLRB *c = (CONSTRUCAO_LLRB *)arg;
+  ESTAT_USAR(c->estat);
+  c->raiz = no_construir_llrb(c->chaves, c->n, c->altura_negra, c->threads,
+                              &c->falha);
+}
+
+int arvllrb_construir(ARVLLRB *raiz, const int *chaves, size_t n,
+                      int threads) {
+  if (raiz == NULL)
+    return -1;
+
+  // Substitui o conteúdo anterior da árvore
+  no_apagar_llrb(*raiz);
+  *raiz = NULL;
+
+  // Altura negra da árvore binária completa: floor(log2(n + 1))
+  int altura_negra = 0;
+  while (((size_t)2 << altura_negra) - 1 <= n)
+    altura_negra++;
+
+  int falha = 0;
+  NO *nova = no_construir_llrb(chaves, n, altura_negra,
+                               threads < 1 ? 1 : threads, &falha);
+  if (falha) {
+    no_apagar_llrb(nova);
+    return 0;
+  }
+
+  *raiz = nova;
+  return 1;
+}
+
+// Altura de uma subárvore (a LLRB não guarda alturas nos nós)
+int no_altura_llrb(NO *no) {
+  if (no == NULL)
+    return 0;
+  int e = no_altura_llrb(no->esq), d = no_altura_llrb(no->dir);
+  return (e > d ? e : d) + 1;
+}
+
+int arvllrb_altura(ARVLLRB *raiz) {
+  if (raiz == NULL)
+    return 0;
+  return no_altura_llrb(*raiz);
+}
+
+// Altura negra: nós pretos de qualquer caminho da subárvore até NULL
+int altura_negra_llrb(NO *no) {
+  int h = 0;
+  for (; no != NULL; no = no->esq)
+    h += no->cor == BLACK;
+  return h;
+}
+
+/*
+    Junção: todas as chaves de `menores` < meio < todas de `maiores`, com
+    alturas negras hm e hM. Com alturas iguais o meio vira a raiz, preta.
+    Senão, desce pela borda da árvore mais alta até um nó preto com a
+    altura negra da outra e coloca ali o meio, vermelho, com a árvore baixa
+    de filho: é o mesmo estado de uma inserção no meio da árvore, e a subida
+    com balancear_no_llrb() corrige os vermelhos como na inserção. Custa
+    O(|hm - hM| + 1). A altura negra do resultado volta em `altura`.
+*/
+NO *no_juntar_llrb(NO *menores, int hm, NO *meio, NO *maiores, int hM,
+                   int *altura) {
+  // Raízes vermelhas viram pretas (e ganham um nível negro)
+  if (cor_no(menores) == RED) {
+    menores->cor = BLACK;
+    hm++;
+  }
+  if (cor_no(maiores) == RED) {
+    maiores->cor = BLACK;
+    hM++;
+  }
+
+  if (hm == hM) {
+    meio->esq = menores;
+    meio->dir = maiores;
+    meio->cor = BLACK;
+    *altura = hm + 1;
+    return meio;
+  }
+
+  NO **pilha[LLRB_ALTURA_MAX];
+  int topo = 0;
+  NO *raiz;
+  NO **link;
+
+  if (hm > hM) {
+    // Na borda direita todo nó é preto (não há ligação vermelha à
+    // direita), então cada passo desce um nível negro
+    raiz = menores;
+    link = &raiz;
+    for (int h = hm; h > hM; h--) {
+      ESTAT_VISITAR();
+      pilha[topo++] = link;
+      link = &(*link)->dir;
+    }
+    meio->esq = *link;
+    meio->dir = maiores;
+  } else {
+    // Na borda esquerda os vermelhos não contam: para no nó preto (ou
+    // NULL) com a altura negra procurada
+    raiz = maiores;
+    link = &raiz;
+    int h = hM;
+    while (*link != NULL && ((*link)->cor == RED || h > hm)) {
+      ESTAT_VISITAR();
+      h -= (*link)->cor == BLACK;
+      pilha[topo++] = link;
+      link = &(*link)->esq;
     }
-    return no->chave; // Certifique-se de que 'chave' é inicializada corretamente.
+    meio->esq = menores;
+    meio->dir = *link;
+  }
+  meio->cor = RED;
+  *link = meio;
+
+  while (topo > 0) {
+    link = pilha[--topo];
+    *link = balancear_no_llrb(*link);
+  }
+
+  *altura = hm > hM ? hm : hM;
+  if (raiz->cor == RED) {
+    raiz->cor = BLACK;
+    (*altura)++;
+  }
+  return raiz;
+}
+
+/*
+    Divisão pela chave: desce o caminho da busca e, em cada nó, junta o nó
+    e a subárvore que ficou inteira do lado certo com o pedaço que voltou
+    da recursão. As alturas negras são passadas para baixo (h é a do nó
+    atual), sem recálculo; as junções somam O(log(n)) no total.
+*/
+void no_dividir_llrb(NO *no, int h, int chave, NO **menores, int *hm,
+                     NO **maiores, int *hM) {
+  if (no == NULL) {
+    *menores = *maiores = NULL;
+    *hm = *hM = 0;
+    return;
+  }
+  ESTAT_VISITAR();
+
+  // Altura negra dos filhos
+  int hf = h - (no->cor == BLACK);
+  NO *esq = no->esq, *dir = no->dir, *parte;
+  int hp;
+  if (ESTAT_CMP(no->chave < chave)) {
+    no_dividir_llrb(dir, hf, chave, &parte, &hp, maiores, hM);
+    *menores = no_juntar_llrb(esq, hf, no, parte, hp, hm);
+  } else {
+    no_dividir_llrb(esq, hf, chave, menores, hm, &parte, &hp);
+    *maiores = no_juntar_llrb(parte, hp, no, dir, hf, hM);
+  }
+}
+
+// Divide a árvore em `menores` (< chave) e `maiores` (>= chave); ela fica
+// vazia
+int arvllrb_dividir(ARVLLRB *raiz, int chave, ARVLLRB *menores,
+                    ARVLLRB *maiores) {
+  if (raiz == NULL || menores == NULL || maiores == NULL)
+    return -1;
+
+  no_apagar_llrb(*menores);
+  no_apagar_llrb(*maiores);
+  int hm, hM;
+  no_dividir_llrb(*raiz, altura_negra_llrb(*raiz), chave, menores, &hm,
+                  maiores, &hM);
+  *raiz = NULL;
+  return 1;
 }
 
+/*
+    Junta B ao fim de A (todas as chaves de A menores que as de B). A menor
+    chave de B vira o nó do meio; o nó novo é alocado antes de qualquer
+    mudança, então uma falha de alocação deixa as duas árvores intactas.
+*/
+int arvllrb_juntar(ARVLLRB *A, ARVLLRB *B) {
+  if (A == NULL || B == NULL)
+    return -1;
+  if (*B == NULL)
+    return 1;
+  if (*A == NULL) {
+    *A = *B;
+    *B = NULL;
+    return 1;
+  }
+
+  NO *menor = *B;
+  while (menor->esq != NULL)
+    menor = menor->esq;
+  int falha = 0;
+  NO *meio = criar_no_llrb(menor->chave, RED, &falha);
+  if (falha)
+    return 0;
+
+  arvllrb_remover(B, meio->chave);
+  int h;
+  *A = no_juntar_llrb(*A, altura_negra_llrb(*A), meio, *B,
+                      altura_negra_llrb(*B), &h);
+  *B = NULL;
+  return 1;
+}
 
+// Menor e maior chave, descendo as bordas da árvore em O(log(n))
+int arvllrb_extremos(ARVLLRB *raiz, int *menor, int *maior) {
+  if (raiz == NULL || *raiz == NULL)
+    return 0;
+
+  NO *no = *raiz;
+  while (no->esq != NULL)
+    no = no->esq;
+  *menor = no->chave;
+  for (no = *raiz; no->dir != NULL; no = no->dir)
+    ;
+  *maior = no->chave;
+  return 1;
+}
@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "../set/iterador.h"
+
 // Estrutura do nó da árvore LLRB.
 typedef struct no NO;
 
@@ -95,12 +97,110 @@ NO *obter_direita_llrb(NO *no);
 /**
  * @brief Obtém o valor armazenado em um nó da árvore LLRB.
  *
- * Esta função retorna o valor inteiro armazenado no nó especificado. Caso o
- * nó seja NULL, retorna 0 como valor padrão.
+ * Qualquer valor de `int` é uma chave válida, então a falha é indicada pelo
+ * retorno e não por um valor especial.
  *
  * @param no Ponteiro para o nó da árvore LLRB.
- * @return int Valor armazenado no nó, ou 0 se o nó for NULL.
+ * @param valor Recebe o valor armazenado no nó.
+ * @return int 1 se o valor foi obtido, ou 0 se o nó for NULL.
+ */
+int obter_valor_llrb(NO *no, int *valor);
+
+/**
+ * @brief Prepara um iterador em ordem crescente sobre a árvore rubro-negra.
+ *
+ * @param raiz Ponteiro para a raiz da árvore rubro-negra.
+ * @param it Iterador a ser preparado.
+ */
+void arvllrb_iterador(ARVLLRB *raiz, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por arvllrb_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 ao final do percurso.
+ */
+int arvllrb_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * @param it Iterador preparado por arvllrb_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 se não houver chave
+ * maior ou igual a `alvo`.
+ */
+int arvllrb_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Constrói a árvore rubro-negra a partir de chaves ordenadas e sem
+ * repetição.
+ *
+ * Monta em O(n) uma árvore já válida, sem rotações, substituindo o conteúdo
+ * anterior. Subárvores grandes são construídas em paralelo, como tarefas do
+ * grupo de threads compartilhado (set/executor.h), até o limite de `threads`
+ * tarefas.
+ *
+ * @param raiz Ponteiro para a raiz da árvore rubro-negra.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @param threads Quantidade máxima de threads a usar.
+ * @return int Retorna 1 se a construção foi bem-sucedida, 0 em caso de falha
+ * de alocação (a árvore fica vazia), ou -1 se a árvore for inválida.
+ */
+int arvllrb_construir(ARVLLRB *raiz, const int *chaves, size_t n,
+                      int threads);
+
+/**
+ * @brief Calcula a altura da árvore, percorrendo todos os nós (O(n)).
+ *
+ * @param raiz Ponteiro para a árvore.
+ * @return int Altura da árvore (0 se vazia).
+ */
+int arvllrb_altura(ARVLLRB *raiz);
+
+/**
+ * @brief Divide a árvore em duas pela chave, em O(log(n)).
+ *
+ * Nenhum nó é copiado nem realocado: os nós são redistribuídos por junções
+ * ao longo do caminho da busca, guiadas pela altura negra (ver
+ * arvllrb_juntar()).
+ *
+ * @param raiz Ponteiro para a árvore; fica vazia.
+ * @param chave Chave de corte.
+ * @param menores Recebe as chaves < chave (o conteúdo anterior é apagado).
+ * @param maiores Recebe as chaves >= chave (o conteúdo anterior é apagado).
+ * @return int Retorna 1 em caso de sucesso, ou -1 se alguma árvore for
+ * inválida.
+ */
+int arvllrb_dividir(ARVLLRB *raiz, int chave, ARVLLRB *menores,
+                    ARVLLRB *maiores);
+
+/**
+ * @brief Move todas as chaves de B para o fim de A, em O(log(n)).
+ *
+ * Todas as chaves de A devem ser menores que todas as de B (não é
+ * verificado; ver arvllrb_extremos()). A árvore de menor altura negra é
+ * pendurada na borda da outra e só esse caminho é rebalanceado.
+ *
+ * @param A Ponteiro para a árvore que recebe as chaves.
+ * @param B Ponteiro para a árvore de chaves maiores; fica vazia.
+ * @return int Retorna 1 em caso de sucesso, 0 em caso de falha de alocação
+ * (nada muda), ou -1 se alguma árvore for inválida.
+ */
+int arvllrb_juntar(ARVLLRB *A, ARVLLRB *B);
+
+/**
+ * @brief Obtém a menor e a maior chave da árvore, em O(log(n)).
+ *
+ * @param raiz Ponteiro para a árvore.
+ * @param menor Recebe a menor chave.
+ * @param maior Recebe a maior chave.
+ * @return int Retorna 1 se a árvore tem chaves, 0 se estiver vazia (ou for
+ * inválida).
  */
-int obter_valor_llrb(NO *no);
+int arvllrb_extremos(ARVLLRB *raiz, int *menor, int *maior);
 
 #endif
@@ -1,9 +1,12 @@
 #ifndef BST_AVL_H
 #define BST_AVL_H
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "../set/iterador.h"
+
 // Estrutura do nó da árvore AVL.
 typedef struct no NO;
 
@@ -103,12 +106,138 @@ NO *obter_direita_avl(NO *no);
 /**
  * @brief Obtém o valor armazenado em um nó da árvore AVL.
  *
- * Esta função retorna o valor inteiro armazenado no nó especificado. Caso o
- * nó seja NULL, retorna 0 como valor padrão.
+ * Qualquer valor de `int` é uma chave válida, então a falha é indicada pelo
+ * retorno e não por um valor especial.
  *
  * @param no Ponteiro para o nó da árvore AVL.
- * @return int Valor armazenado no nó, ou 0 se o nó for NULL.
+ * @param valor Recebe o valor armazenado no nó.
+ * @return int 1 se o valor foi obtido, ou 0 se o nó for NULL.
+ */
+int obter_valor_avl(NO *no, int *valor);
+
+/**
+ * @brief Prepara um iterador em ordem crescente sobre a árvore AVL.
+ *
+ * O iterador usa uma pilha explícita, sem recursão, e deve ser finalizado com
+ * iterador_finalizar() ao término do percurso.
+ *
+ * @param T Ponteiro para a árvore AVL.
+ * @param it Iterador a ser preparado.
+ */
+void avl_iterador(AVL *T, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por avl_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return 1 se uma chave foi obtida, 0 ao final do percurso.
+ */
+int avl_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * A busca parte da posição atual do iterador (apenas avança), descartando
+ * subárvores inteiras menores que `alvo`, em O(log(n)).
+ *
+ * @param it Iterador preparado por avl_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return 1 se uma chave foi obtida, 0 se não houver chave >= alvo.
+ */
+int avl_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Constrói a árvore AVL a partir de chaves ordenadas e sem repetição.
+ *
+ * Monta a árvore já balanceada em O(n), sem rotações, substituindo o conteúdo
+ * anterior. As duas metades de cada subárvore grande são construídas em
+ * paralelo, como tarefas do grupo de threads compartilhado (set/executor.h),
+ * até o limite de `threads` tarefas.
+ *
+ * @param T Ponteiro para a árvore AVL.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @param threads Quantidade máxima de threads a usar.
+ * @return 1 se a construção foi bem-sucedida, 0 em caso de falha de alocação
+ *         (a árvore fica vazia), ou -1 em caso de erro (ex.: ponteiro nulo).
  */
-int obter_valor_avl(NO *no);
+int avl_construir(AVL *T, const int *chaves, size_t n, int threads);
+
+/**
+ * @brief Retorna a altura da árvore AVL, em O(1).
+ *
+ * @param T Ponteiro para a árvore AVL.
+ * @return int Altura da árvore (0 se vazia).
+ */
+int avl_altura(AVL *T);
+
+/**
+ * @brief Divide a árvore AVL em duas pela chave, em O(log(n)).
+ *
+ * Nenhum nó é copiado nem realocado: os nós de T são redistribuídos por
+ * junções ao longo do caminho da busca (ver avl_juntar()).
+ *
+ * @param T Ponteiro para a árvore AVL; fica vazia.
+ * @param chave Chave de corte.
+ * @param menores Recebe as chaves < chave (o conteúdo anterior é apagado).
+ * @param maiores Recebe as chaves >= chave (o conteúdo anterior é apagado).
+ * @return 1 em caso de sucesso, ou -1 em caso de erro (ex.: ponteiro nulo).
+ */
+int avl_dividir(AVL *T, int chave, AVL *menores, AVL *maiores);
+
+/**
+ * @brief Move todas as chaves de B para o fim de A, em O(log(n)).
+ *
+ * Todas as chaves de A devem ser menores que todas as de B (não é
+ * verificado; ver avl_extremos()). A junção desce só pela borda direita da
+ * árvore mais alta, usando as alturas guardadas nos nós.
+ *
+ * @param A Ponteiro para a árvore que recebe as chaves.
+ * @param B Ponteiro para a árvore de chaves maiores; fica vazia.
+ * @return 1 em caso de sucesso, 0 em caso de falha de alocação (nada
+ *         muda), ou -1 em caso de erro (ex.: ponteiro nulo).
+ */
+int avl_juntar(AVL *A, AVL *B);
+
+/**
+ * @brief Obtém a menor e a maior chave da árvore, em O(log(n)).
+ *
+ * @param T Ponteiro para a árvore AVL.
+ * @param menor Recebe a menor chave.
+ * @param maior Recebe a maior chave.
+ * @return 1 se a árvore tem chaves, 0 se estiver vazia (ou for inválida).
+ */
+int avl_extremos(AVL *T, int *menor, int *maior);
+
+/*
+    A mesma árvore com chaves de outras larguras, para os conjuntos de
+    set/set_chave.h. Com <S> = U32, I64 ou U64 e <C> = uint32_t, int64_t ou
+    uint64_t, cada operação acima (menos impressão e acesso a nós) existe
+    como criar_avl_<s>() e avl_<s>_<operação>(), com o mesmo contrato e a
+    chave do tipo <C>; o código é o mesmo (bst_avl_modelo.h).
+*/
+#define AVL_DECLARAR(S, s, C)                                                  \
+  typedef struct no_##s NO_AVL_##S;                                            \
+  typedef NO_AVL_##S *AVL_##S;                                                 \
+  AVL_##S *criar_avl_##s(void);                                                \
+  void avl_##s##_apagar(AVL_##S **T);                                          \
+  int avl_##s##_buscar(AVL_##S *T, C chave);                                   \
+  int avl_##s##_inserir(AVL_##S *T, C chave);                                  \
+  int avl_##s##_remover(AVL_##S *T, C chave);                                  \
+  void avl_##s##_iterador(AVL_##S *T, ITERADOR *it);                           \
+  int avl_##s##_iterador_proximo(ITERADOR *it, C *valor);                      \
+  int avl_##s##_iterador_buscar(ITERADOR *it, C alvo, C *valor);               \
+  int avl_##s##_construir(AVL_##S *T, const C *chaves, size_t n, int threads); \
+  int avl_##s##_altura(AVL_##S *T);                                            \
+  int avl_##s##_dividir(AVL_##S *T, C chave, AVL_##S *menores,                 \
+                        AVL_##S *maiores);                                     \
+  int avl_##s##_juntar(AVL_##S *A, AVL_##S *B);                                \
+  int avl_##s##_extremos(AVL_##S *T, C *menor, C *maior);
+
+AVL_DECLARAR(U32, u32, uint32_t)
+AVL_DECLARAR(I64, i64, int64_t)
+AVL_DECLARAR(U64, u64, uint64_t)
 
 #endif // BST_AVL_H
@@ -0,0 +1,691 @@
+/*
+    Modelo da árvore AVL, parametrizado pelo tipo da chave. Este arquivo
+    não tem guarda de inclusão: bst_avl.c o inclui uma vez por tipo,
+    definindo antes
+
+      AVL_CHAVE    tipo da chave (ex.: int, uint64_t)
+      AVL_SUFIXO   sufixo dos nomes, vazio para `int` (ex.: _u64 ->
+                   avl_u64_inserir, no_inserir_avl_u64, struct no_u64)
+      AVL_ARVORE   tipo público da árvore (ex.: AVL, AVL_U64)
+
+    A instância com `int` gera exatamente a API de bst_avl.h.
+*/
+
+#ifndef AVL_JUNTAR
+#define AVL_COLAR(a, b) a##b
+#define AVL_JUNTAR(a, b) AVL_COLAR(a, b)
+#endif
+
+// Nomes públicos (avl<sufixo>_x) e auxiliares (x_avl<sufixo>)
+#define AVL_F(x) AVL_JUNTAR(AVL_JUNTAR(avl, AVL_SUFIXO), _##x)
+#define AVL_A(x) AVL_JUNTAR(x##_avl, AVL_SUFIXO)
+#define AVL_NO struct AVL_JUNTAR(no, AVL_SUFIXO)
+#define AVL_CONSTRUCAO AVL_A(construcao)
+
+// Struct Nó
+AVL_NO {
+  AVL_NO *esq;
+  AVL_NO *dir;
+  AVL_CHAVE chave;
+  int height;
+};
+
+// Metade de uma construção em lote entregue ao grupo de threads
+typedef struct AVL_CONSTRUCAO {
+  const AVL_CHAVE *chaves;
+  size_t n;
+  int threads;
+  int falha;
+  AVL_NO *raiz;
+  ESTATISTICAS *estat; // Contadores da thread que criou a tarefa
+  TAREFA tarefa;
+} AVL_CONSTRUCAO;
+
+// Protocolo das Funções
+
+// Auxiliares
+int AVL_A(altura_no)(AVL_NO *root);
+int AVL_A(max)(int a, int b);
+
+AVL_NO *AVL_A(criar_no)(AVL_CHAVE chave);
+
+AVL_NO *AVL_A(rotacionar_direita)(AVL_NO *root);
+AVL_NO *AVL_A(rotacionar_esquerda)(AVL_NO *root);
+
+AVL_NO *AVL_A(rotacionar_esquerda_direita)(AVL_NO *root);
+AVL_NO *AVL_A(rotacionar_direita_esquerda)(AVL_NO *root);
+
+int AVL_A(no_fator_b)(AVL_NO *root);
+AVL_NO *AVL_A(balancear_no)(AVL_NO *root);
+
+AVL_NO *AVL_A(no_inserir)(AVL_NO *root, AVL_CHAVE chave, int *resp);
+AVL_NO *AVL_A(no_min_valor)(AVL_NO *root);
+
+AVL_NO *AVL_A(no_remover)(AVL_NO *root, AVL_CHAVE chave, int *resp);
+
+AVL_NO *AVL_A(no_buscar)(AVL_NO *no, AVL_CHAVE chave);
+
+void AVL_A(no_apagar)(AVL_NO *no);
+
+void AVL_A(no_empilhar_esquerda)(ITERADOR *it, AVL_NO *no);
+
+AVL_NO *AVL_A(no_construir)(const AVL_CHAVE *chaves, size_t n, int threads,
+                            int *falha);
+void AVL_A(construir_tarefa)(void *arg);
+
+AVL_NO *AVL_A(no_juntar)(AVL_NO *menores, AVL_NO *meio, AVL_NO *maiores);
+void AVL_A(no_dividir)(AVL_NO *no, AVL_CHAVE chave, AVL_NO **menores,
+                       AVL_NO **maiores);
+
+// Principais
+int AVL_F(remover)(AVL_ARVORE *T, AVL_CHAVE chave);
+int AVL_F(inserir)(AVL_ARVORE *T, AVL_CHAVE chave);
+int AVL_F(buscar)(AVL_ARVORE *T, AVL_CHAVE chave);
+AVL_ARVORE *AVL_A(criar)(void);
+
+void AVL_F(apagar)(AVL_ARVORE **T);
+
+void AVL_F(iterador)(AVL_ARVORE *T, ITERADOR *it);
+int AVL_F(iterador_proximo)(ITERADOR *it, AVL_CHAVE *valor);
+int AVL_F(iterador_buscar)(ITERADOR *it, AVL_CHAVE alvo, AVL_CHAVE *valor);
+
+int AVL_F(construir)(AVL_ARVORE *T, const AVL_CHAVE *chaves, size_t n,
+                     int threads);
+int AVL_F(altura)(AVL_ARVORE *T);
+
+int AVL_F(dividir)(AVL_ARVORE *T, AVL_CHAVE chave, AVL_ARVORE *menores,
+                   AVL_ARVORE *maiores);
+int AVL_F(juntar)(AVL_ARVORE *A, AVL_ARVORE *B);
+int AVL_F(extremos)(AVL_ARVORE *T, AVL_CHAVE *menor, AVL_CHAVE *maior);
+
+// Função para criar a árvore
+AVL_ARVORE *AVL_A(criar)(void) {
+  AVL_ARVORE *T = (AVL_ARVORE *)malloc(sizeof(AVL_ARVORE));
+
+  *T = NULL; // Inicializa a raiz da árvore como NULL
+
+  return T;
+}
+
+// Função para obter a altura de um nó
+int AVL_A(altura_no)(AVL_NO *root) {
+  if (root == NULL) {
+    return 0;
+  }
+  return root->height;
+}
+
+// Função para calcular o máximo entre dois números
+int AVL_A(max)(int a, int b) { return a > b ? a : b; }
+
+// Função para criar um novo nó
+AVL_NO *AVL_A(criar_no)(AVL_CHAVE chave) {
+  AVL_NO *newNo = (AVL_NO *)malloc(sizeof(AVL_NO));
+  if (newNo == NULL) {
+    return NULL;
+  }
+  ESTAT_ALOCAR(sizeof(AVL_NO));
+  newNo->esq = newNo->dir = NULL;
+
+  // Altura do nó ao ser criado é 1
+  newNo->height = 1;
+  newNo->chave = chave;
+  return newNo;
+}
+
+// Rotação à direita
+/*
+    Apenas trocamos os vetores, os nomes estão bem sugestivos, e
+    pensamos o "filho_filho" como uma possível existência.
+*/
+AVL_NO *AVL_A(rotacionar_direita)(AVL_NO *root) {
+  // novoRoot é o esquerdo do root atual.
+  AVL_NO *novoRoot = root->esq;
+  AVL_NO *filho_filho = novoRoot->dir;
+
+  // Colocamos o novoRoot, que antes, fazendo uma altura maior, estava no meio
+  // dos filho_filho e do root, como o que faz uma "balança" com o root
+  novoRoot->dir = root;
+  // Perceba que não mexemos com a sub-árvore esquerda do novoRoot.
+  root->esq = filho_filho;
+
+  // Ajusta-se a altura de cada um dos nós que mexemos, menos o filho_filho
+  // que apenas foi de um nó para outro, não mexemos com sua esquerda nem
+  // direita sub-árvores.
+  root->height =
+      AVL_A(max)(AVL_A(altura_no)(root->esq), AVL_A(altura_no)(root->dir)) + 1;
+  novoRoot->height = AVL_A(max)(AVL_A(altura_no)(novoRoot->esq),
+                                AVL_A(altura_no)(novoRoot->dir)) +
+                     1;
+
+  return novoRoot;
+}
+
+// Rotação à esquerda
+// Segue a mesma proposta da rotação à direita. Só que agora
+// os nós tendem à direita.
+
+/*
+        (root)
+                        (novoRoot)
+
+                (filho_filho)
+
+*/
+AVL_NO *AVL_A(rotacionar_esquerda)(AVL_NO *root) {
+  AVL_NO *novoRoot = root->dir;
+  AVL_NO *filho_filho = novoRoot->esq;
+
+  novoRoot->esq = root;
+  root->dir = filho_filho;
+
+  root->height =
+      AVL_A(max)(AVL_A(altura_no)(root->esq), AVL_A(altura_no)(root->dir)) + 1;
+  novoRoot->height = AVL_A(max)(AVL_A(altura_no)(novoRoot->esq),
+                                AVL_A(altura_no)(novoRoot->dir)) +
+                     1;
+
+  return novoRoot;
+}
+
+// Rotação dupla à esquerda
+AVL_NO *AVL_A(rotacionar_esquerda_direita)(AVL_NO *root) {
+  /*
+  Estado inicial:
+
+          A
+
+      B
+
+           C
+
+
+
+
+  Rotação à esquerda do B e C
+
+          A
+
+      C
+
+  B
+
+
+
+  Rotação à direita de A - C - B
+
+      C
+
+  B       A
+
+
+  Veja que faz sentido, já que segue os pré-requisitos da Árvore Binária de
+  Busca
+  */
+
+  root->esq = AVL_A(rotacionar_esquerda)(root->esq);
+  return AVL_A(rotacionar_direita)(root);
+}
+
+// Rotação dupla à direita
+AVL_NO *AVL_A(rotacionar_direita_esquerda)(AVL_NO *root) {
+  root->dir = AVL_A(rotacionar_direita)(root->dir);
+  return AVL_A(rotacionar_esquerda)(root);
+}
+
+// Função para calcular o fator de balanceamento de um nó
+int AVL_A(no_fator_b)(AVL_NO *root) {
+  if (root == NULL) {
+    return 0;
+  }
+  return AVL_A(altura_no)(root->esq) - AVL_A(altura_no)(root->dir);
+}
+
+// Função para balancear a árvore AVL
+AVL_NO *AVL_A(balancear_no)(AVL_NO *root) {
+  int fb = AVL_A(no_fator_b)(root);
+
+  if (fb > 1 && AVL_A(no_fator_b)(root->esq) >= 0) {
+    ESTAT_CONTAR(rotacoes_simples, 1);
+    return AVL_A(rotacionar_direita)(root);
+  }
+
+  if (fb < -1 && AVL_A(no_fator_b)(root->dir) <= 0) {
+    ESTAT_CONTAR(rotacoes_simples, 1);
+    return AVL_A(rotacionar_esquerda)(root);
+  }
+
+  if (fb > 1 && AVL_A(no_fator_b)(root->esq) < 0) {
+    ESTAT_CONTAR(rotacoes_duplas, 1);
+    return AVL_A(rotacionar_esquerda_direita)(root);
+  }
+
+  if (fb < -1 && AVL_A(no_fator_b)(root->dir) > 0) {
+    ESTAT_CONTAR(rotacoes_duplas, 1);
+    return AVL_A(rotacionar_direita_esquerda)(root);
+  }
+
+  return root;
+}
+
+// Função para inserir um nó na árvore AVL
+AVL_NO *AVL_A(no_inserir)(AVL_NO *root, AVL_CHAVE chave, int *resp) {
+  if (root == NULL) {
+    // Se for nulo o nó atual, então pode criar o nó com a chave passada.
+    AVL_NO *novo = AVL_A(criar_no)(chave);
+    *resp = novo != NULL;
+    return novo;
+  }
+  ESTAT_VISITAR();
+  // Faz-se o ercurso para achar onde é possível (nó nulo) inserir o nó
+  if (ESTAT_CMP(chave > root->chave)) {
+    // Perceba que o retorno da função deve ser um NO*, logo, devemos passar
+    // o nó para receber a entrada dele mesmo na função recursivamente.
+    root->dir = AVL_A(no_inserir)(root->dir, chave, resp);
+  } else if (ESTAT_CMP(chave < root->chave)) {
+    root->esq = AVL_A(no_inserir)(root->esq, chave, resp);
+  } else {
+    // Se achou a chave, não podemos adicionar outro nó com a mesma chave
+    *resp = 0;
+    return root;
+  }
+
+  // Após inserir, devemos calcular novamente a altura do nó
+
+  root->height =
+      AVL_A(max)(AVL_A(altura_no)(root->esq), AVL_A(altura_no)(root->dir)) + 1;
+  // Pegamos o máximo e somamos um, já que somamos a altura deve mesmo
+
+  // Balanceamos o root (AVL)
+  return AVL_A(balancear_no)(root);
+}
+
+// Função para encontrar o valor mínimo em uma árvore AVL
+AVL_NO *AVL_A(no_min_valor)(AVL_NO *root) {
+  AVL_NO *aux = root;
+  // Retornamos o menor valor
+  while (aux && aux->esq) {
+    aux = aux->esq;
+  }
+  return aux;
+}
+
+// Função para remover um nó da árvore AVL
+AVL_NO *AVL_A(no_remover)(AVL_NO *root, AVL_CHAVE chave, int *resp) {
+  if (root == NULL) {
+    // Chegou ao fim do caminho sem achar a chave
+    return NULL;
+  }
+  ESTAT_VISITAR();
+  // Percurso em Ordem para achar a chave de acordo com o nó atual (root)
+  if (ESTAT_CMP(chave < root->chave)) {
+    root->esq = AVL_A(no_remover)(root->esq, chave, resp);
+  } else if (ESTAT_CMP(chave > root->chave)) {
+    root->dir = AVL_A(no_remover)(root->dir, chave, resp);
+  } else {
+    // Caso em que foi encontrado a chave.
+    *resp = 1;
+
+    // Resolvemos o caso 1, 2 (0 filhos, 1 filho), com um só if
+    if (root->esq == NULL || root->dir == NULL) {
+      AVL_NO *aux_apagar = root;
+
+      AVL_NO *temp = root->esq ? root->esq : root->dir;
+
+      free(aux_apagar);
+      ESTAT_LIBERAR(sizeof(AVL_NO));
+
+      return temp;
+
+      // Se nem o filho direito ou o esquerdo são nulos, então, ambos são
+      // verdadeiros.
+    } else {
+      AVL_NO *temp = AVL_A(no_min_valor)(root->dir);
+      // Pegamos o menor valor a direita, logo, o SUCESSOR
+
+      // Trocamos o valor da chave que buscamos pelo do root.
+      root->chave = temp->chave;
+
+      // Então agora passamos recursivamente para eliminar o nó (FOLHA)
+      // que está à direita do root (onde foi achado o menor) para remover
+      // o nó com a chave passada.
+      root->dir = AVL_A(no_remover)(root->dir, temp->chave, resp);
+    }
+  }
+
+  // Ajustamos a altura do root
+  root->height =
+      AVL_A(max)(AVL_A(altura_no)(root->esq), AVL_A(altura_no)(root->dir)) + 1;
+
+  // Balanceamos a partir do root
+  return AVL_A(balancear_no)(root);
+}
+
+// Função que opera em um nó (busca)
+AVL_NO *AVL_A(no_buscar)(AVL_NO *no, AVL_CHAVE chave) {
+  if (no == NULL)
+    return NULL;
+  ESTAT_VISITAR();
+  if (ESTAT_CMP(no->chave == chave)) {
+    return no;
+  }
+  if (ESTAT_CMP(chave < no->chave)) {
+    return AVL_A(no_buscar)(no->esq, chave);
+  }
+  return AVL_A(no_buscar)(no->dir, chave);
+}
+
+// Função que opera na árvore (busca)
+int AVL_F(buscar)(AVL_ARVORE *T, AVL_CHAVE chave) {
+  if (T == NULL || *T == NULL) {
+    return 0;
+  }
+
+  AVL_NO *resultado = AVL_A(no_buscar)(*T, chave);
+  if (resultado != NULL) {
+    return 1; // Retorna um ponteiro para a chave
+  }
+  return 0; // Chave não encontrada
+}
+
+// Inserção na árvore
+int AVL_F(inserir)(AVL_ARVORE *T, AVL_CHAVE chave) {
+  if (T == NULL) {
+    return -1; // Indica falha na inserção (ponteiro nulo)
+  }
+
+  int resp = 0;
+  AVL_NO *novo = AVL_A(no_inserir)(*T, chave, &resp); // Inserção no nó
+  if (novo != NULL) {
+    *T = novo; // Atualiza a raiz da árvore
+  }
+  if (resp == 1)
+    ESTAT_ALTURA((uint64_t)AVL_A(altura_no)(*T));
+
+  return resp; // 1 se inseriu, 0 se a chave já existia (ou sem memória)
+}
+
+// Remoção da árvore
+int AVL_F(remover)(AVL_ARVORE *T, AVL_CHAVE chave) {
+  if (T == NULL || *T == NULL) {
+    return 0; // Indica falha na remoção
+  }
+
+  int resp = 0;
+  // A nova raiz pode ser nula se o último nó foi removido
+  *T = AVL_A(no_remover)(*T, chave, &resp);
+
+  return resp; // 1 se removeu, 0 se a chave não foi encontrada
+}
+
+// Função auxiliar para liberar AVL
+void AVL_A(no_apagar)(AVL_NO *no) {
+  if (no != NULL) {
+    AVL_A(no_apagar)(no->esq);
+    AVL_A(no_apagar)(no->dir);
+    free(no);
+    ESTAT_LIBERAR(sizeof(AVL_NO));
+  }
+}
+
+// Função para liberar a árvore AVL
+void AVL_F(apagar)(AVL_ARVORE **T) {
+  if (T != NULL && *T != NULL) {
+    AVL_A(no_apagar)((**T));
+    free(*T);
+    *T = NULL;
+  }
+}
+
+// Empilha o nó e todo o seu caminho mais à esquerda
+void AVL_A(no_empilhar_esquerda)(ITERADOR *it, AVL_NO *no) {
+  while (no != NULL) {
+    iterador_empilhar(it, no);
+    no = no->esq;
+  }
+}
+
+// Iterador em ordem: a pilha guarda os nós cuja subárvore direita ainda
+// não foi visitada, com o próximo menor sempre no topo.
+void AVL_F(iterador)(AVL_ARVORE *T, ITERADOR *it) {
+  iterador_iniciar(it, T);
+  if (T != NULL)
+    AVL_A(no_empilhar_esquerda)(it, *T);
+}
+
+int AVL_F(iterador_proximo)(ITERADOR *it, AVL_CHAVE *valor) {
+  AVL_NO *no = (AVL_NO *)iterador_desempilhar(it);
+  if (no == NULL)
+    return 0;
+
+  *valor = no->chave;
+  AVL_A(no_empilhar_esquerda)(it, no->dir);
+  return 1;
+}
+
+int AVL_F(iterador_buscar)(ITERADOR *it, AVL_CHAVE alvo, AVL_CHAVE *valor) {
+  while (it->topo > 0) {
+    AVL_NO *topo = (AVL_NO *)iterador_topo(it);
+    if (topo->chave >= alvo)
+      return AVL_F(iterador_proximo)(it, valor);
+
+    // O topo e sua subárvore esquerda ficam para trás
+    iterador_desempilhar(it);
+
+    // Se o próximo pendente ainda é menor que o alvo, a subárvore direita
+    // do topo inteira também é menor e pode ser descartada sem descer.
+    AVL_NO *abaixo = (AVL_NO *)iterador_topo(it);
+    if (abaixo != NULL && abaixo->chave < alvo)
+      continue;
+
+    // Desce pela direita guardando apenas os nós >= alvo
+    AVL_NO *no = topo->dir;
+    while (no != NULL) {
+      if (no->chave >= alvo) {
+        iterador_empilhar(it, no);
+        no = no->esq;
+      } else {
+        no = no->dir;
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+    Construção em lote: o elemento do meio vira a raiz e as metades viram
+    as subárvores, então as alturas diferem no máximo em 1 e nenhuma rotação
+    é necessária. As duas metades são independentes, então a esquerda vira
+    uma tarefa do grupo de threads enquanto houver threads sobrando.
+*/
+AVL_NO *AVL_A(no_construir)(const AVL_CHAVE *chaves, size_t n, int threads,
+                            int *falha) {
+  if (n == 0)
+    return NULL;
+
+  size_t meio = n / 2;
+  AVL_NO *raiz = AVL_A(criar_no)(chaves[meio]);
+  if (raiz == NULL) {
+    *falha = 1;
+    return NULL;
+  }
+
+  AVL_CONSTRUCAO esq = {chaves, meio, threads / 2, 0, NULL, ESTAT_ATUAL()};
+  int paralelo = threads > 1 && n >= CONSTRUCAO_MIN_PARALELO;
+  if (paralelo) {
+    tarefa_iniciar(&esq.tarefa, AVL_A(construir_tarefa), &esq);
+    tarefa_lancar(&esq.tarefa);
+  } else {
+    raiz->esq = AVL_A(no_construir)(chaves, meio, threads / 2, falha);
+  }
+  raiz->dir = AVL_A(no_construir)(chaves + meio + 1, n - meio - 1,
+                                  threads - threads / 2, falha);
+  if (paralelo) {
+    tarefa_esperar(&esq.tarefa);
+    raiz->esq = esq.raiz;
+    if (esq.falha)
+      *falha = 1;
+  }
+
+  raiz->height =
+      AVL_A(max)(AVL_A(altura_no)(raiz->esq), AVL_A(altura_no)(raiz->dir)) + 1;
+  return raiz;
+}
+
+void AVL_A(construir_tarefa)(void *arg) {
+  AVL_CONSTRUCAO *c = (AVL_CONSTRUCAO *)arg;
+  ESTAT_USAR(c->estat);
+  c->raiz = AVL_A(no_construir)(c->chaves, c->n, c->threads, &c->falha);
+}
+
+int AVL_F(construir)(AVL_ARVORE *T, const AVL_CHAVE *chaves, size_t n,
+                     int threads) {
+  if (T == NULL)
+    return -1;
+
+  // Substitui o conteúdo anterior da árvore
+  AVL_A(no_apagar)(*T);
+  *T = NULL;
+
+  int falha = 0;
+  AVL_NO *raiz =
+      AVL_A(no_construir)(chaves, n, threads < 1 ? 1 : threads, &falha);
+  if (falha) {
+    // Subárvores que falharam ficaram nulas: o que foi criado é liberado
+    AVL_A(no_apagar)(raiz);
+    return 0;
+  }
+
+  *T = raiz;
+  return 1;
+}
+
+// A altura fica guardada na raiz
+int AVL_F(altura)(AVL_ARVORE *T) {
+  if (T == NULL)
+    return 0;
+  return AVL_A(altura_no)(*T);
+}
+
+/*
+    Junção: todas as chaves de `menores` < meio < todas de `maiores`. Desce
+    pela borda da árvore mais alta até uma subárvore com a altura da outra
+    (diferença de no máximo 1), pendura ali o nó do meio e rebalanceia só
+    esse caminho na volta. Custa O(|altura(menores) - altura(maiores)| + 1).
+*/
+AVL_NO *AVL_A(no_juntar)(AVL_NO *menores, AVL_NO *meio, AVL_NO *maiores) {
+  int he = AVL_A(altura_no)(menores), hd = AVL_A(altura_no)(maiores);
+
+  if (he > hd + 1) {
+    ESTAT_VISITAR();
+    menores->dir = AVL_A(no_juntar)(menores->dir, meio, maiores);
+    menores->height = AVL_A(max)(AVL_A(altura_no)(menores->esq),
+                                 AVL_A(altura_no)(menores->dir)) +
+                      1;
+    return AVL_A(balancear_no)(menores);
+  }
+  if (hd > he + 1) {
+    ESTAT_VISITAR();
+    maiores->esq = AVL_A(no_juntar)(menores, meio, maiores->esq);
+    maiores->height = AVL_A(max)(AVL_A(altura_no)(maiores->esq),
+                                 AVL_A(altura_no)(maiores->dir)) +
+                      1;
+    return AVL_A(balancear_no)(maiores);
+  }
+
+  meio->esq = menores;
+  meio->dir = maiores;
+  meio->height = AVL_A(max)(he, hd) + 1;
+  return meio;
+}
+
+/*
+    Divisão pela chave: desce o caminho da busca e, em cada nó, junta o nó
+    e a subárvore que ficou inteira do lado certo com o pedaço que voltou
+    da recursão. As alturas das junções ao longo do caminho se cancelam em
+    soma telescópica, então o total é O(log(n)).
+*/
+void AVL_A(no_dividir)(AVL_NO *no, AVL_CHAVE chave, AVL_NO **menores,
+                       AVL_NO **maiores) {
+  if (no == NULL) {
+    *menores = *maiores = NULL;
+    return;
+  }
+  ESTAT_VISITAR();
+
+  AVL_NO *esq = no->esq, *dir = no->dir, *parte;
+  if (ESTAT_CMP(no->chave < chave)) {
+    AVL_A(no_dividir)(dir, chave, &parte, maiores);
+    *menores = AVL_A(no_juntar)(esq, no, parte);
+  } else {
+    AVL_A(no_dividir)(esq, chave, menores, &parte);
+    *maiores = AVL_A(no_juntar)(parte, no, dir);
+  }
+}
+
+// Divide T em `menores` (< chave) e `maiores` (>= chave); T fica vazia
+int AVL_F(dividir)(AVL_ARVORE *T, AVL_CHAVE chave, AVL_ARVORE *menores,
+                   AVL_ARVORE *maiores) {
+  if (T == NULL || menores == NULL || maiores == NULL)
+    return -1;
+
+  AVL_A(no_apagar)(*menores);
+  AVL_A(no_apagar)(*maiores);
+  AVL_A(no_dividir)(*T, chave, menores, maiores);
+  *T = NULL;
+  return 1;
+}
+
+/*
+    Junta B ao fim de A (todas as chaves de A menores que as de B). O menor
+    nó de B vira o nó do meio: ele é alocado antes de qualquer mudança,
+    então uma falha de alocação deixa as duas árvores como estavam.
+*/
+int AVL_F(juntar)(AVL_ARVORE *A, AVL_ARVORE *B) {
+  if (A == NULL || B == NULL)
+    return -1;
+  if (*B == NULL)
+    return 1;
+  if (*A == NULL) {
+    *A = *B;
+    *B = NULL;
+    return 1;
+  }
+
+  AVL_NO *menor = *B;
+  while (menor->esq != NULL)
+    menor = menor->esq;
+  AVL_NO *meio = AVL_A(criar_no)(menor->chave);
+  if (meio == NULL)
+    return 0;
+
+  int resp;
+  *B = AVL_A(no_remover)(*B, meio->chave, &resp);
+  *A = AVL_A(no_juntar)(*A, meio, *B);
+  *B = NULL;
+  ESTAT_ALTURA((uint64_t)AVL_A(altura_no)(*A));
+  return 1;
+}
+
+// Menor e maior chave, descendo as bordas da árvore em O(log(n))
+int AVL_F(extremos)(AVL_ARVORE *T, AVL_CHAVE *menor, AVL_CHAVE *maior) {
+  if (T == NULL || *T == NULL)
+    return 0;
+
+  AVL_NO *no = *T;
+  while (no->esq != NULL)
+    no = no->esq;
+  *menor = no->chave;
+  for (no = *T; no->dir != NULL; no = no->dir)
+    ;
+  *maior = no->chave;
+  return 1;
+}
+
+#undef AVL_F
+#undef AVL_A
+#undef AVL_NO
+#undef AVL_CONSTRUCAO
+#undef AVL_CHAVE
+#undef AVL_SUFIXO
+#undef AVL_ARVORE
@@ -0,0 +1,429 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "comprimido.h"
+#include "../set/estatisticas.h"
+
+// Faixas intercaladas de um bloco (uma por posição de um registrador SIMD
+// de 4 inteiros de 32 bits)
+#define COMPRIMIDO_FAIXAS 4
+
+// Valores por faixa
+#define COMPRIMIDO_POR_FAIXA (COMPRIMIDO_BLOCO / COMPRIMIDO_FAIXAS)
+
+/*
+    Bloco b: chaves de b * COMPRIMIDO_BLOCO em diante. A primeira fica em
+    minimos[b]; cada uma das demais é guardada como a distância até a
+    anterior menos 1, com `largura` bits, a partir de dados[inicio[b]]. O
+    bloco ocupa COMPRIMIDO_FAIXAS * largura palavras, então a largura sai
+    da diferença entre inicio[b + 1] e inicio[b].
+*/
+typedef struct comprimido {
+  size_t n;
+  size_t blocos;
+  int *minimos;     // Menor chave de cada bloco (índice da busca)
+  size_t *inicio;   // blocos + 1 posições em `dados`
+  uint32_t *dados;  // Diferenças empacotadas
+  size_t palavras;  // Tamanho de `dados`
+} COMPRIMIDO;
+
+// Protocolo das Funções
+
+// Auxiliares
+size_t chaves_bloco_comprimido(COMPRIMIDO *C, size_t b);
+int largura_comprimido(const uint32_t *d);
+void diferencas_comprimido(const int *chaves, size_t q, uint32_t *d);
+void empacotar_comprimido(const uint32_t *d, int largura, uint32_t *saida);
+void desempacotar_comprimido(const uint32_t *dados, int largura,
+                             uint32_t *d);
+size_t decodificar_comprimido(COMPRIMIDO *C, size_t b, int *chaves);
+size_t bloco_limite_comprimido(COMPRIMIDO *C, int chave, size_t de);
+size_t posicao_bloco_comprimido(const int *chaves, size_t de, size_t q,
+                                int alvo);
+void liberar_comprimido(COMPRIMIDO *C);
+int carregar_comprimido(ITERADOR *it);
+
+// Principais
+COMPRIMIDO *comprimido_criar(void);
+int comprimido_construir(COMPRIMIDO *C, const int *chaves, size_t n,
+                         int threads);
+int comprimido_inserir(COMPRIMIDO *C, int chave);
+int comprimido_remover(COMPRIMIDO *C, int chave);
+int comprimido_consultar(COMPRIMIDO *C, int chave);
+void comprimido_apagar(COMPRIMIDO **C);
+void comprimido_iterador(COMPRIMIDO *C, ITERADOR *it);
+int comprimido_iterador_proximo(ITERADOR *it, int *valor);
+size_t comprimido_iterador_lote(ITERADOR *it, int *destino,
+                                size_t capacidade);
+int comprimido_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+int comprimido_altura(COMPRIMIDO *C);
+size_t comprimido_blocos(COMPRIMIDO *C);
+size_t comprimido_bytes(COMPRIMIDO *C);
+size_t comprimido_bytes_bloco(const int *chaves, size_t q);
+
+// Quantidade de chaves do bloco b (só o último pode ter menos)
+size_t chaves_bloco_comprimido(COMPRIMIDO *C, size_t b) {
+  size_t resto = C->n - b * COMPRIMIDO_BLOCO;
+  return resto < COMPRIMIDO_BLOCO ? resto : COMPRIMIDO_BLOCO;
+}
+
+// Bits necessários para o maior valor do bloco (0 se todos forem 0)
+int largura_comprimido(const uint32_t *d) {
+  uint32_t ou = 0;
+  for (size_t i = 0; i < COMPRIMIDO_BLOCO; i++)
+    ou |= d[i];
+  return ou ? 32 - __builtin_clz(ou) : 0;
+}
+
+// Diferenças menos 1 entre chaves vizinhas; d[0] e as posições vagas são 0
+void diferencas_comprimido(const int *chaves, size_t q, uint32_t *d) {
+  d[0] = 0;
+  for (size_t i = 1; i < q; i++)
+    d[i] = (uint32_t)chaves[i] - (uint32_t)chaves[i - 1] - 1;
+  for (size_t i = q; i < COMPRIMIDO_BLOCO; i++)
+    d[i] = 0;
+}
+
+/*
+    Empacotamento vertical: o valor i vai para a faixa i % 4, e cada faixa
+    empilha os seus 32 valores em `largura` palavras próprias, intercaladas
+    com as das outras faixas (palavra j da faixa f em saida[4 * j + f]).
+    Assim as 4 faixas fazem sempre os mesmos deslocamentos ao mesmo tempo,
+    e os laços internos de 4 iterações viram uma instrução SIMD cada.
+*/
+void empacotar_comprimido(const uint32_t *d, int largura, uint32_t *saida) {
+  memset(saida, 0, (size_t)(COMPRIMIDO_FAIXAS * largura) * sizeof(uint32_t));
+  if (largura == 0)
+    return;
+  for (int s = 0; s < COMPRIMIDO_POR_FAIXA; s++) {
+    int bit = s * largura, j = bit >> 5, desloc = bit & 31;
+    uint32_t *p = saida + COMPRIMIDO_FAIXAS * j;
+    const uint32_t *v = d + COMPRIMIDO_FAIXAS * s;
+    for (int f = 0; f < COMPRIMIDO_FAIXAS; f++)
+      p[f] |= v[f] << desloc;
+    if (desloc + largura > 32)
+      for (int f = 0; f < COMPRIMIDO_FAIXAS; f++)
+        p[COMPRIMIDO_FAIXAS + f] |= v[f] >> (32 - desloc);
+  }
+}
+
+void desempacotar_comprimido(const uint32_t *dados, int largura,
+                             uint32_t *d) {
+  if (largura == 0) {
+    memset(d, 0, COMPRIMIDO_BLOCO * sizeof(uint32_t));
+    return;
+  }
+  uint32_t mascara = largura == 32 ? 0xFFFFFFFFu : (1u << largura) - 1;
+  for (int s = 0; s < COMPRIMIDO_POR_FAIXA; s++) {
+    int bit = s * largura, j = bit >> 5, desloc = bit & 31;
+    const uint32_t *p = dados + COMPRIMIDO_FAIXAS * j;
+    uint32_t *v = d + COMPRIMIDO_FAIXAS * s;
+    for (int f = 0; f < COMPRIMIDO_FAIXAS; f++)
+      v[f] = p[f] >> desloc;
+    if (desloc + largura > 32)
+      for (int f = 0; f < COMPRIMIDO_FAIXAS; f++)
+        v[f] |= p[COMPRIMIDO_FAIXAS + f] << (32 - desloc);
+    for (int f = 0; f < COMPRIMIDO_FAIXAS; f++)
+      v[f] &= mascara;
+  }
+}
+
+// Decodifica o bloco b em `chaves` (devolve quantas chaves ele tem)
+size_t decodificar_comprimido(COMPRIMIDO *C, size_t b, int *chaves) {
+  uint32_t d[COMPRIMIDO_BLOCO];
+  size_t q = chaves_bloco_comprimido(C, b);
+  int largura = (int)((C->inicio[b + 1] - C->inicio[b]) / COMPRIMIDO_FAIXAS);
+  ESTAT_VISITAR();
+  desempacotar_comprimido(C->dados + C->inicio[b], largura, d);
+
+  // Soma prefixa em uint32_t: as chaves negativas dão a volta sem estouro
+  uint32_t u = (uint32_t)C->minimos[b];
+  chaves[0] = C->minimos[b];
+  for (size_t i = 1; i < q; i++) {
+    u += d[i] + 1;
+    chaves[i] = (int)u;
+  }
+  return q;
+}
+
+// Primeiro bloco a partir de `de` cuja menor chave passa de `chave`
+size_t bloco_limite_comprimido(COMPRIMIDO *C, int chave, size_t de) {
+  size_t ini = de, fim = C->blocos;
+  while (ini < fim) {
+    size_t meio = ini + (fim - ini) / 2;
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(C->minimos[meio] <= chave))
+      ini = meio + 1;
+    else
+      fim = meio;
+  }
+  return ini;
+}
+
+// Primeira posição em [de, q) com chave >= alvo (q se não houver)
+size_t posicao_bloco_comprimido(const int *chaves, size_t de, size_t q,
+                                int alvo) {
+  while (de < q) {
+    size_t meio = de + (q - de) / 2;
+    if (ESTAT_CMP(chaves[meio] < alvo))
+      de = meio + 1;
+    else
+      q = meio;
+  }
+  return de;
+}
+
+COMPRIMIDO *comprimido_criar(void) {
+  COMPRIMIDO *C = (COMPRIMIDO *)calloc(1, sizeof(COMPRIMIDO));
+  return C;
+}
+
+void liberar_comprimido(COMPRIMIDO *C) {
+  if (C->blocos > 0)
+    ESTAT_LIBERAR(comprimido_bytes(C) - sizeof(COMPRIMIDO));
+  free(C->minimos);
+  free(C->inicio);
+  free(C->dados);
+  C->minimos = NULL;
+  C->inicio = NULL;
+  C->dados = NULL;
+  C->n = C->blocos = C->palavras = 0;
+}
+
+/*
+    Duas passadas: a primeira só mede a largura de cada bloco (e com isso
+    o tamanho exato de `dados`), a segunda empacota. Nada é realocado.
+*/
+int comprimido_construir(COMPRIMIDO *C, const int *chaves, size_t n,
+                         int threads) {
+  (void)threads;
+  if (C == NULL)
+    return -1;
+
+  liberar_comprimido(C);
+  if (n == 0)
+    return 1;
+
+  size_t blocos = (n + COMPRIMIDO_BLOCO - 1) / COMPRIMIDO_BLOCO;
+  int *minimos = (int *)malloc(blocos * sizeof(int));
+  size_t *inicio = (size_t *)malloc((blocos + 1) * sizeof(size_t));
+  if (minimos == NULL || inicio == NULL) {
+    free(minimos);
+    free(inicio);
+    return 0;
+  }
+
+  uint32_t d[COMPRIMIDO_BLOCO];
+  inicio[0] = 0;
+  for (size_t b = 0; b < blocos; b++) {
+    const int *bloco = chaves + b * COMPRIMIDO_BLOCO;
+    size_t q = n - b * COMPRIMIDO_BLOCO;
+    if (q > COMPRIMIDO_BLOCO)
+      q = COMPRIMIDO_BLOCO;
+    diferencas_comprimido(bloco, q, d);
+    minimos[b] = bloco[0];
+    inicio[b + 1] =
+        inicio[b] + (size_t)(COMPRIMIDO_FAIXAS * largura_comprimido(d));
+  }
+
+  size_t palavras = inicio[blocos];
+  uint32_t *dados = (uint32_t *)malloc((palavras + 1) * sizeof(uint32_t));
+  if (dados == NULL) {
+    free(minimos);
+    free(inicio);
+    return 0;
+  }
+  for (size_t b = 0; b < blocos; b++) {
+    const int *bloco = chaves + b * COMPRIMIDO_BLOCO;
+    size_t q = n - b * COMPRIMIDO_BLOCO;
+    if (q > COMPRIMIDO_BLOCO)
+      q = COMPRIMIDO_BLOCO;
+    diferencas_comprimido(bloco, q, d);
+    empacotar_comprimido(
+        d, (int)((inicio[b + 1] - inicio[b]) / COMPRIMIDO_FAIXAS),
+        dados + inicio[b]);
+  }
+
+  C->n = n;
+  C->blocos = blocos;
+  C->minimos = minimos;
+  C->inicio = inicio;
+  C->dados = dados;
+  C->palavras = palavras;
+  ESTAT_ALOCAR(comprimido_bytes(C) - sizeof(COMPRIMIDO));
+  return 1;
+}
+
+// Estrutura imutável: alterações são recusadas
+int comprimido_inserir(COMPRIMIDO *C, int chave) {
+  (void)C;
+  (void)chave;
+  return -1;
+}
+
+int comprimido_remover(COMPRIMIDO *C, int chave) {
+  (void)C;
+  (void)chave;
+  return -1;
+}
+
+int comprimido_consultar(COMPRIMIDO *C, int chave) {
+  if (C == NULL || C->n == 0)
+    return 0;
+  size_t b = bloco_limite_comprimido(C, chave, 0);
+  if (b-- == 0)
+    return 0; // Menor que a menor chave
+
+  // Desempacota o bloco e soma as diferenças só até alcançar a chave
+  uint32_t d[COMPRIMIDO_BLOCO];
+  size_t q = chaves_bloco_comprimido(C, b);
+  int largura = (int)((C->inicio[b + 1] - C->inicio[b]) / COMPRIMIDO_FAIXAS);
+  ESTAT_VISITAR();
+  desempacotar_comprimido(C->dados + C->inicio[b], largura, d);
+  uint32_t u = (uint32_t)C->minimos[b];
+  for (size_t i = 1; i < q && ESTAT_CMP((int)u < chave); i++)
+    u += d[i] + 1;
+  return (int)u == chave;
+}
+
+void comprimido_apagar(COMPRIMIDO **C) {
+  if (C == NULL || *C == NULL)
+    return;
+  liberar_comprimido(*C);
+  free(*C);
+  *C = NULL;
+}
+
+/*
+    Iterador: `posicao` é o índice da próxima chave e `chaves` guarda o
+    bloco dela já decodificado quando `atual` não é NULL. Ao cruzar o fim
+    de um bloco `atual` volta a NULL e o bloco seguinte só é decodificado
+    quando for lido (um salto pode pulá-lo inteiro).
+*/
+void comprimido_iterador(COMPRIMIDO *C, ITERADOR *it) {
+  iterador_iniciar(it, C);
+}
+
+// Garante o bloco da próxima chave decodificado (0 ao final)
+int carregar_comprimido(ITERADOR *it) {
+  COMPRIMIDO *C = (COMPRIMIDO *)it->estrutura;
+  if (C == NULL || (size_t)it->posicao >= C->n)
+    return 0;
+  if (it->atual == NULL) {
+    decodificar_comprimido(C, (size_t)it->posicao / COMPRIMIDO_BLOCO,
+                           it->chaves);
+    it->atual = it->chaves;
+  }
+  return 1;
+}
+
+int comprimido_iterador_proximo(ITERADOR *it, int *valor) {
+  if (!carregar_comprimido(it))
+    return 0;
+  *valor = it->chaves[it->posicao % COMPRIMIDO_BLOCO];
+  if (++it->posicao % COMPRIMIDO_BLOCO == 0)
+    it->atual = NULL;
+  return 1;
+}
+
+size_t comprimido_iterador_lote(ITERADOR *it, int *destino,
+                                size_t capacidade) {
+  COMPRIMIDO *C = (COMPRIMIDO *)it->estrutura;
+  size_t n = 0;
+  while (n < capacidade && C != NULL && (size_t)it->posicao < C->n) {
+    size_t b = (size_t)it->posicao / COMPRIMIDO_BLOCO;
+    size_t q = chaves_bloco_comprimido(C, b);
+    if (it->atual == NULL && capacidade - n >= q) {
+      // Bloco inteiro: decodifica direto no destino
+      decodificar_comprimido(C, b, destino + n);
+      n += q;
+      it->posicao += (int64_t)q;
+      continue;
+    }
+    carregar_comprimido(it);
+    size_t de = (size_t)it->posicao % COMPRIMIDO_BLOCO;
+    size_t copiar = q - de < capacidade - n ? q - de : capacidade - n;
+    memcpy(destino + n, it->chaves + de, copiar * sizeof(int));
+    n += copiar;
+    it->posicao += (int64_t)copiar;
+    if (de + copiar == q)
+      it->atual = NULL;
+  }
+  return n;
+}
+
+int comprimido_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  COMPRIMIDO *C = (COMPRIMIDO *)it->estrutura;
+  if (C == NULL || (size_t)it->posicao >= C->n)
+    return 0;
+
+  size_t b = (size_t)it->posicao / COMPRIMIDO_BLOCO;
+  size_t de = (size_t)it->posicao % COMPRIMIDO_BLOCO;
+  size_t q = chaves_bloco_comprimido(C, b);
+
+  // O bloco corrente já decodificado ainda alcança o alvo
+  if (it->atual != NULL && it->chaves[q - 1] >= alvo) {
+    it->posicao += (int64_t)(posicao_bloco_comprimido(it->chaves, de, q,
+                                                      alvo) - de);
+    return comprimido_iterador_proximo(it, valor);
+  }
+
+  // Último bloco (a partir do corrente) que começa em alvo ou antes; se
+  // nenhum começa, a próxima chave já serve
+  size_t c = bloco_limite_comprimido(C, alvo, b);
+  if (c == b)
+    return comprimido_iterador_proximo(it, valor);
+  c--;
+  if (c == b && it->atual != NULL) {
+    // O bloco corrente acaba antes do alvo: o seguinte começa depois dele
+    it->posicao = (int64_t)((b + 1) * COMPRIMIDO_BLOCO);
+    it->atual = NULL;
+    return comprimido_iterador_proximo(it, valor);
+  }
+
+  if (c != b)
+    de = 0;
+  it->posicao = (int64_t)(c * COMPRIMIDO_BLOCO);
+  it->atual = NULL;
+  carregar_comprimido(it);
+  q = chaves_bloco_comprimido(C, c);
+  size_t i = posicao_bloco_comprimido(it->chaves, de, q, alvo);
+  it->posicao += (int64_t)i;
+  if (i == q)
+    it->atual = NULL; // Nada no bloco: a resposta é o início do seguinte
+  return comprimido_iterador_proximo(it, valor);
+}
+
+// Passos da busca binária no índice, mais um para o bloco
+int comprimido_altura(COMPRIMIDO *C) {
+  if (C == NULL || C->n == 0)
+    return 0;
+  int h = 1;
+  for (size_t b = C->blocos; b > 0; b >>= 1)
+    h++;
+  return h;
+}
+
+size_t comprimido_blocos(COMPRIMIDO *C) { return C ? C->blocos : 0; }
+
+size_t comprimido_bytes(COMPRIMIDO *C) {
+  if (C == NULL)
+    return 0;
+  size_t bytes = sizeof(COMPRIMIDO);
+  if (C->blocos > 0)
+    bytes += C->blocos * sizeof(int) + (C->blocos + 1) * sizeof(size_t) +
+             (C->palavras + 1) * sizeof(uint32_t);
+  return bytes;
+}
+
+size_t comprimido_bytes_bloco(const int *chaves, size_t q) {
+  uint32_t d[COMPRIMIDO_BLOCO];
+  if (q == 0)
+    return 0;
+  diferencas_comprimido(chaves, q, d);
+  return sizeof(int) + sizeof(size_t) +
+         (size_t)(COMPRIMIDO_FAIXAS * largura_comprimido(d)) *
+             sizeof(uint32_t);
+}
@@ -0,0 +1,166 @@
+#ifndef COMPRIMIDO_H
+#define COMPRIMIDO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../set/iterador.h"
+
+// Chaves por bloco comprimido
+#define COMPRIMIDO_BLOCO ITERADOR_CHAVES
+
+/*
+    Vetor imutável de chaves comprimidas: as chaves ordenadas são divididas
+    em blocos de COMPRIMIDO_BLOCO, e cada bloco guarda as diferenças entre
+    chaves vizinhas empacotadas com o menor número de bits que cabe a maior
+    delas. Um índice com a menor chave de cada bloco leva a busca direto ao
+    único bloco que precisa ser decodificado.
+*/
+typedef struct comprimido COMPRIMIDO;
+
+/**
+ * @brief Cria uma estrutura comprimida vazia.
+ *
+ * A estrutura é somente leitura: o conteúdo vem de comprimido_construir() e
+ * pode ser consultado por várias threads ao mesmo tempo, sem travas.
+ *
+ * @return COMPRIMIDO* Ponteiro para a estrutura, ou NULL em caso de erro na
+ * alocação.
+ */
+COMPRIMIDO *comprimido_criar(void);
+
+/**
+ * @brief Comprime chaves ordenadas e sem repetição.
+ *
+ * Substitui o conteúdo anterior.
+ *
+ * @param C Ponteiro para a estrutura.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @param threads Ignorado: a compressão é uma passada linear.
+ * @return int Retorna 1 se a construção foi bem-sucedida, 0 em caso de falha
+ * de alocação (a estrutura fica vazia), ou -1 se a estrutura for inválida.
+ */
+int comprimido_construir(COMPRIMIDO *C, const int *chaves, size_t n,
+                         int threads);
+
+/**
+ * @brief Recusa a inserção (a estrutura é imutável).
+ *
+ * @param C Ponteiro para a estrutura.
+ * @param chave Chave a ser inserida.
+ * @return int Sempre -1.
+ */
+int comprimido_inserir(COMPRIMIDO *C, int chave);
+
+/**
+ * @brief Recusa a remoção (a estrutura é imutável).
+ *
+ * @param C Ponteiro para a estrutura.
+ * @param chave Chave a ser removida.
+ * @return int Sempre -1.
+ */
+int comprimido_remover(COMPRIMIDO *C, int chave);
+
+/**
+ * @brief Verifica a existência de uma chave.
+ *
+ * Busca binária no índice de blocos e decodificação de um único bloco.
+ *
+ * @param C Ponteiro para a estrutura.
+ * @param chave Chave a ser consultada.
+ * @return int Retorna 1 se a chave estiver presente, ou 0 caso contrário.
+ */
+int comprimido_consultar(COMPRIMIDO *C, int chave);
+
+/**
+ * @brief Apaga a estrutura, liberando toda a memória alocada.
+ *
+ * @param C Endereço do ponteiro para a estrutura. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void comprimido_apagar(COMPRIMIDO **C);
+
+/**
+ * @brief Prepara um iterador em ordem crescente.
+ *
+ * O iterador decodifica um bloco por vez dentro de si mesmo, sem alocar.
+ *
+ * @param C Ponteiro para a estrutura.
+ * @param it Iterador a ser preparado.
+ */
+void comprimido_iterador(COMPRIMIDO *C, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por comprimido_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 ao final do percurso.
+ */
+int comprimido_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Copia as próximas chaves do percurso, em ordem, para um vetor.
+ *
+ * Blocos inteiros são decodificados direto no destino.
+ *
+ * @param it Iterador preparado por comprimido_iterador().
+ * @param destino Vetor que recebe as chaves.
+ * @param capacidade Quantidade máxima de chaves copiadas.
+ * @return size_t Quantidade de chaves copiadas (menor que `capacidade` só
+ * ao final do percurso).
+ */
+size_t comprimido_iterador_lote(ITERADOR *it, int *destino,
+                                size_t capacidade);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * Blocos inteiros são saltados pelo índice, sem decodificar.
+ *
+ * @param it Iterador preparado por comprimido_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 se não houver chave
+ * maior ou igual a `alvo`.
+ */
+int comprimido_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Profundidade da busca: passos no índice de blocos mais o bloco.
+ *
+ * @param C Ponteiro para a estrutura.
+ * @return int Profundidade (0 se vazia).
+ */
+int comprimido_altura(COMPRIMIDO *C);
+
+/**
+ * @brief Quantidade de blocos.
+ *
+ * @param C Ponteiro para a estrutura.
+ * @return size_t Quantidade de blocos (0 se vazia ou inválida).
+ */
+size_t comprimido_blocos(COMPRIMIDO *C);
+
+/**
+ * @brief Memória ocupada pela estrutura: dados, índice e cabeçalho.
+ *
+ * @param C Ponteiro para a estrutura.
+ * @return size_t Quantidade de bytes.
+ */
+size_t comprimido_bytes(COMPRIMIDO *C);
+
+/**
+ * @brief Bytes que um bloco com estas chaves ocuparia, sem comprimi-lo.
+ *
+ * Permite estimar a compressão de um conjunto antes de convertê-lo.
+ *
+ * @param chaves Até COMPRIMIDO_BLOCO chaves em ordem estritamente crescente.
+ * @param q Quantidade de chaves.
+ * @return size_t Quantidade de bytes (dados e entrada no índice).
+ */
+size_t comprimido_bytes_bloco(const int *chaves, size_t q);
+
+#endif // COMPRIMIDO_H
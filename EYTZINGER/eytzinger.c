@@ -0,0 +1,225 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "eytzinger.h"
+#include "../set/estatisticas.h"
+
+// Tamanho da linha de cache, em bytes
+#define EYTZINGER_LINHA 64
+
+// Chaves por linha de cache. A partir do nó k, os descendentes 4 níveis
+// abaixo (16k .. 16k + 15) ocupam uma única linha, então basta um prefetch
+// por nível para manter 4 níveis em voo.
+#define EYTZINGER_BLOCO (EYTZINGER_LINHA / (int)sizeof(int))
+
+typedef struct eytzinger {
+  int *chaves; // chaves[1..n]; filhos de k em 2k e 2k + 1 (chaves[0] sem uso)
+  size_t n;
+} EYTZINGER;
+
+// Protocolo das Funções
+
+// Auxiliares
+size_t primeiro_eytzinger(size_t n);
+size_t proximo_eytzinger(size_t k, size_t n);
+size_t limite_inferior_eytzinger(EYTZINGER *E, int chave);
+
+// Principais
+EYTZINGER *eytzinger_criar(void);
+int eytzinger_construir(EYTZINGER *E, const int *chaves, size_t n);
+int eytzinger_inserir(EYTZINGER *E, int chave);
+int eytzinger_remover(EYTZINGER *E, int chave);
+int eytzinger_consultar(EYTZINGER *E, int chave);
+void eytzinger_apagar(EYTZINGER **E);
+void eytzinger_iterador(EYTZINGER *E, ITERADOR *it);
+int eytzinger_iterador_proximo(ITERADOR *it, int *valor);
+size_t eytzinger_iterador_lote(ITERADOR *it, int *destino, size_t capacidade);
+int eytzinger_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+int eytzinger_altura(EYTZINGER *E);
+
+// Índice da menor chave: o nó mais à esquerda (0 se vazio)
+size_t primeiro_eytzinger(size_t n) {
+  if (n == 0)
+    return 0;
+  size_t k = 1;
+  while (2 * k <= n)
+    k = 2 * k;
+  return k;
+}
+
+// Sucessor em ordem do nó k (0 ao final)
+size_t proximo_eytzinger(size_t k, size_t n) {
+  if (2 * k + 1 <= n) {
+    // Desce uma vez à direita e depois tudo à esquerda
+    k = 2 * k + 1;
+    while (2 * k <= n)
+      k = 2 * k;
+    return k;
+  }
+  // Sobe enquanto for filho direito; o pai do primeiro filho esquerdo é o
+  // sucessor (a raiz, índice 1, é tratada como filho direito de 0)
+  while (k & 1)
+    k >>= 1;
+  return k >> 1;
+}
+
+/*
+    Índice da primeira chave >= `chave` (0 se não houver). A descida não tem
+    desvios: cada nível só calcula 2k ou 2k + 1. Ao sair do vetor, os bits
+    de k registram o caminho; o último passo à esquerda (último bit 0) é o
+    nó procurado, e os passos à direita depois dele são descartados.
+*/
+size_t limite_inferior_eytzinger(EYTZINGER *E, int chave) {
+  const int *b = E->chaves;
+  size_t n = E->n;
+  size_t k = 1;
+
+  while (k <= n) {
+    __builtin_prefetch(b + k * EYTZINGER_BLOCO);
+    ESTAT_VISITAR();
+    k = 2 * k + (size_t)ESTAT_CMP(b[k] < chave);
+  }
+  k >>= __builtin_ffsll((long long)~k);
+  return k;
+}
+
+// Função para criar a estrutura vazia
+EYTZINGER *eytzinger_criar(void) {
+  EYTZINGER *E = (EYTZINGER *)malloc(sizeof(EYTZINGER));
+  if (E == NULL)
+    return NULL;
+  E->chaves = NULL;
+  E->n = 0;
+  return E;
+}
+
+/*
+    As chaves ordenadas são distribuídas percorrendo a árvore implícita em
+    ordem: a i-ésima chave vai para o i-ésimo nó visitado.
+*/
+int eytzinger_construir(EYTZINGER *E, const int *chaves, size_t n) {
+  if (E == NULL)
+    return -1;
+
+  if (E->chaves != NULL) {
+    ESTAT_LIBERAR((E->n + 1) * sizeof(int));
+    free(E->chaves);
+  }
+  E->chaves = NULL;
+  E->n = 0;
+  if (n == 0)
+    return 1;
+
+  // aligned_alloc exige tamanho múltiplo do alinhamento
+  size_t bytes = (n + 1) * sizeof(int);
+  bytes = (bytes + EYTZINGER_LINHA - 1) / EYTZINGER_LINHA * EYTZINGER_LINHA;
+  int *b = (int *)aligned_alloc(EYTZINGER_LINHA, bytes);
+  if (b == NULL)
+    return 0;
+  ESTAT_ALOCAR((n + 1) * sizeof(int));
+
+  size_t k = primeiro_eytzinger(n);
+  for (size_t i = 0; i < n; i++) {
+    b[k] = chaves[i];
+    k = proximo_eytzinger(k, n);
+  }
+
+  E->chaves = b;
+  E->n = n;
+  return 1;
+}
+
+// Estrutura congelada: alterações são recusadas
+int eytzinger_inserir(EYTZINGER *E, int chave) {
+  (void)E;
+  (void)chave;
+  return -1;
+}
+
+int eytzinger_remover(EYTZINGER *E, int chave) {
+  (void)E;
+  (void)chave;
+  return -1;
+}
+
+int eytzinger_consultar(EYTZINGER *E, int chave) {
+  if (E == NULL || E->n == 0)
+    return 0;
+  size_t k = limite_inferior_eytzinger(E, chave);
+  return k != 0 && E->chaves[k] == chave;
+}
+
+// Função para liberar a estrutura
+void eytzinger_apagar(EYTZINGER **E) {
+  if (E == NULL || *E == NULL)
+    return;
+  if ((*E)->chaves != NULL) {
+    ESTAT_LIBERAR(((*E)->n + 1) * sizeof(int));
+    free((*E)->chaves);
+  }
+  free(*E);
+  *E = NULL;
+}
+
+// Iterador: `atual` aponta a próxima chave a ser entregue (NULL ao final)
+void eytzinger_iterador(EYTZINGER *E, ITERADOR *it) {
+  iterador_iniciar(it, E);
+  if (E != NULL && E->n > 0)
+    it->atual = &E->chaves[primeiro_eytzinger(E->n)];
+}
+
+int eytzinger_iterador_proximo(ITERADOR *it, int *valor) {
+  EYTZINGER *E = (EYTZINGER *)it->estrutura;
+  int *atual = (int *)it->atual;
+  if (atual == NULL)
+    return 0;
+
+  *valor = *atual;
+  size_t k = proximo_eytzinger((size_t)(atual - E->chaves), E->n);
+  it->atual = k ? &E->chaves[k] : NULL;
+  return 1;
+}
+
+size_t eytzinger_iterador_lote(ITERADOR *it, int *destino, size_t capacidade) {
+  EYTZINGER *E = (EYTZINGER *)it->estrutura;
+  int *atual = (int *)it->atual;
+  if (atual == NULL)
+    return 0;
+
+  size_t k = (size_t)(atual - E->chaves), n = 0;
+  while (k != 0 && n < capacidade) {
+    destino[n++] = E->chaves[k];
+    k = proximo_eytzinger(k, E->n);
+  }
+  it->atual = k ? &E->chaves[k] : NULL;
+  return n;
+}
+
+int eytzinger_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  EYTZINGER *E = (EYTZINGER *)it->estrutura;
+  int *atual = (int *)it->atual;
+  if (atual == NULL)
+    return 0;
+
+  // A próxima chave já serve; senão a primeira >= alvo está mais adiante
+  if (*atual < alvo) {
+    size_t k = limite_inferior_eytzinger(E, alvo);
+    if (k == 0) {
+      it->atual = NULL;
+      return 0;
+    }
+    it->atual = &E->chaves[k];
+  }
+  return eytzinger_iterador_proximo(it, valor);
+}
+
+// Árvore completa: altura = floor(log2(n)) + 1
+int eytzinger_altura(EYTZINGER *E) {
+  if (E == NULL)
+    return 0;
+  int h = 0;
+  for (size_t n = E->n; n > 0; n >>= 1)
+    h++;
+  return h;
+}
@@ -0,0 +1,128 @@
+#ifndef EYTZINGER_H
+#define EYTZINGER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../set/iterador.h"
+
+// Vetor imutável de chaves na ordem de Eytzinger (árvore implícita).
+typedef struct eytzinger EYTZINGER;
+
+/**
+ * @brief Cria uma estrutura congelada vazia.
+ *
+ * A estrutura é somente leitura: o conteúdo vem de eytzinger_construir() e
+ * pode ser consultado por várias threads ao mesmo tempo, sem travas.
+ *
+ * @return EYTZINGER* Ponteiro para a estrutura, ou NULL em caso de erro na
+ * alocação.
+ */
+EYTZINGER *eytzinger_criar(void);
+
+/**
+ * @brief Monta o vetor a partir de chaves ordenadas e sem repetição.
+ *
+ * As chaves são dispostas na ordem de uma árvore binária completa percorrida
+ * em largura (filhos de k em 2k e 2k + 1), em um vetor alinhado à linha de
+ * cache. Substitui o conteúdo anterior.
+ *
+ * @param E Ponteiro para a estrutura.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @return int Retorna 1 se a construção foi bem-sucedida, 0 em caso de falha
+ * de alocação (a estrutura fica vazia), ou -1 se a estrutura for inválida.
+ */
+int eytzinger_construir(EYTZINGER *E, const int *chaves, size_t n);
+
+/**
+ * @brief Recusa a inserção (a estrutura é imutável).
+ *
+ * @param E Ponteiro para a estrutura.
+ * @param chave Chave a ser inserida.
+ * @return int Sempre -1.
+ */
+int eytzinger_inserir(EYTZINGER *E, int chave);
+
+/**
+ * @brief Recusa a remoção (a estrutura é imutável).
+ *
+ * @param E Ponteiro para a estrutura.
+ * @param chave Chave a ser removida.
+ * @return int Sempre -1.
+ */
+int eytzinger_remover(EYTZINGER *E, int chave);
+
+/**
+ * @brief Verifica a existência de uma chave.
+ *
+ * Busca sem desvios dependentes da chave: cada nível só decide o índice do
+ * próximo, e os nós de alguns níveis abaixo são pré-carregados na cache.
+ *
+ * @param E Ponteiro para a estrutura.
+ * @param chave Chave a ser consultada.
+ * @return int Retorna 1 se a chave estiver presente, ou 0 caso contrário.
+ */
+int eytzinger_consultar(EYTZINGER *E, int chave);
+
+/**
+ * @brief Apaga a estrutura, liberando toda a memória alocada.
+ *
+ * @param E Endereço do ponteiro para a estrutura. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void eytzinger_apagar(EYTZINGER **E);
+
+/**
+ * @brief Prepara um iterador em ordem crescente.
+ *
+ * @param E Ponteiro para a estrutura.
+ * @param it Iterador a ser preparado.
+ */
+void eytzinger_iterador(EYTZINGER *E, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por eytzinger_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 ao final do percurso.
+ */
+int eytzinger_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Copia as próximas chaves do percurso, em ordem, para um vetor.
+ *
+ * Equivale a chamar eytzinger_iterador_proximo() até `capacidade` vezes,
+ * sem uma chamada por chave.
+ *
+ * @param it Iterador preparado por eytzinger_iterador().
+ * @param destino Vetor que recebe as chaves.
+ * @param capacidade Quantidade máxima de chaves copiadas.
+ * @return size_t Quantidade de chaves copiadas (menor que `capacidade` só
+ * ao final do percurso).
+ */
+size_t eytzinger_iterador_lote(ITERADOR *it, int *destino, size_t capacidade);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * Usa a mesma busca de eytzinger_consultar(), em O(log(n)).
+ *
+ * @param it Iterador preparado por eytzinger_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 se não houver chave
+ * maior ou igual a `alvo`.
+ */
+int eytzinger_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Retorna a altura da árvore implícita, em O(1).
+ *
+ * @param E Ponteiro para a estrutura.
+ * @return int Altura (0 se vazia).
+ */
+int eytzinger_altura(EYTZINGER *E);
+
+#endif // EYTZINGER_H
@@ -0,0 +1,632 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "intervalos.h"
+#include "../set/estatisticas.h"
+
+// Nó: uma faixa [ini, fim] de chaves consecutivas
+typedef struct faixa {
+  struct faixa *esq;
+  struct faixa *dir;
+  int ini;
+  int fim;
+  int altura;
+} FAIXA;
+
+// Protocolo das Funções
+
+// Auxiliares
+int altura_faixa(FAIXA *no);
+void atualizar_altura_faixa(FAIXA *no);
+FAIXA *criar_faixa(int ini, int fim);
+FAIXA *rotacionar_direita_faixa(FAIXA *no);
+FAIXA *rotacionar_esquerda_faixa(FAIXA *no);
+FAIXA *balancear_faixa(FAIXA *no);
+
+FAIXA *no_inserir_intervalos(FAIXA *raiz, FAIXA *novo);
+FAIXA *no_retirar_minimo_intervalos(FAIXA *raiz, FAIXA **minimo);
+FAIXA *no_remover_intervalos(FAIXA *raiz, int ini);
+void vizinhas_intervalos(FAIXA *raiz, int chave, FAIXA **antes,
+                         FAIXA **depois);
+void no_apagar_intervalos(FAIXA *no);
+
+void empilhar_esquerda_intervalos(ITERADOR *it, FAIXA *no);
+int avancar_intervalos(ITERADOR *it);
+
+FAIXA *no_construir_intervalos(const int *ini, const int *fim, size_t r,
+                               int *falha);
+size_t no_copiar_intervalos(FAIXA *no, int *ini, int *fim, size_t capacidade,
+                            size_t k);
+size_t no_faixas_intervalos(FAIXA *no);
+size_t no_tamanho_intervalos(FAIXA *no);
+
+FAIXA *no_juntar_intervalos(FAIXA *menores, FAIXA *meio, FAIXA *maiores);
+void no_dividir_intervalos(FAIXA *no, int chave, FAIXA **menores,
+                           FAIXA **maiores);
+
+// Principais
+INTERVALOS *intervalos_criar(void);
+int intervalos_inserir(INTERVALOS *T, int chave);
+int intervalos_remover(INTERVALOS *T, int chave);
+int intervalos_consultar(INTERVALOS *T, int chave);
+void intervalos_apagar(INTERVALOS **T);
+void intervalos_iterador(INTERVALOS *T, ITERADOR *it);
+int intervalos_iterador_proximo(ITERADOR *it, int *valor);
+size_t intervalos_iterador_lote(ITERADOR *it, int *destino,
+                                size_t capacidade);
+int intervalos_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+int intervalos_construir(INTERVALOS *T, const int *chaves, size_t n,
+                         int threads);
+int intervalos_construir_faixas(INTERVALOS *T, const int *ini, const int *fim,
+                                size_t r);
+size_t intervalos_faixas(INTERVALOS *T);
+size_t intervalos_copiar(INTERVALOS *T, int *ini, int *fim,
+                         size_t capacidade);
+size_t intervalos_tamanho(INTERVALOS *T);
+int intervalos_altura(INTERVALOS *T);
+int intervalos_dividir(INTERVALOS *T, int chave, INTERVALOS *menores,
+                       INTERVALOS *maiores);
+int intervalos_juntar(INTERVALOS *A, INTERVALOS *B);
+int intervalos_extremos(INTERVALOS *T, int *menor, int *maior);
+
+int altura_faixa(FAIXA *no) { return no ? no->altura : 0; }
+
+void atualizar_altura_faixa(FAIXA *no) {
+  int he = altura_faixa(no->esq), hd = altura_faixa(no->dir);
+  no->altura = (he > hd ? he : hd) + 1;
+}
+
+FAIXA *criar_faixa(int ini, int fim) {
+  FAIXA *no = (FAIXA *)malloc(sizeof(FAIXA));
+  if (no == NULL)
+    return NULL;
+  ESTAT_ALOCAR(sizeof(FAIXA));
+  no->esq = no->dir = NULL;
+  no->ini = ini;
+  no->fim = fim;
+  no->altura = 1;
+  return no;
+}
+
+// Rotações e balanceamento como na AVL (ver AVL/bst_avl.c)
+FAIXA *rotacionar_direita_faixa(FAIXA *no) {
+  FAIXA *nova = no->esq;
+  no->esq = nova->dir;
+  nova->dir = no;
+  atualizar_altura_faixa(no);
+  atualizar_altura_faixa(nova);
+  return nova;
+}
+
+FAIXA *rotacionar_esquerda_faixa(FAIXA *no) {
+  FAIXA *nova = no->dir;
+  no->dir = nova->esq;
+  nova->esq = no;
+  atualizar_altura_faixa(no);
+  atualizar_altura_faixa(nova);
+  return nova;
+}
+
+FAIXA *balancear_faixa(FAIXA *no) {
+  int fb = altura_faixa(no->esq) - altura_faixa(no->dir);
+
+  if (fb > 1) {
+    if (altura_faixa(no->esq->esq) < altura_faixa(no->esq->dir)) {
+      ESTAT_CONTAR(rotacoes_duplas, 1);
+      no->esq = rotacionar_esquerda_faixa(no->esq);
+    } else {
+      ESTAT_CONTAR(rotacoes_simples, 1);
+    }
+    return rotacionar_direita_faixa(no);
+  }
+  if (fb < -1) {
+    if (altura_faixa(no->dir->dir) < altura_faixa(no->dir->esq)) {
+      ESTAT_CONTAR(rotacoes_duplas, 1);
+      no->dir = rotacionar_direita_faixa(no->dir);
+    } else {
+      ESTAT_CONTAR(rotacoes_simples, 1);
+    }
+    return rotacionar_esquerda_faixa(no);
+  }
+  return no;
+}
+
+// Pendura um nó já alocado (cujo início não está na árvore)
+FAIXA *no_inserir_intervalos(FAIXA *raiz, FAIXA *novo) {
+  if (raiz == NULL)
+    return novo;
+  ESTAT_VISITAR();
+  if (ESTAT_CMP(novo->ini < raiz->ini))
+    raiz->esq = no_inserir_intervalos(raiz->esq, novo);
+  else
+    raiz->dir = no_inserir_intervalos(raiz->dir, novo);
+  atualizar_altura_faixa(raiz);
+  return balancear_faixa(raiz);
+}
+
+// Desliga (sem liberar) a menor faixa da subárvore
+FAIXA *no_retirar_minimo_intervalos(FAIXA *raiz, FAIXA **minimo) {
+  if (raiz->esq == NULL) {
+    *minimo = raiz;
+    return raiz->dir;
+  }
+  ESTAT_VISITAR();
+  raiz->esq = no_retirar_minimo_intervalos(raiz->esq, minimo);
+  atualizar_altura_faixa(raiz);
+  return balancear_faixa(raiz);
+}
+
+/*
+    Remove a faixa que começa em `ini`. Com dois filhos, o sucessor é
+    desligado e ocupa o lugar do nó removido, em vez de ter os dados
+    copiados: assim nenhuma outra faixa muda de nó, e ponteiros para elas
+    continuam válidos durante a remoção (ver intervalos_inserir()).
+*/
+FAIXA *no_remover_intervalos(FAIXA *raiz, int ini) {
+  if (raiz == NULL)
+    return NULL;
+  ESTAT_VISITAR();
+  if (ESTAT_CMP(ini < raiz->ini)) {
+    raiz->esq = no_remover_intervalos(raiz->esq, ini);
+  } else if (ESTAT_CMP(ini > raiz->ini)) {
+    raiz->dir = no_remover_intervalos(raiz->dir, ini);
+  } else if (raiz->esq == NULL || raiz->dir == NULL) {
+    FAIXA *filho = raiz->esq ? raiz->esq : raiz->dir;
+    free(raiz);
+    ESTAT_LIBERAR(sizeof(FAIXA));
+    return filho;
+  } else {
+    FAIXA *sucessor;
+    FAIXA *dir = no_retirar_minimo_intervalos(raiz->dir, &sucessor);
+    sucessor->esq = raiz->esq;
+    sucessor->dir = dir;
+    free(raiz);
+    ESTAT_LIBERAR(sizeof(FAIXA));
+    raiz = sucessor;
+  }
+  atualizar_altura_faixa(raiz);
+  return balancear_faixa(raiz);
+}
+
+// Última faixa que começa em chave ou antes, e primeira que começa depois
+void vizinhas_intervalos(FAIXA *raiz, int chave, FAIXA **antes,
+                         FAIXA **depois) {
+  *antes = *depois = NULL;
+  while (raiz != NULL) {
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(raiz->ini <= chave)) {
+      *antes = raiz;
+      raiz = raiz->dir;
+    } else {
+      *depois = raiz;
+      raiz = raiz->esq;
+    }
+  }
+}
+
+void no_apagar_intervalos(FAIXA *no) {
+  if (no != NULL) {
+    no_apagar_intervalos(no->esq);
+    no_apagar_intervalos(no->dir);
+    free(no);
+    ESTAT_LIBERAR(sizeof(FAIXA));
+  }
+}
+
+INTERVALOS *intervalos_criar(void) {
+  INTERVALOS *T = (INTERVALOS *)malloc(sizeof(INTERVALOS));
+  if (T != NULL)
+    *T = NULL;
+  return T;
+}
+
+/*
+    Inserção: as faixas vizinhas decidem tudo. As contas de vizinhança são
+    feitas em 64 bits para não transbordar em INT_MIN e INT_MAX, e os
+    inícios só mudam sem passar por cima de outra faixa, então a ordem da
+    árvore se mantém sem reposicionar nós.
+*/
+int intervalos_inserir(INTERVALOS *T, int chave) {
+  if (T == NULL)
+    return -1;
+
+  FAIXA *antes, *depois;
+  vizinhas_intervalos(*T, chave, &antes, &depois);
+  if (antes != NULL && antes->fim >= chave)
+    return 0;
+
+  int liga_antes = antes != NULL && (int64_t)antes->fim + 1 == chave;
+  int liga_depois = depois != NULL && (int64_t)chave + 1 == depois->ini;
+  if (liga_antes && liga_depois) {
+    // A chave fecha o buraco entre as duas faixas: a de depois some
+    antes->fim = depois->fim;
+    *T = no_remover_intervalos(*T, depois->ini);
+  } else if (liga_antes) {
+    antes->fim = chave;
+  } else if (liga_depois) {
+    depois->ini = chave;
+  } else {
+    FAIXA *novo = criar_faixa(chave, chave);
+    if (novo == NULL)
+      return 0;
+    *T = no_inserir_intervalos(*T, novo);
+    ESTAT_ALTURA((uint64_t)altura_faixa(*T));
+  }
+  return 1;
+}
+
+// Remoção: encurta a faixa pela ponta ou a parte em duas pelo meio
+int intervalos_remover(INTERVALOS *T, int chave) {
+  if (T == NULL)
+    return 0;
+
+  FAIXA *f, *depois;
+  vizinhas_intervalos(*T, chave, &f, &depois);
+  if (f == NULL || f->fim < chave)
+    return 0;
+
+  if (f->ini == f->fim) {
+    *T = no_remover_intervalos(*T, chave);
+  } else if (chave == f->ini) {
+    f->ini = chave + 1;
+  } else if (chave == f->fim) {
+    f->fim = chave - 1;
+  } else {
+    FAIXA *novo = criar_faixa(chave + 1, f->fim);
+    if (novo == NULL)
+      return 0;
+    f->fim = chave - 1;
+    *T = no_inserir_intervalos(*T, novo);
+    ESTAT_ALTURA((uint64_t)altura_faixa(*T));
+  }
+  return 1;
+}
+
+int intervalos_consultar(INTERVALOS *T, int chave) {
+  if (T == NULL)
+    return 0;
+  FAIXA *no = *T;
+  while (no != NULL) {
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(chave < no->ini))
+      no = no->esq;
+    else if (ESTAT_CMP(chave <= no->fim))
+      return 1;
+    else
+      no = no->dir;
+  }
+  return 0;
+}
+
+void intervalos_apagar(INTERVALOS **T) {
+  if (T != NULL && *T != NULL) {
+    no_apagar_intervalos(**T);
+    free(*T);
+    *T = NULL;
+  }
+}
+
+void empilhar_esquerda_intervalos(ITERADOR *it, FAIXA *no) {
+  while (no != NULL) {
+    iterador_empilhar(it, no);
+    no = no->esq;
+  }
+}
+
+/*
+    O iterador percorre as faixas como o da AVL percorre os nós (pilha de
+    faixas pendentes) e, dentro da faixa corrente (`atual`), guarda em
+    `posicao` a próxima chave. `posicao` tem 64 bits para poder passar de
+    INT_MAX ao fim da última faixa.
+*/
+void intervalos_iterador(INTERVALOS *T, ITERADOR *it) {
+  iterador_iniciar(it, T);
+  if (T != NULL)
+    empilhar_esquerda_intervalos(it, *T);
+}
+
+// Garante uma chave na faixa corrente, passando à próxima se ela acabou
+int avancar_intervalos(ITERADOR *it) {
+  FAIXA *f = (FAIXA *)it->atual;
+  if (f != NULL && it->posicao <= f->fim)
+    return 1;
+  f = (FAIXA *)iterador_desempilhar(it);
+  it->atual = f;
+  if (f == NULL)
+    return 0;
+  it->posicao = f->ini;
+  empilhar_esquerda_intervalos(it, f->dir);
+  return 1;
+}
+
+int intervalos_iterador_proximo(ITERADOR *it, int *valor) {
+  if (!avancar_intervalos(it))
+    return 0;
+  *valor = (int)it->posicao++;
+  return 1;
+}
+
+size_t intervalos_iterador_lote(ITERADOR *it, int *destino,
+                                size_t capacidade) {
+  size_t n = 0;
+  while (n < capacidade && avancar_intervalos(it)) {
+    FAIXA *f = (FAIXA *)it->atual;
+    int64_t base = it->posicao;
+    uint64_t resto = (uint64_t)(f->fim - base + 1);
+    size_t q = capacidade - n < resto ? capacidade - n : (size_t)resto;
+    for (size_t i = 0; i < q; i++)
+      destino[n + i] = (int)(base + (int64_t)i);
+    n += q;
+    it->posicao += (int64_t)q;
+  }
+  return n;
+}
+
+int intervalos_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  // O alvo ainda cai na faixa corrente: só move a posição
+  FAIXA *f = (FAIXA *)it->atual;
+  if (f != NULL && it->posicao <= f->fim && alvo <= f->fim) {
+    if (alvo > it->posicao)
+      it->posicao = alvo;
+    return intervalos_iterador_proximo(it, valor);
+  }
+  it->atual = NULL;
+
+  // Senão, o mesmo salto do iterador da AVL, comparando pelo fim da faixa
+  while (it->topo > 0) {
+    FAIXA *topo = (FAIXA *)iterador_topo(it);
+    if (topo->fim >= alvo) {
+      avancar_intervalos(it);
+      if (alvo > it->posicao)
+        it->posicao = alvo;
+      return intervalos_iterador_proximo(it, valor);
+    }
+    iterador_desempilhar(it);
+
+    // A subárvore direita do topo termina antes do próximo pendente
+    FAIXA *abaixo = (FAIXA *)iterador_topo(it);
+    if (abaixo != NULL && abaixo->ini <= alvo)
+      continue;
+
+    FAIXA *no = topo->dir;
+    while (no != NULL) {
+      if (no->fim >= alvo) {
+        iterador_empilhar(it, no);
+        no = no->esq;
+      } else {
+        no = no->dir;
+      }
+    }
+  }
+  return 0;
+}
+
+// Faixa do meio na raiz e metades como subárvores, como avl_construir()
+FAIXA *no_construir_intervalos(const int *ini, const int *fim, size_t r,
+                               int *falha) {
+  if (r == 0)
+    return NULL;
+  size_t meio = r / 2;
+  FAIXA *raiz = criar_faixa(ini[meio], fim[meio]);
+  if (raiz == NULL) {
+    *falha = 1;
+    return NULL;
+  }
+  raiz->esq = no_construir_intervalos(ini, fim, meio, falha);
+  raiz->dir = no_construir_intervalos(ini + meio + 1, fim + meio + 1,
+                                      r - meio - 1, falha);
+  atualizar_altura_faixa(raiz);
+  return raiz;
+}
+
+// Agrupa as chaves em faixas e monta a árvore com elas
+int intervalos_construir(INTERVALOS *T, const int *chaves, size_t n,
+                         int threads) {
+  (void)threads;
+  if (T == NULL)
+    return -1;
+
+  size_t r = n > 0;
+  for (size_t i = 1; i < n; i++)
+    r += (int64_t)chaves[i - 1] + 1 != chaves[i];
+
+  int *ini = (int *)malloc((2 * r + 1) * sizeof(int));
+  if (ini == NULL) {
+    no_apagar_intervalos(*T);
+    *T = NULL;
+    return 0;
+  }
+  int *fim = ini + r;
+  size_t k = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (i == 0 || (int64_t)chaves[i - 1] + 1 != chaves[i])
+      ini[k++] = chaves[i];
+    fim[k - 1] = chaves[i];
+  }
+
+  int resp = intervalos_construir_faixas(T, ini, fim, r);
+  free(ini);
+  return resp;
+}
+
+int intervalos_construir_faixas(INTERVALOS *T, const int *ini, const int *fim,
+                                size_t r) {
+  if (T == NULL)
+    return -1;
+
+  no_apagar_intervalos(*T);
+  *T = NULL;
+
+  int falha = 0;
+  FAIXA *raiz = no_construir_intervalos(ini, fim, r, &falha);
+  if (falha) {
+    no_apagar_intervalos(raiz);
+    return 0;
+  }
+  *T = raiz;
+  return 1;
+}
+
+// Copia as faixas em ordem a partir da posição k (devolve a nova posição)
+size_t no_copiar_intervalos(FAIXA *no, int *ini, int *fim, size_t capacidade,
+                            size_t k) {
+  if (no == NULL || k == capacidade)
+    return k;
+  k = no_copiar_intervalos(no->esq, ini, fim, capacidade, k);
+  if (k < capacidade) {
+    ini[k] = no->ini;
+    fim[k] = no->fim;
+    k++;
+  }
+  return no_copiar_intervalos(no->dir, ini, fim, capacidade, k);
+}
+
+size_t no_faixas_intervalos(FAIXA *no) {
+  if (no == NULL)
+    return 0;
+  return 1 + no_faixas_intervalos(no->esq) + no_faixas_intervalos(no->dir);
+}
+
+size_t no_tamanho_intervalos(FAIXA *no) {
+  if (no == NULL)
+    return 0;
+  return (size_t)((int64_t)no->fim - no->ini + 1) +
+         no_tamanho_intervalos(no->esq) + no_tamanho_intervalos(no->dir);
+}
+
+size_t intervalos_faixas(INTERVALOS *T) {
+  return T ? no_faixas_intervalos(*T) : 0;
+}
+
+size_t intervalos_copiar(INTERVALOS *T, int *ini, int *fim,
+                         size_t capacidade) {
+  return T ? no_copiar_intervalos(*T, ini, fim, capacidade, 0) : 0;
+}
+
+size_t intervalos_tamanho(INTERVALOS *T) {
+  return T ? no_tamanho_intervalos(*T) : 0;
+}
+
+int intervalos_altura(INTERVALOS *T) {
+  if (T == NULL)
+    return 0;
+  return altura_faixa(*T);
+}
+
+// Junção pelo nó do meio, como no_juntar_avl()
+FAIXA *no_juntar_intervalos(FAIXA *menores, FAIXA *meio, FAIXA *maiores) {
+  int he = altura_faixa(menores), hd = altura_faixa(maiores);
+
+  if (he > hd + 1) {
+    ESTAT_VISITAR();
+    menores->dir = no_juntar_intervalos(menores->dir, meio, maiores);
+    atualizar_altura_faixa(menores);
+    return balancear_faixa(menores);
+  }
+  if (hd > he + 1) {
+    ESTAT_VISITAR();
+    maiores->esq = no_juntar_intervalos(menores, meio, maiores->esq);
+    atualizar_altura_faixa(maiores);
+    return balancear_faixa(maiores);
+  }
+
+  meio->esq = menores;
+  meio->dir = maiores;
+  atualizar_altura_faixa(meio);
+  return meio;
+}
+
+// Divisão pelo início das faixas, como no_dividir_avl()
+void no_dividir_intervalos(FAIXA *no, int chave, FAIXA **menores,
+                           FAIXA **maiores) {
+  if (no == NULL) {
+    *menores = *maiores = NULL;
+    return;
+  }
+  ESTAT_VISITAR();
+
+  FAIXA *esq = no->esq, *dir = no->dir, *parte;
+  if (ESTAT_CMP(no->ini < chave)) {
+    no_dividir_intervalos(dir, chave, &parte, maiores);
+    *menores = no_juntar_intervalos(esq, no, parte);
+  } else {
+    no_dividir_intervalos(esq, chave, menores, &parte);
+    *maiores = no_juntar_intervalos(parte, no, dir);
+  }
+}
+
+/*
+    A divisão pelos inícios deixa do lado menor a faixa que contém a chave
+    (se ela começa antes da chave); a parte >= chave vira uma faixa nova,
+    alocada antes de qualquer mudança, e entra como a menor do outro lado.
+*/
+int intervalos_dividir(INTERVALOS *T, int chave, INTERVALOS *menores,
+                       INTERVALOS *maiores) {
+  if (T == NULL || menores == NULL || maiores == NULL)
+    return -1;
+
+  FAIXA *antes, *depois, *resto = NULL;
+  vizinhas_intervalos(*T, chave, &antes, &depois);
+  if (antes != NULL && antes->ini < chave && antes->fim >= chave) {
+    resto = criar_faixa(chave, antes->fim);
+    if (resto == NULL)
+      return 0;
+    antes->fim = chave - 1;
+  }
+
+  no_apagar_intervalos(*menores);
+  no_apagar_intervalos(*maiores);
+  no_dividir_intervalos(*T, chave, menores, maiores);
+  if (resto != NULL)
+    *maiores = no_juntar_intervalos(NULL, resto, *maiores);
+  *T = NULL;
+  return 1;
+}
+
+/*
+    A menor faixa de B vira o nó do meio da junção. Se ela encosta na maior
+    de A, é absorvida por ela e a seguinte de B faz o papel de meio.
+*/
+int intervalos_juntar(INTERVALOS *A, INTERVALOS *B) {
+  if (A == NULL || B == NULL)
+    return -1;
+  if (*B == NULL)
+    return 1;
+  if (*A == NULL) {
+    *A = *B;
+    *B = NULL;
+    return 1;
+  }
+
+  FAIXA *meio, *ultima = *A;
+  while (ultima->dir != NULL)
+    ultima = ultima->dir;
+  *B = no_retirar_minimo_intervalos(*B, &meio);
+  if ((int64_t)ultima->fim + 1 == meio->ini) {
+    ultima->fim = meio->fim;
+    free(meio);
+    ESTAT_LIBERAR(sizeof(FAIXA));
+    if (*B == NULL)
+      return 1;
+    *B = no_retirar_minimo_intervalos(*B, &meio);
+  }
+  *A = no_juntar_intervalos(*A, meio, *B);
+  *B = NULL;
+  ESTAT_ALTURA((uint64_t)altura_faixa(*A));
+  return 1;
+}
+
+int intervalos_extremos(INTERVALOS *T, int *menor, int *maior) {
+  if (T == NULL || *T == NULL)
+    return 0;
+
+  FAIXA *no = *T;
+  while (no->esq != NULL)
+    no = no->esq;
+  *menor = no->ini;
+  for (no = *T; no->dir != NULL; no = no->dir)
+    ;
+  *maior = no->fim;
+  return 1;
+}
@@ -0,0 +1,221 @@
+#ifndef INTERVALOS_H
+#define INTERVALOS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../set/iterador.h"
+
+/*
+    Conjunto guardado como faixas [ini, fim] de chaves consecutivas, disjuntas
+    e maximais (duas faixas nunca se encostam), em uma árvore AVL ordenada
+    pelo início da faixa. Memória e tempo dependem da quantidade de faixas,
+    não de chaves: 10M chaves em algumas centenas de faixas ocupam poucos KB.
+*/
+
+// Estrutura do nó (uma faixa).
+typedef struct faixa FAIXA;
+
+// Define INTERVALOS como um ponteiro para a raiz.
+typedef FAIXA *INTERVALOS;
+
+/**
+ * @brief Cria um conjunto de faixas vazio.
+ *
+ * @return INTERVALOS* Ponteiro para a estrutura, ou NULL em caso de erro na
+ * alocação.
+ */
+INTERVALOS *intervalos_criar(void);
+
+/**
+ * @brief Insere uma chave, estendendo ou fundindo as faixas vizinhas.
+ *
+ * Uma chave logo depois de uma faixa a estende; logo antes, também; entre
+ * duas faixas separadas só por ela, funde as duas. Só uma chave isolada
+ * cria um nó.
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param chave Chave a ser inserida.
+ * @return int Retorna 1 se inseriu, 0 se a chave já existia (ou faltou
+ * memória), ou -1 se a estrutura for inválida.
+ */
+int intervalos_inserir(INTERVALOS *T, int chave);
+
+/**
+ * @brief Remove uma chave, encurtando ou partindo a faixa que a contém.
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param chave Chave a ser removida.
+ * @return int Retorna 1 se removeu, ou 0 se a chave não existia (ou faltou
+ * memória para partir a faixa; nesse caso nada muda).
+ */
+int intervalos_remover(INTERVALOS *T, int chave);
+
+/**
+ * @brief Verifica a existência de uma chave, em O(log(faixas)).
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param chave Chave a ser consultada.
+ * @return int Retorna 1 se a chave estiver presente, ou 0 caso contrário.
+ */
+int intervalos_consultar(INTERVALOS *T, int chave);
+
+/**
+ * @brief Apaga a estrutura, liberando toda a memória alocada.
+ *
+ * @param T Endereço do ponteiro para a estrutura. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void intervalos_apagar(INTERVALOS **T);
+
+/**
+ * @brief Prepara um iterador em ordem crescente, chave a chave.
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param it Iterador a ser preparado.
+ */
+void intervalos_iterador(INTERVALOS *T, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por intervalos_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 ao final do percurso.
+ */
+int intervalos_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Copia as próximas chaves do percurso, em ordem, para um vetor.
+ *
+ * Cada faixa é despejada num laço simples, sem uma chamada por chave.
+ *
+ * @param it Iterador preparado por intervalos_iterador().
+ * @param destino Vetor que recebe as chaves.
+ * @param capacidade Quantidade máxima de chaves copiadas.
+ * @return size_t Quantidade de chaves copiadas (menor que `capacidade` só
+ * ao final do percurso).
+ */
+size_t intervalos_iterador_lote(ITERADOR *it, int *destino,
+                                size_t capacidade);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * Dentro da faixa corrente é O(1); fora dela, O(log(faixas)).
+ *
+ * @param it Iterador preparado por intervalos_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 se não houver chave
+ * maior ou igual a `alvo`.
+ */
+int intervalos_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Substitui o conteúdo por chaves ordenadas e sem repetição.
+ *
+ * As chaves são agrupadas em faixas e a árvore é montada já balanceada.
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @param threads Ignorado: a montagem é linear nas chaves e as faixas são
+ * poucas.
+ * @return int Retorna 1 se bem-sucedida, 0 em caso de falha de alocação (a
+ * estrutura fica vazia), ou -1 se a estrutura for inválida.
+ */
+int intervalos_construir(INTERVALOS *T, const int *chaves, size_t n,
+                         int threads);
+
+/**
+ * @brief Substitui o conteúdo por faixas prontas.
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param ini Início de cada faixa.
+ * @param fim Fim de cada faixa (inclusive). As faixas devem estar em ordem
+ * crescente, com fim[i] + 1 < ini[i + 1].
+ * @param r Quantidade de faixas.
+ * @return int Retorna 1 se bem-sucedida, 0 em caso de falha de alocação (a
+ * estrutura fica vazia), ou -1 se a estrutura for inválida.
+ */
+int intervalos_construir_faixas(INTERVALOS *T, const int *ini, const int *fim,
+                                size_t r);
+
+/**
+ * @brief Quantidade de faixas, em O(faixas).
+ *
+ * @param T Ponteiro para a estrutura.
+ * @return size_t Quantidade de faixas (0 se vazia ou inválida).
+ */
+size_t intervalos_faixas(INTERVALOS *T);
+
+/**
+ * @brief Copia as faixas, em ordem, para dois vetores.
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param ini Recebe o início de cada faixa.
+ * @param fim Recebe o fim de cada faixa.
+ * @param capacidade Quantidade máxima de faixas copiadas.
+ * @return size_t Quantidade de faixas copiadas.
+ */
+size_t intervalos_copiar(INTERVALOS *T, int *ini, int *fim,
+                         size_t capacidade);
+
+/**
+ * @brief Quantidade de chaves, somando as faixas em O(faixas).
+ *
+ * @param T Ponteiro para a estrutura.
+ * @return size_t Quantidade de chaves.
+ */
+size_t intervalos_tamanho(INTERVALOS *T);
+
+/**
+ * @brief Retorna a altura da árvore de faixas, em O(1).
+ *
+ * @param T Ponteiro para a estrutura.
+ * @return int Altura (0 se vazia).
+ */
+int intervalos_altura(INTERVALOS *T);
+
+/**
+ * @brief Divide a estrutura pela chave, em O(log(faixas)).
+ *
+ * Como em avl_dividir(); a faixa que contém a chave, se houver, é partida
+ * entre os dois lados.
+ *
+ * @param T Ponteiro para a estrutura; fica vazia.
+ * @param chave Chave de corte.
+ * @param menores Recebe as chaves < chave (conteúdo anterior é apagado).
+ * @param maiores Recebe as chaves >= chave (conteúdo anterior é apagado).
+ * @return int Retorna 1 se bem-sucedida, 0 se faltou memória para partir a
+ * faixa (nada muda), ou -1 se algum ponteiro for inválido.
+ */
+int intervalos_dividir(INTERVALOS *T, int chave, INTERVALOS *menores,
+                       INTERVALOS *maiores);
+
+/**
+ * @brief Move todas as chaves de B para o fim de A, em O(log(faixas)).
+ *
+ * Todas as chaves de A devem ser menores que as de B (não é verificado).
+ * Se a última faixa de A encosta na primeira de B, as duas viram uma só.
+ * Nenhum nó é alocado, então a junção não falha.
+ *
+ * @param A Ponteiro para a estrutura que recebe as chaves.
+ * @param B Ponteiro para a estrutura cedida; fica vazia.
+ * @return int Retorna 1, ou -1 se algum ponteiro for inválido.
+ */
+int intervalos_juntar(INTERVALOS *A, INTERVALOS *B);
+
+/**
+ * @brief Obtém a menor e a maior chave, em O(log(faixas)).
+ *
+ * @param T Ponteiro para a estrutura.
+ * @param menor Recebe a menor chave.
+ * @param maior Recebe a maior chave.
+ * @return int Retorna 1 se a estrutura tem chaves, ou 0 se estiver vazia.
+ */
+int intervalos_extremos(INTERVALOS *T, int *menor, int *maior);
+
+#endif // INTERVALOS_H
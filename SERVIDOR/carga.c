@@ -0,0 +1,279 @@
+// Carga - gerador de carga para o servidor: várias conexões enviando pedidos
+// em pipeline, mede vazão e latência (p50/p99/p99.9)
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CARGA_CAMINHO "/tmp/set.sock"
+
+/*
+    Cada thread abre uma conexão e mantém até `profundidade` pedidos em voo:
+    envia o que a janela permite, lê as respostas disponíveis e casa cada
+    linha de resposta com o pedido mais antigo pendente (o servidor responde
+    em ordem, uma linha por pedido). A latência de um pedido é o intervalo
+    entre o envio e a chegada da sua linha de resposta.
+*/
+typedef struct carga {
+  const char *caminho;
+  int conexoes;
+  long pedidos;      // Por conexão
+  int profundidade;  // Pedidos em voo por conexão
+  long chaves;       // Valores sorteados em [0, chaves)
+  int insercoes;     // Porcentagem de inserir/remover (metade cada)
+  int estrutura;     // Estrutura dos conjuntos criados (ver criar_set())
+} CARGA;
+
+typedef struct trabalho {
+  const CARGA *carga;
+  int id;
+  double *latencias; // Em microssegundos, uma por pedido
+  long respondidos;
+  int ok;
+} TRABALHO;
+
+// Protocolo das Funções
+
+// Auxiliares
+double agora(void);
+uint64_t sortear(uint64_t *estado);
+int conectar(const char *caminho);
+int enviar_tudo(int fd, const char *dados, size_t n);
+int montar_pedido(const CARGA *g, uint64_t *estado, const char *nome,
+                  char *buf, size_t cap);
+void *executar_conexao(void *arg);
+int comparar_double(const void *a, const void *b);
+double percentil(const double *v, size_t n, double p);
+
+// Principais
+int main(int argc, char *argv[]);
+
+double agora(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+// xorshift64*
+uint64_t sortear(uint64_t *estado) {
+  uint64_t x = *estado;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *estado = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
+int conectar(const char *caminho) {
+  struct sockaddr_un endereco;
+  memset(&endereco, 0, sizeof(endereco));
+  endereco.sun_family = AF_UNIX;
+  strncpy(endereco.sun_path, caminho, sizeof(endereco.sun_path) - 1);
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return -1;
+  if (connect(fd, (struct sockaddr *)&endereco, sizeof(endereco)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int enviar_tudo(int fd, const char *dados, size_t n) {
+  while (n > 0) {
+    ssize_t w = send(fd, dados, n, MSG_NOSIGNAL);
+    if (w < 0) {
+      if (errno == EINTR)
+        continue;
+      return 0;
+    }
+    dados += w;
+    n -= (size_t)w;
+  }
+  return 1;
+}
+
+// Escreve um pedido (com '\n') em buf e retorna o seu tamanho
+int montar_pedido(const CARGA *g, uint64_t *estado, const char *nome,
+                  char *buf, size_t cap) {
+  long v = (long)(sortear(estado) % (uint64_t)g->chaves);
+  int dado = (int)(sortear(estado) % 100);
+  const char *op = "pertence";
+  if (dado < g->insercoes)
+    op = (dado & 1) ? "remover" : "inserir";
+  return snprintf(buf, cap, "%s %s %ld\n", op, nome, v);
+}
+
+void *executar_conexao(void *arg) {
+  TRABALHO *t = (TRABALHO *)arg;
+  const CARGA *g = t->carga;
+  int fd = conectar(g->caminho);
+  if (fd < 0) {
+    perror(g->caminho);
+    return NULL;
+  }
+
+  // Um conjunto por conexão evita que as threads disputem a mesma trava
+  // de escrita no catálogo só por acaso do nome
+  char nome[32];
+  snprintf(nome, sizeof(nome), "carga%d", t->id);
+  char pedido[96];
+  int n = snprintf(pedido, sizeof(pedido), "criar %s %d\n", nome,
+                   g->estrutura);
+  char resposta[64];
+  if (!enviar_tudo(fd, pedido, (size_t)n) ||
+      recv(fd, resposta, sizeof(resposta), 0) <= 0) {
+    close(fd);
+    return NULL;
+  }
+
+  double *envio = (double *)malloc((size_t)g->profundidade * sizeof(double));
+  size_t cap_envio = (size_t)g->profundidade * sizeof(pedido);
+  char *saida = (char *)malloc(cap_envio);
+  char entrada[65536];
+  if (!envio || !saida) {
+    free(envio);
+    free(saida);
+    close(fd);
+    return NULL;
+  }
+
+  uint64_t estado = 0x9E3779B97F4A7C15ULL * (uint64_t)(t->id + 1);
+  long enviados = 0;
+  int ok = 1;
+  while (ok && t->respondidos < g->pedidos) {
+    // Completa a janela; os instantes de envio ficam num anel indexado pela
+    // ordem do pedido
+    size_t usado = 0;
+    double instante = agora();
+    while (enviados < g->pedidos &&
+           enviados - t->respondidos < g->profundidade) {
+      usado += (size_t)montar_pedido(g, &estado, nome, saida + usado,
+                                     cap_envio - usado);
+      envio[enviados % g->profundidade] = instante;
+      enviados++;
+    }
+    if (usado > 0 && !enviar_tudo(fd, saida, usado))
+      break;
+
+    ssize_t r = recv(fd, entrada, sizeof(entrada), 0);
+    if (r <= 0)
+      break;
+    double chegada = agora();
+    for (ssize_t i = 0; i < r; i++) {
+      if (entrada[i] != '\n')
+        continue;
+      if (t->respondidos >= enviados) {
+        ok = 0; // Resposta sem pedido: protocolo fora de sincronia
+        break;
+      }
+      t->latencias[t->respondidos] =
+          (chegada - envio[t->respondidos % g->profundidade]) * 1e6;
+      t->respondidos++;
+    }
+  }
+  t->ok = ok && t->respondidos == g->pedidos;
+
+  free(envio);
+  free(saida);
+  close(fd);
+  return NULL;
+}
+
+int comparar_double(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+// Percentil p (0..1) de um vetor já ordenado
+double percentil(const double *v, size_t n, double p) {
+  if (n == 0)
+    return 0.0;
+  size_t i = (size_t)(p * (double)(n - 1) + 0.5);
+  return v[i < n ? i : n - 1];
+}
+
+int main(int argc, char *argv[]) {
+  /*
+          Uso: ./carga [caminho] [conexões] [pedidos] [profundidade]
+                       [chaves] [% inserir/remover] [estrutura]
+          Padrão: /tmp/set.sock 4 200000 64 100000 20 0
+  */
+  CARGA g = {CARGA_CAMINHO, 4, 200000, 64, 100000, 20, 0};
+  if (argc > 1)
+    g.caminho = argv[1];
+  if (argc > 2)
+    g.conexoes = atoi(argv[2]);
+  if (argc > 3)
+    g.pedidos = atol(argv[3]);
+  if (argc > 4)
+    g.profundidade = atoi(argv[4]);
+  if (argc > 5)
+    g.chaves = atol(argv[5]);
+  if (argc > 6)
+    g.insercoes = atoi(argv[6]);
+  if (argc > 7)
+    g.estrutura = atoi(argv[7]);
+  if (g.conexoes < 1 || g.pedidos < 1 || g.profundidade < 1 || g.chaves < 1 ||
+      g.insercoes < 0 || g.insercoes > 100) {
+    fprintf(stderr, "Erro: parâmetros inválidos\n");
+    return 1;
+  }
+
+  size_t total = (size_t)g.conexoes * (size_t)g.pedidos;
+  double *latencias = (double *)malloc(total * sizeof(double));
+  TRABALHO *t = (TRABALHO *)calloc((size_t)g.conexoes, sizeof(TRABALHO));
+  pthread_t *ids = (pthread_t *)malloc((size_t)g.conexoes * sizeof(pthread_t));
+  if (!latencias || !t || !ids) {
+    fprintf(stderr, "Erro: Falha na alocação de memória\n");
+    return 1;
+  }
+
+  double inicio = agora();
+  for (int i = 0; i < g.conexoes; i++) {
+    t[i].carga = &g;
+    t[i].id = i;
+    t[i].latencias = latencias + (size_t)i * (size_t)g.pedidos;
+    pthread_create(&ids[i], NULL, executar_conexao, &t[i]);
+  }
+  for (int i = 0; i < g.conexoes; i++)
+    pthread_join(ids[i], NULL);
+  double segundos = agora() - inicio;
+
+  // Junta as latências medidas (conexões que falharam contribuem com o que
+  // chegaram a receber)
+  size_t medidos = 0;
+  int falhas = 0;
+  for (int i = 0; i < g.conexoes; i++) {
+    memmove(latencias + medidos, t[i].latencias,
+            (size_t)t[i].respondidos * sizeof(double));
+    medidos += (size_t)t[i].respondidos;
+    falhas += !t[i].ok;
+  }
+  qsort(latencias, medidos, sizeof(double), comparar_double);
+
+  printf("%d conexões x %ld pedidos, profundidade %d: %zu respostas em "
+         "%.3f s (%.0f pedidos/s)\n",
+         g.conexoes, g.pedidos, g.profundidade, medidos, segundos,
+         segundos > 0 ? (double)medidos / segundos : 0.0);
+  printf("latência (us): p50 %.1f  p99 %.1f  p99.9 %.1f  máx %.1f\n",
+         percentil(latencias, medidos, 0.50),
+         percentil(latencias, medidos, 0.99),
+         percentil(latencias, medidos, 0.999),
+         medidos ? latencias[medidos - 1] : 0.0);
+  if (falhas)
+    fprintf(stderr, "%d conexões falharam\n", falhas);
+
+  free(latencias);
+  free(t);
+  free(ids);
+  return falhas ? 1 : 0;
+}
@@ -0,0 +1,320 @@
+// Servidor - mantém conjuntos nomeados em memória e atende os comandos de
+// set/comandos.h por um socket Unix local
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "comandos.h"
+#include "ordenacao.h"
+
+// Caminho padrão do socket
+#define SERVIDOR_CAMINHO "/tmp/set.sock"
+
+// Entrada acumulada por conexão; cresce se uma linha não couber
+#define SERVIDOR_LEITURA 65536
+
+// Eventos tratados por chamada de epoll_wait()
+#define SERVIDOR_EVENTOS 64
+
+/*
+    Cada conexão tem o seu motor de comandos (com lote e saída próprios),
+    todos sobre o mesmo catálogo. O descritor é registrado com EPOLLONESHOT:
+    quando chega dado, a conexão vai para a fila e um único trabalhador a
+    atende (lê tudo o que houver, executa, responde) e só então a rearma.
+    Assim os pedidos de uma conexão nunca são atendidos fora de ordem e o
+    laço de eventos não bloqueia em nenhuma conexão.
+*/
+typedef struct conexao {
+  int fd;
+  COMANDOS *comandos;
+  SAIDA *saida;
+  char *entrada;
+  size_t usado, capacidade;
+  struct conexao *prox_fila;   // Fila de conexões prontas
+  struct conexao *ant, *prox;  // Lista de conexões abertas
+} CONEXAO;
+
+typedef struct servidor {
+  int escuta;
+  int epoll;
+  CATALOGO *catalogo;
+  pthread_mutex_t trava;       // Fila e lista de conexões
+  pthread_cond_t pronta;
+  CONEXAO *inicio_fila, *fim_fila;
+  CONEXAO *abertas;
+  int encerrar;
+} SERVIDOR;
+
+static volatile sig_atomic_t parar = 0;
+
+// Protocolo das Funções
+
+// Auxiliares
+void pedir_parada(int sinal);
+int abrir_escuta(const char *caminho);
+CONEXAO *abrir_conexao(SERVIDOR *s, int fd);
+void fechar_conexao(SERVIDOR *s, CONEXAO *c);
+void enfileirar(SERVIDOR *s, CONEXAO *c);
+CONEXAO *desenfileirar(SERVIDOR *s);
+int atender(CONEXAO *c);
+void *trabalhador(void *arg);
+void aceitar(SERVIDOR *s);
+
+// Principais
+int main(int argc, char *argv[]);
+
+void pedir_parada(int sinal) {
+  (void)sinal;
+  parar = 1;
+}
+
+int abrir_escuta(const char *caminho) {
+  struct sockaddr_un endereco;
+  if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+    fprintf(stderr, "Erro: caminho de socket longo demais\n");
+    return -1;
+  }
+  memset(&endereco, 0, sizeof(endereco));
+  endereco.sun_family = AF_UNIX;
+  strcpy(endereco.sun_path, caminho);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    perror("socket");
+    return -1;
+  }
+  unlink(caminho);
+  if (bind(fd, (struct sockaddr *)&endereco, sizeof(endereco)) < 0 ||
+      listen(fd, SOMAXCONN) < 0) {
+    perror(caminho);
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+CONEXAO *abrir_conexao(SERVIDOR *s, int fd) {
+  CONEXAO *c = (CONEXAO *)calloc(1, sizeof(CONEXAO));
+  if (!c)
+    return NULL;
+  c->fd = fd;
+  c->capacidade = SERVIDOR_LEITURA;
+  c->entrada = (char *)malloc(c->capacidade);
+  // As respostas são escritas pelo trabalhador com write() bloqueante: um
+  // cliente que não lê segura apenas o trabalhador que o atende
+  c->saida = saida_descritor(fd);
+  c->comandos = comandos_criar(c->saida, s->catalogo, COMANDOS_CONFIRMAR);
+  if (!c->entrada || !c->saida || !c->comandos) {
+    comandos_apagar(&c->comandos);
+    saida_apagar(&c->saida);
+    free(c->entrada);
+    free(c);
+    return NULL;
+  }
+
+  pthread_mutex_lock(&s->trava);
+  c->prox = s->abertas;
+  if (s->abertas)
+    s->abertas->ant = c;
+  s->abertas = c;
+  pthread_mutex_unlock(&s->trava);
+  return c;
+}
+
+// Fecha o descritor (o que também o retira do epoll) e libera a conexão
+void fechar_conexao(SERVIDOR *s, CONEXAO *c) {
+  pthread_mutex_lock(&s->trava);
+  if (c->ant)
+    c->ant->prox = c->prox;
+  else
+    s->abertas = c->prox;
+  if (c->prox)
+    c->prox->ant = c->ant;
+  pthread_mutex_unlock(&s->trava);
+
+  comandos_apagar(&c->comandos);
+  saida_apagar(&c->saida);
+  close(c->fd);
+  free(c->entrada);
+  free(c);
+}
+
+void enfileirar(SERVIDOR *s, CONEXAO *c) {
+  pthread_mutex_lock(&s->trava);
+  c->prox_fila = NULL;
+  if (s->fim_fila)
+    s->fim_fila->prox_fila = c;
+  else
+    s->inicio_fila = c;
+  s->fim_fila = c;
+  pthread_cond_signal(&s->pronta);
+  pthread_mutex_unlock(&s->trava);
+}
+
+// Próxima conexão pronta, ou NULL quando o servidor encerra
+CONEXAO *desenfileirar(SERVIDOR *s) {
+  pthread_mutex_lock(&s->trava);
+  while (!s->inicio_fila && !s->encerrar)
+    pthread_cond_wait(&s->pronta, &s->trava);
+  CONEXAO *c = s->inicio_fila;
+  if (c) {
+    s->inicio_fila = c->prox_fila;
+    if (!s->inicio_fila)
+      s->fim_fila = NULL;
+  }
+  pthread_mutex_unlock(&s->trava);
+  return c;
+}
+
+/*
+    Lê tudo o que já chegou, executa as linhas completas e responde. Os
+    pedidos enviados em sequência pelo cliente (pipeline) chegam juntos e
+    viram lotes. Retorna 0 se a conexão deve ser fechada: no fim da entrada
+    o que estava pendente é respondido antes; só um erro fecha sem responder.
+*/
+int atender(CONEXAO *c) {
+  for (;;) {
+    if (c->usado == c->capacidade) {
+      char *maior = (char *)realloc(c->entrada, c->capacidade * 2);
+      if (!maior)
+        return 0;
+      c->entrada = maior;
+      c->capacidade *= 2;
+    }
+    ssize_t r = recv(c->fd, c->entrada + c->usado, c->capacidade - c->usado,
+                     MSG_DONTWAIT);
+    if (r == 0) {
+      // Cliente terminou de enviar: a última linha pode vir sem '\n', e o
+      // lote pendente ainda precisa ser respondido antes de fechar
+      if (c->usado > 0) {
+        c->entrada[c->usado++] = '\n';
+        comandos_processar(c->comandos, c->entrada, c->usado);
+        c->usado = 0;
+      }
+      comandos_concluir(c->comandos);
+      return 0;
+    }
+    if (r < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+      return 0;
+    }
+    c->usado += (size_t)r;
+
+    size_t consumidos = comandos_processar(c->comandos, c->entrada, c->usado);
+    memmove(c->entrada, c->entrada + consumidos, c->usado - consumidos);
+    c->usado -= consumidos;
+  }
+  return comandos_concluir(c->comandos);
+}
+
+void *trabalhador(void *arg) {
+  SERVIDOR *s = (SERVIDOR *)arg;
+  CONEXAO *c;
+  while ((c = desenfileirar(s)) != NULL) {
+    if (!atender(c)) {
+      fechar_conexao(s, c);
+      continue;
+    }
+    struct epoll_event ev = {.events = EPOLLIN | EPOLLONESHOT, .data.ptr = c};
+    if (epoll_ctl(s->epoll, EPOLL_CTL_MOD, c->fd, &ev) < 0)
+      fechar_conexao(s, c);
+  }
+  return NULL;
+}
+
+void aceitar(SERVIDOR *s) {
+  int fd;
+  while ((fd = accept4(s->escuta, NULL, NULL, SOCK_CLOEXEC)) >= 0) {
+    CONEXAO *c = abrir_conexao(s, fd);
+    struct epoll_event ev = {.events = EPOLLIN | EPOLLONESHOT, .data.ptr = c};
+    if (!c) {
+      close(fd);
+    } else if (epoll_ctl(s->epoll, EPOLL_CTL_ADD, fd, &ev) < 0) {
+      fechar_conexao(s, c);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const char *caminho = argc > 1 ? argv[1] : SERVIDOR_CAMINHO;
+  int threads = ordenacao_threads(argc > 2 ? atoi(argv[2]) : 0);
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = pedir_parada;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+  signal(SIGPIPE, SIG_IGN); // Cliente que fecha cedo não derruba o servidor
+
+  SERVIDOR s;
+  memset(&s, 0, sizeof(s));
+  pthread_mutex_init(&s.trava, NULL);
+  pthread_cond_init(&s.pronta, NULL);
+  s.catalogo = catalogo_criar();
+  s.escuta = abrir_escuta(caminho);
+  s.epoll = epoll_create1(EPOLL_CLOEXEC);
+  struct epoll_event ev = {.events = EPOLLIN, .data.ptr = NULL};
+  if (!s.catalogo || s.escuta < 0 || s.epoll < 0 ||
+      epoll_ctl(s.epoll, EPOLL_CTL_ADD, s.escuta, &ev) < 0) {
+    fprintf(stderr, "Erro: não foi possível iniciar o servidor\n");
+    return 1;
+  }
+
+  pthread_t *ids = (pthread_t *)malloc((size_t)threads * sizeof(pthread_t));
+  int criadas = 0;
+  while (ids && criadas < threads &&
+         pthread_create(&ids[criadas], NULL, trabalhador, &s) == 0)
+    criadas++;
+  if (criadas == 0) {
+    fprintf(stderr, "Erro: não foi possível criar os trabalhadores\n");
+    return 1;
+  }
+  fprintf(stderr, "Atendendo em %s com %d trabalhadores\n", caminho, criadas);
+
+  struct epoll_event eventos[SERVIDOR_EVENTOS];
+  while (!parar) {
+    int n = epoll_wait(s.epoll, eventos, SERVIDOR_EVENTOS, -1);
+    for (int i = 0; i < n; i++) {
+      if (eventos[i].data.ptr == NULL)
+        aceitar(&s);
+      else
+        enfileirar(&s, (CONEXAO *)eventos[i].data.ptr);
+    }
+    if (n < 0 && errno != EINTR) {
+      perror("epoll_wait");
+      break;
+    }
+  }
+
+  // Encerra os trabalhadores e fecha o que ainda estiver aberto
+  pthread_mutex_lock(&s.trava);
+  s.encerrar = 1;
+  s.inicio_fila = s.fim_fila = NULL;
+  pthread_cond_broadcast(&s.pronta);
+  pthread_mutex_unlock(&s.trava);
+  for (int i = 0; i < criadas; i++)
+    pthread_join(ids[i], NULL);
+  while (s.abertas)
+    fechar_conexao(&s, s.abertas);
+
+  free(ids);
+  close(s.epoll);
+  close(s.escuta);
+  unlink(caminho);
+  catalogo_apagar(&s.catalogo);
+  pthread_mutex_destroy(&s.trava);
+  pthread_cond_destroy(&s.pronta);
+  return 0;
+}
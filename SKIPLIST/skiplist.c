@@ -0,0 +1,495 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "skiplist.h"
+#include "../set/estatisticas.h"
+
+// Altura máxima de um nó. Com p = 1/4 cobre listas com até 4^16 = 2^32 nós.
+#define SKIPLIST_NIVEL_MAX 16
+
+// Bit menos significativo do ponteiro "prox" marca o nó como removido
+// naquele nível (nós são alinhados, então o bit está sempre livre).
+#define MARCA ((uintptr_t)1)
+
+// Struct Nó
+typedef struct no_skip {
+  int chave;
+  int nivel;                   // Quantidade de níveis em que o nó aparece
+  struct no_skip *retirado;    // Encadeamento na lista de retirados
+  _Atomic uintptr_t prox[];    // Sucessor em cada nível (com marca)
+} NO_SKIP;
+
+typedef struct skiplist {
+  NO_SKIP *cabeca;               // Sentinela presente em todos os níveis
+  _Atomic(NO_SKIP *) retirados;  // Pilha lock-free de nós removidos
+  _Atomic size_t n_retirados;    // Nós na pilha de retirados
+} SKIPLIST;
+
+// Protocolo das Funções
+
+// Auxiliares
+NO_SKIP *ponteiro_skip(uintptr_t p);
+int marcado_skip(uintptr_t p);
+NO_SKIP *criar_no_skip(int chave, int nivel);
+size_t tamanho_no_skip(int nivel);
+void liberar_no_skip(NO_SKIP *no);
+int nivel_aleatorio_skip(void);
+int buscar_no_skip(SKIPLIST *lista, int chave, NO_SKIP **preds,
+                   NO_SKIP **succs);
+void desligar_marcados_skip(SKIPLIST *lista);
+void liberar_nos_skip(SKIPLIST *lista);
+
+// Principais
+SKIPLIST *skiplist_criar(void);
+int skiplist_inserir(SKIPLIST *lista, int chave);
+int skiplist_remover(SKIPLIST *lista, int chave);
+int skiplist_consultar(SKIPLIST *lista, int chave);
+void skiplist_imprimir(SKIPLIST *lista);
+void skiplist_recolher(SKIPLIST *lista);
+size_t skiplist_retirados(SKIPLIST *lista);
+void skiplist_apagar(SKIPLIST **lista);
+int skiplist_construir(SKIPLIST *lista, const int *chaves, size_t n);
+int skiplist_altura(SKIPLIST *lista);
+
+void skiplist_iterador(SKIPLIST *lista, ITERADOR *it);
+int skiplist_iterador_proximo(ITERADOR *it, int *valor);
+int skiplist_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+// Remove a marca de um ponteiro "prox"
+NO_SKIP *ponteiro_skip(uintptr_t p) { return (NO_SKIP *)(p & ~MARCA); }
+
+// Verifica se o ponteiro "prox" está marcado (nó removido)
+int marcado_skip(uintptr_t p) { return (int)(p & MARCA); }
+
+// Bytes ocupados por um nó com `nivel` níveis
+size_t tamanho_no_skip(int nivel) {
+  return sizeof(NO_SKIP) + (size_t)nivel * sizeof(_Atomic uintptr_t);
+}
+
+// Função para criar um novo nó com `nivel` níveis
+NO_SKIP *criar_no_skip(int chave, int nivel) {
+  NO_SKIP *no = (NO_SKIP *)malloc(tamanho_no_skip(nivel));
+  if (no == NULL)
+    return NULL;
+  ESTAT_ALOCAR(tamanho_no_skip(nivel));
+
+  no->chave = chave;
+  no->nivel = nivel;
+  no->retirado = NULL;
+  for (int i = 0; i < nivel; i++)
+    atomic_init(&no->prox[i], (uintptr_t)0);
+  return no;
+}
+
+// Função para liberar um nó
+void liberar_no_skip(NO_SKIP *no) {
+  if (no == NULL)
+    return;
+  ESTAT_LIBERAR(tamanho_no_skip(no->nivel));
+  free(no);
+}
+
+// Sorteia a altura de um novo nó (distribuição geométrica com p = 1/4).
+// Cada thread mantém a sua própria semente, evitando disputa.
+int nivel_aleatorio_skip(void) {
+  static _Thread_local uint32_t estado = 0;
+  if (estado == 0)
+    estado = (uint32_t)(uintptr_t)&estado | 1u;
+
+  // xorshift32
+  estado ^= estado << 13;
+  estado ^= estado >> 17;
+  estado ^= estado << 5;
+
+  int nivel = 1;
+  uint32_t bits = estado;
+  while ((bits & 3u) == 0 && nivel < SKIPLIST_NIVEL_MAX) {
+    nivel++;
+    bits >>= 2;
+  }
+  return nivel;
+}
+
+/*
+    Localiza, em cada nível, o último nó com chave menor que `chave` (preds)
+    e o seu sucessor (succs). No caminho, desliga os nós marcados como
+    removidos; se outra thread alterou o predecessor no meio, recomeça.
+*/
+int buscar_no_skip(SKIPLIST *lista, int chave, NO_SKIP **preds,
+                   NO_SKIP **succs) {
+  int recomecar;
+  do {
+    recomecar = 0;
+    NO_SKIP *pred = lista->cabeca;
+
+    for (int nivel = SKIPLIST_NIVEL_MAX - 1; nivel >= 0 && !recomecar;
+         nivel--) {
+      NO_SKIP *atual = ponteiro_skip(atomic_load(&pred->prox[nivel]));
+
+      while (atual != NULL) {
+        uintptr_t prox = atomic_load(&atual->prox[nivel]);
+
+        if (marcado_skip(prox)) {
+          // Nó removido logicamente: tenta tirá-lo deste nível
+          uintptr_t esperado = (uintptr_t)atual;
+          if (!atomic_compare_exchange_strong(&pred->prox[nivel], &esperado,
+                                              prox & ~MARCA)) {
+            recomecar = 1;
+            break;
+          }
+          atual = ponteiro_skip(prox);
+          continue;
+        }
+
+        ESTAT_VISITAR();
+        if (ESTAT_CMP(atual->chave < chave)) {
+          pred = atual;
+          atual = ponteiro_skip(prox);
+        } else {
+          break;
+        }
+      }
+
+      preds[nivel] = pred;
+      succs[nivel] = atual;
+    }
+  } while (recomecar);
+
+  return succs[0] != NULL && succs[0]->chave == chave;
+}
+
+// Função para criar a skip list
+SKIPLIST *skiplist_criar(void) {
+  SKIPLIST *lista = (SKIPLIST *)malloc(sizeof(SKIPLIST));
+  if (lista == NULL)
+    return NULL;
+
+  lista->cabeca = criar_no_skip(0, SKIPLIST_NIVEL_MAX);
+  if (lista->cabeca == NULL) {
+    free(lista);
+    return NULL;
+  }
+  atomic_init(&lista->retirados, NULL);
+  atomic_init(&lista->n_retirados, 0);
+  return lista;
+}
+
+/*
+    A inserção é linearizada no CAS do nível 0. Os níveis superiores são
+    apenas atalhos e são ligados depois, de baixo para cima; se o nó for
+    removido nesse meio tempo, a ligação é abandonada.
+*/
+int skiplist_inserir(SKIPLIST *lista, int chave) {
+  if (lista == NULL)
+    return 0;
+
+  NO_SKIP *preds[SKIPLIST_NIVEL_MAX];
+  NO_SKIP *succs[SKIPLIST_NIVEL_MAX];
+  NO_SKIP *novo = NULL;
+
+  for (;;) {
+    if (buscar_no_skip(lista, chave, preds, succs)) {
+      liberar_no_skip(novo);
+      return 0; // Chave já existente
+    }
+
+    if (novo == NULL) {
+      novo = criar_no_skip(chave, nivel_aleatorio_skip());
+      if (novo == NULL) {
+        fprintf(stderr, "Erro: Falha na alocação de memória\n");
+        return 0;
+      }
+    }
+
+    for (int i = 0; i < novo->nivel; i++)
+      atomic_store(&novo->prox[i], (uintptr_t)succs[i]);
+
+    uintptr_t esperado = (uintptr_t)succs[0];
+    if (atomic_compare_exchange_strong(&preds[0]->prox[0], &esperado,
+                                       (uintptr_t)novo))
+      break;
+  }
+  ESTAT_ALTURA((uint64_t)novo->nivel);
+
+  for (int nivel = 1; nivel < novo->nivel; nivel++) {
+    for (;;) {
+      uintptr_t atual = atomic_load(&novo->prox[nivel]);
+      if (marcado_skip(atual))
+        return 1; // Removido enquanto era ligado
+
+      // Atualiza o sucessor do novo nó caso a busca tenha mudado
+      if (atual != (uintptr_t)succs[nivel] &&
+          !atomic_compare_exchange_strong(&novo->prox[nivel], &atual,
+                                          (uintptr_t)succs[nivel]))
+        continue;
+
+      uintptr_t esperado = (uintptr_t)succs[nivel];
+      if (atomic_compare_exchange_strong(&preds[nivel]->prox[nivel],
+                                         &esperado, (uintptr_t)novo))
+        break;
+
+      // Predecessor mudou: refaz a busca para este nível
+      buscar_no_skip(lista, chave, preds, succs);
+      if (succs[0] != novo)
+        return 1;
+    }
+  }
+
+  return 1;
+}
+
+/*
+    A remoção marca os ponteiros do nó de cima para baixo. Quem conseguir
+    marcar o nível 0 é o dono da remoção; em seguida uma busca desliga o
+    nó de todos os níveis e ele vai para a pilha de retirados.
+*/
+int skiplist_remover(SKIPLIST *lista, int chave) {
+  if (lista == NULL)
+    return 0;
+
+  NO_SKIP *preds[SKIPLIST_NIVEL_MAX];
+  NO_SKIP *succs[SKIPLIST_NIVEL_MAX];
+
+  if (!buscar_no_skip(lista, chave, preds, succs))
+    return 0;
+
+  NO_SKIP *vitima = succs[0];
+
+  for (int nivel = vitima->nivel - 1; nivel >= 1; nivel--) {
+    uintptr_t prox = atomic_load(&vitima->prox[nivel]);
+    while (!marcado_skip(prox)) {
+      atomic_compare_exchange_strong(&vitima->prox[nivel], &prox,
+                                     prox | MARCA);
+    }
+  }
+
+  uintptr_t prox = atomic_load(&vitima->prox[0]);
+  for (;;) {
+    if (marcado_skip(prox))
+      return 0; // Outra thread removeu primeiro
+
+    if (atomic_compare_exchange_strong(&vitima->prox[0], &prox,
+                                       prox | MARCA)) {
+      buscar_no_skip(lista, chave, preds, succs);
+
+      NO_SKIP *topo = atomic_load(&lista->retirados);
+      do {
+        vitima->retirado = topo;
+      } while (
+          !atomic_compare_exchange_weak(&lista->retirados, &topo, vitima));
+      atomic_fetch_add_explicit(&lista->n_retirados, 1, memory_order_relaxed);
+      return 1;
+    }
+  }
+}
+
+// Busca sem escrita: nós marcados são apenas pulados
+int skiplist_consultar(SKIPLIST *lista, int chave) {
+  if (lista == NULL)
+    return 0;
+
+  NO_SKIP *pred = lista->cabeca;
+  NO_SKIP *atual = NULL;
+
+  for (int nivel = SKIPLIST_NIVEL_MAX - 1; nivel >= 0; nivel--) {
+    atual = ponteiro_skip(atomic_load(&pred->prox[nivel]));
+    while (atual != NULL) {
+      uintptr_t prox = atomic_load(&atual->prox[nivel]);
+      if (marcado_skip(prox)) {
+        atual = ponteiro_skip(prox);
+        continue;
+      }
+      ESTAT_VISITAR();
+      if (ESTAT_CMP(atual->chave < chave)) {
+        pred = atual;
+        atual = ponteiro_skip(prox);
+      } else {
+        break;
+      }
+    }
+  }
+
+  return atual != NULL && atual->chave == chave;
+}
+
+// Função para imprimir a lista (nível 0, em ordem)
+void skiplist_imprimir(SKIPLIST *lista) {
+  if (lista == NULL)
+    return;
+
+  ITERADOR it;
+  int valor, vazio = 1;
+  skiplist_iterador(lista, &it);
+  while (skiplist_iterador_proximo(&it, &valor)) {
+    printf("%d ", valor);
+    vazio = 0;
+  }
+  if (!vazio)
+    printf("\n");
+}
+
+// Tira de todos os níveis os nós marcados que ainda estejam ligados
+// (uma ligação tardia de nível superior pode sobreviver à remoção).
+void desligar_marcados_skip(SKIPLIST *lista) {
+  for (int nivel = 0; nivel < SKIPLIST_NIVEL_MAX; nivel++) {
+    NO_SKIP *pred = lista->cabeca;
+    NO_SKIP *atual = ponteiro_skip(atomic_load(&pred->prox[nivel]));
+    while (atual != NULL) {
+      uintptr_t prox = atomic_load(&atual->prox[nivel]);
+      if (marcado_skip(prox)) {
+        atomic_store(&pred->prox[nivel], prox & ~MARCA);
+      } else {
+        pred = atual;
+      }
+      atual = ponteiro_skip(prox);
+    }
+  }
+}
+
+// Libera os nós retirados (exige que nenhuma outra thread esteja ativa)
+void skiplist_recolher(SKIPLIST *lista) {
+  if (lista == NULL)
+    return;
+
+  desligar_marcados_skip(lista);
+
+  NO_SKIP *no = atomic_exchange(&lista->retirados, NULL);
+  atomic_store_explicit(&lista->n_retirados, 0, memory_order_relaxed);
+  while (no != NULL) {
+    NO_SKIP *prox = no->retirado;
+    liberar_no_skip(no);
+    no = prox;
+  }
+}
+
+// Nós removidos que ainda esperam por skiplist_recolher()
+size_t skiplist_retirados(SKIPLIST *lista) {
+  if (lista == NULL)
+    return 0;
+  return atomic_load_explicit(&lista->n_retirados, memory_order_relaxed);
+}
+
+// Libera todos os nós (vivos e retirados), deixando a lista vazia
+void liberar_nos_skip(SKIPLIST *lista) {
+  skiplist_recolher(lista);
+
+  NO_SKIP *no = ponteiro_skip(atomic_load(&lista->cabeca->prox[0]));
+  while (no != NULL) {
+    NO_SKIP *prox = ponteiro_skip(atomic_load(&no->prox[0]));
+    liberar_no_skip(no);
+    no = prox;
+  }
+
+  for (int i = 0; i < SKIPLIST_NIVEL_MAX; i++)
+    atomic_store(&lista->cabeca->prox[i], (uintptr_t)0);
+}
+
+// Função para liberar a skip list
+void skiplist_apagar(SKIPLIST **lista) {
+  if (lista == NULL || *lista == NULL)
+    return;
+
+  liberar_nos_skip(*lista);
+  liberar_no_skip((*lista)->cabeca);
+  free(*lista);
+  *lista = NULL;
+}
+
+// Iterador: `atual` guarda o último nó visitado (começa na cabeça)
+void skiplist_iterador(SKIPLIST *lista, ITERADOR *it) {
+  iterador_iniciar(it, lista);
+  it->atual = lista ? lista->cabeca : NULL;
+}
+
+int skiplist_iterador_proximo(ITERADOR *it, int *valor) {
+  NO_SKIP *no = (NO_SKIP *)it->atual;
+  if (no == NULL)
+    return 0;
+
+  NO_SKIP *prox = ponteiro_skip(atomic_load(&no->prox[0]));
+  while (prox != NULL && marcado_skip(atomic_load(&prox->prox[0])))
+    prox = ponteiro_skip(atomic_load(&prox->prox[0]));
+
+  if (prox == NULL)
+    return 0;
+
+  it->atual = prox;
+  *valor = prox->chave;
+  return 1;
+}
+
+int skiplist_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  SKIPLIST *lista = (SKIPLIST *)it->estrutura;
+  NO_SKIP *no = (NO_SKIP *)it->atual;
+  if (lista == NULL || no == NULL)
+    return 0;
+
+  // O próximo da posição atual pode já servir
+  NO_SKIP *prox = ponteiro_skip(atomic_load(&no->prox[0]));
+  if (prox == NULL || prox->chave >= alvo)
+    return skiplist_iterador_proximo(it, valor);
+
+  // Caso contrário, desce pelos níveis a partir da cabeça
+  NO_SKIP *pred = lista->cabeca;
+  for (int nivel = SKIPLIST_NIVEL_MAX - 1; nivel >= 0; nivel--) {
+    NO_SKIP *atual = ponteiro_skip(atomic_load(&pred->prox[nivel]));
+    while (atual != NULL) {
+      uintptr_t p = atomic_load(&atual->prox[nivel]);
+      if (marcado_skip(p)) {
+        atual = ponteiro_skip(p);
+        continue;
+      }
+      if (atual->chave < alvo) {
+        pred = atual;
+        atual = ponteiro_skip(p);
+      } else {
+        break;
+      }
+    }
+  }
+
+  it->atual = pred;
+  return skiplist_iterador_proximo(it, valor);
+}
+
+/*
+    Construção em lote a partir de chaves ordenadas: cada nó novo é ligado
+    ao final de cada um dos seus níveis, guardando o último nó de cada
+    nível. Não há disputa, então nenhum CAS é necessário.
+*/
+int skiplist_construir(SKIPLIST *lista, const int *chaves, size_t n) {
+  if (lista == NULL)
+    return -1;
+
+  liberar_nos_skip(lista);
+
+  NO_SKIP *ultimo[SKIPLIST_NIVEL_MAX];
+  for (int i = 0; i < SKIPLIST_NIVEL_MAX; i++)
+    ultimo[i] = lista->cabeca;
+
+  for (size_t k = 0; k < n; k++) {
+    NO_SKIP *novo = criar_no_skip(chaves[k], nivel_aleatorio_skip());
+    if (novo == NULL) {
+      liberar_nos_skip(lista);
+      return 0;
+    }
+    for (int i = 0; i < novo->nivel; i++) {
+      atomic_store(&ultimo[i]->prox[i], (uintptr_t)novo);
+      ultimo[i] = novo;
+    }
+  }
+  return 1;
+}
+
+// Quantidade de níveis em uso (o mais alto com algum nó ligado)
+int skiplist_altura(SKIPLIST *lista) {
+  if (lista == NULL)
+    return 0;
+  int nivel = SKIPLIST_NIVEL_MAX;
+  while (nivel > 0 &&
+         ponteiro_skip(atomic_load(&lista->cabeca->prox[nivel - 1])) == NULL)
+    nivel--;
+  return nivel;
+}
@@ -0,0 +1,156 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../set/iterador.h"
+
+// Estrutura do nó da skip list.
+typedef struct no_skip NO_SKIP;
+
+// Estrutura da skip list (cabeça sentinela e nós retirados).
+typedef struct skiplist SKIPLIST;
+
+/**
+ * @brief Cria uma nova skip list vazia.
+ *
+ * A skip list é livre de travas (lock-free): inserção, remoção e busca podem
+ * ser chamadas por várias threads ao mesmo tempo sobre a mesma lista.
+ *
+ * @return SKIPLIST* Ponteiro para a nova skip list, ou NULL em caso de erro na
+ * alocação.
+ */
+SKIPLIST *skiplist_criar(void);
+
+/**
+ * @brief Insere uma chave na skip list.
+ *
+ * Seguro para uso concorrente com as demais operações.
+ *
+ * @param lista Ponteiro para a skip list.
+ * @param chave Valor inteiro a ser inserido.
+ * @return int Retorna 1 se a inserção foi bem-sucedida, ou 0 se a chave já
+ * existir ou em caso de falha.
+ */
+int skiplist_inserir(SKIPLIST *lista, int chave);
+
+/**
+ * @brief Remove uma chave da skip list, se existir.
+ *
+ * O nó é marcado logicamente, desligado de todos os níveis e guardado na
+ * lista de retirados, pois outras threads ainda podem estar lendo-o. A
+ * memória só é devolvida em skiplist_recolher() ou skiplist_apagar(): sem
+ * recolhas periódicas, inserções e remoções alternadas fazem a memória
+ * crescer sem limite.
+ *
+ * @param lista Ponteiro para a skip list.
+ * @param chave Valor inteiro a ser removido.
+ * @return int Retorna 1 se a remoção foi bem-sucedida, ou 0 se a chave não foi
+ * encontrada.
+ */
+int skiplist_remover(SKIPLIST *lista, int chave);
+
+/**
+ * @brief Verifica a existência de uma chave na skip list.
+ *
+ * A busca não escreve na estrutura (wait-free).
+ *
+ * @param lista Ponteiro para a skip list.
+ * @param chave Valor inteiro da chave a ser consultada.
+ * @return int Retorna 1 se a chave estiver presente, ou 0 caso contrário.
+ */
+int skiplist_consultar(SKIPLIST *lista, int chave);
+
+/**
+ * @brief Imprime todos os elementos da skip list em ordem crescente.
+ *
+ * @param lista Ponteiro para a skip list.
+ */
+void skiplist_imprimir(SKIPLIST *lista);
+
+/**
+ * @brief Libera a memória dos nós retirados por remoções anteriores.
+ *
+ * Só pode ser chamada quando nenhuma outra thread estiver operando sobre a
+ * lista (ponto de quiescência).
+ *
+ * @param lista Ponteiro para a skip list.
+ */
+void skiplist_recolher(SKIPLIST *lista);
+
+/**
+ * @brief Conta os nós removidos que ainda não foram liberados.
+ *
+ * Serve para decidir quando vale a pena chamar skiplist_recolher(), que
+ * percorre a lista inteira.
+ *
+ * @param lista Ponteiro para a skip list.
+ * @return size_t Quantidade de nós retirados (0 se a lista for inválida).
+ */
+size_t skiplist_retirados(SKIPLIST *lista);
+
+/**
+ * @brief Apaga a skip list, liberando toda a memória alocada.
+ *
+ * @param lista Endereço do ponteiro para a skip list. Após a execução, o
+ * ponteiro será definido como NULL.
+ */
+void skiplist_apagar(SKIPLIST **lista);
+
+/**
+ * @brief Prepara um iterador em ordem crescente sobre a skip list.
+ *
+ * O percurso é fracamente consistente: chaves inseridas ou removidas durante
+ * a iteração podem ou não ser vistas.
+ *
+ * @param lista Ponteiro para a skip list.
+ * @param it Iterador a ser preparado.
+ */
+void skiplist_iterador(SKIPLIST *lista, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por skiplist_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 ao final do percurso.
+ */
+int skiplist_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * Usa os níveis superiores da lista, em O(log(n)) esperado.
+ *
+ * @param it Iterador preparado por skiplist_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 se não houver chave
+ * maior ou igual a `alvo`.
+ */
+int skiplist_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Constrói a skip list a partir de chaves ordenadas e sem repetição.
+ *
+ * Liga os nós em O(n), substituindo o conteúdo anterior. Não pode ser chamada
+ * enquanto outras threads operam sobre a lista.
+ *
+ * @param lista Ponteiro para a skip list.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @return int Retorna 1 se a construção foi bem-sucedida, 0 em caso de falha
+ * de alocação (a lista fica vazia), ou -1 se a lista for inválida.
+ */
+int skiplist_construir(SKIPLIST *lista, const int *chaves, size_t n);
+
+/**
+ * @brief Retorna a quantidade de níveis em uso na skip list.
+ *
+ * @param lista Ponteiro para a skip list.
+ * @return int Nível mais alto com algum nó ligado (0 se vazia).
+ */
+int skiplist_altura(SKIPLIST *lista);
+
+#endif // SKIPLIST_H
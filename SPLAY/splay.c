@@ -0,0 +1,402 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "splay.h"
+#include "../set/estatisticas.h"
+
+typedef struct no_splay {
+  struct no_splay *esq;
+  struct no_splay *dir;
+  int chave;
+} NO_SPLAY;
+
+typedef struct splay {
+  NO_SPLAY *raiz;
+  int ajustar; // Consultas fazem splay (ver splay_autoajuste())
+} SPLAY;
+
+// Nó pendente da medição de altura
+typedef struct altura_splay {
+  NO_SPLAY *no;
+  int profundidade;
+} ALTURA_SPLAY;
+
+// Protocolo das Funções
+
+// Auxiliares
+NO_SPLAY *criar_no_splay(int chave);
+NO_SPLAY *no_splay(NO_SPLAY *t, int chave);
+void no_apagar_splay(NO_SPLAY *no);
+void no_empilhar_esquerda_splay(ITERADOR *it, NO_SPLAY *no);
+NO_SPLAY *no_construir_splay(const int *chaves, size_t n, int *falha);
+
+// Principais
+SPLAY *splay_criar(void);
+int splay_autoajuste(SPLAY *T, int ligar);
+int splay_inserir(SPLAY *T, int chave);
+int splay_remover(SPLAY *T, int chave);
+int splay_buscar(SPLAY *T, int chave);
+void splay_apagar(SPLAY **T);
+
+void splay_iterador(SPLAY *T, ITERADOR *it);
+int splay_iterador_proximo(ITERADOR *it, int *valor);
+int splay_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+int splay_construir(SPLAY *T, const int *chaves, size_t n, int threads);
+int splay_altura(SPLAY *T);
+
+int splay_dividir(SPLAY *T, int chave, SPLAY *menores, SPLAY *maiores);
+int splay_juntar(SPLAY *A, SPLAY *B);
+int splay_extremos(SPLAY *T, int *menor, int *maior);
+
+SPLAY *splay_criar(void) {
+  SPLAY *T = (SPLAY *)malloc(sizeof(SPLAY));
+  if (T != NULL) {
+    T->raiz = NULL;
+    T->ajustar = 1;
+  }
+  return T;
+}
+
+int splay_autoajuste(SPLAY *T, int ligar) {
+  if (T == NULL)
+    return -1;
+  T->ajustar = ligar != 0;
+  return 1;
+}
+
+NO_SPLAY *criar_no_splay(int chave) {
+  NO_SPLAY *no = (NO_SPLAY *)malloc(sizeof(NO_SPLAY));
+  if (no == NULL)
+    return NULL;
+  ESTAT_ALOCAR(sizeof(NO_SPLAY));
+  no->esq = no->dir = NULL;
+  no->chave = chave;
+  return no;
+}
+
+/*
+    Splay descendente: desce uma vez, pendurando o que fica à esquerda da
+    chave numa árvore L e o que fica à direita numa árvore R (pelos
+    ponteiros `l` e `r`, sob o nó falso `cabeca`), com uma rotação a cada
+    dois passos na mesma direção (zig-zig). No fim o nó alcançado vira a
+    raiz, com L e R como subárvores. Sem recursão e sem ponteiro para o
+    pai.
+*/
+NO_SPLAY *no_splay(NO_SPLAY *t, int chave) {
+  if (t == NULL)
+    return NULL;
+
+  NO_SPLAY cabeca = {NULL, NULL, 0};
+  NO_SPLAY *l = &cabeca, *r = &cabeca, *y;
+  for (;;) {
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(chave < t->chave)) {
+      if (t->esq == NULL)
+        break;
+      if (ESTAT_CMP(chave < t->esq->chave)) {
+        y = t->esq;
+        t->esq = y->dir;
+        y->dir = t;
+        t = y;
+        ESTAT_CONTAR(rotacoes_simples, 1);
+        if (t->esq == NULL)
+          break;
+      }
+      r->esq = t;
+      r = t;
+      t = t->esq;
+    } else if (ESTAT_CMP(chave > t->chave)) {
+      if (t->dir == NULL)
+        break;
+      if (ESTAT_CMP(chave > t->dir->chave)) {
+        y = t->dir;
+        t->dir = y->esq;
+        y->esq = t;
+        t = y;
+        ESTAT_CONTAR(rotacoes_simples, 1);
+        if (t->dir == NULL)
+          break;
+      }
+      l->dir = t;
+      l = t;
+      t = t->dir;
+    } else {
+      break;
+    }
+  }
+  l->dir = t->esq;
+  r->esq = t->dir;
+  t->esq = cabeca.dir;
+  t->dir = cabeca.esq;
+  return t;
+}
+
+int splay_inserir(SPLAY *T, int chave) {
+  if (T == NULL)
+    return -1;
+
+  if (T->raiz != NULL) {
+    T->raiz = no_splay(T->raiz, chave);
+    if (T->raiz->chave == chave)
+      return 0;
+  }
+  NO_SPLAY *novo = criar_no_splay(chave);
+  if (novo == NULL)
+    return 0;
+
+  // A raiz atual é vizinha da chave: parte-se a árvore nela
+  NO_SPLAY *raiz = T->raiz;
+  if (raiz != NULL && chave < raiz->chave) {
+    novo->esq = raiz->esq;
+    novo->dir = raiz;
+    raiz->esq = NULL;
+  } else if (raiz != NULL) {
+    novo->dir = raiz->dir;
+    novo->esq = raiz;
+    raiz->dir = NULL;
+  }
+  T->raiz = novo;
+  return 1;
+}
+
+int splay_remover(SPLAY *T, int chave) {
+  if (T == NULL || T->raiz == NULL)
+    return 0;
+
+  NO_SPLAY *raiz = no_splay(T->raiz, chave);
+  if (raiz->chave != chave) {
+    T->raiz = raiz;
+    return 0;
+  }
+  if (raiz->esq == NULL) {
+    T->raiz = raiz->dir;
+  } else {
+    // Todas as chaves da esquerda são menores: o splay traz a maior delas,
+    // que fica sem filho direito
+    T->raiz = no_splay(raiz->esq, chave);
+    T->raiz->dir = raiz->dir;
+  }
+  free(raiz);
+  ESTAT_LIBERAR(sizeof(NO_SPLAY));
+  return 1;
+}
+
+int splay_buscar(SPLAY *T, int chave) {
+  if (T == NULL || T->raiz == NULL)
+    return 0;
+
+  if (T->ajustar) {
+    T->raiz = no_splay(T->raiz, chave);
+    return T->raiz->chave == chave;
+  }
+  NO_SPLAY *no = T->raiz;
+  while (no != NULL) {
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(no->chave == chave))
+      return 1;
+    no = ESTAT_CMP(chave < no->chave) ? no->esq : no->dir;
+  }
+  return 0;
+}
+
+// Libera sem recursão: rotaciona à direita até a raiz não ter filho
+// esquerdo, então ela sai e o filho direito assume
+void no_apagar_splay(NO_SPLAY *no) {
+  while (no != NULL) {
+    if (no->esq != NULL) {
+      NO_SPLAY *esq = no->esq;
+      no->esq = esq->dir;
+      esq->dir = no;
+      no = esq;
+    } else {
+      NO_SPLAY *dir = no->dir;
+      free(no);
+      ESTAT_LIBERAR(sizeof(NO_SPLAY));
+      no = dir;
+    }
+  }
+}
+
+void splay_apagar(SPLAY **T) {
+  if (T != NULL && *T != NULL) {
+    no_apagar_splay((*T)->raiz);
+    free(*T);
+    *T = NULL;
+  }
+}
+
+// Empilha o nó e todo o seu caminho mais à esquerda
+void no_empilhar_esquerda_splay(ITERADOR *it, NO_SPLAY *no) {
+  while (no != NULL) {
+    iterador_empilhar(it, no);
+    no = no->esq;
+  }
+}
+
+// Mesmo percurso de avl_iterador(); a pilha cresce no heap se a árvore
+// estiver funda
+void splay_iterador(SPLAY *T, ITERADOR *it) {
+  iterador_iniciar(it, T);
+  if (T != NULL)
+    no_empilhar_esquerda_splay(it, T->raiz);
+}
+
+int splay_iterador_proximo(ITERADOR *it, int *valor) {
+  NO_SPLAY *no = (NO_SPLAY *)iterador_desempilhar(it);
+  if (no == NULL)
+    return 0;
+
+  *valor = no->chave;
+  no_empilhar_esquerda_splay(it, no->dir);
+  return 1;
+}
+
+int splay_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  while (it->topo > 0) {
+    NO_SPLAY *topo = (NO_SPLAY *)iterador_topo(it);
+    if (topo->chave >= alvo)
+      return splay_iterador_proximo(it, valor);
+
+    iterador_desempilhar(it);
+
+    // Próximo pendente ainda menor: a subárvore direita do topo também é
+    NO_SPLAY *abaixo = (NO_SPLAY *)iterador_topo(it);
+    if (abaixo != NULL && abaixo->chave < alvo)
+      continue;
+
+    NO_SPLAY *no = topo->dir;
+    while (no != NULL) {
+      if (no->chave >= alvo) {
+        iterador_empilhar(it, no);
+        no = no->esq;
+      } else {
+        no = no->dir;
+      }
+    }
+  }
+  return 0;
+}
+
+// Elemento do meio na raiz, como em no_construir_avl()
+NO_SPLAY *no_construir_splay(const int *chaves, size_t n, int *falha) {
+  if (n == 0)
+    return NULL;
+
+  size_t meio = n / 2;
+  NO_SPLAY *raiz = criar_no_splay(chaves[meio]);
+  if (raiz == NULL) {
+    *falha = 1;
+    return NULL;
+  }
+  raiz->esq = no_construir_splay(chaves, meio, falha);
+  raiz->dir = no_construir_splay(chaves + meio + 1, n - meio - 1, falha);
+  return raiz;
+}
+
+int splay_construir(SPLAY *T, const int *chaves, size_t n, int threads) {
+  (void)threads;
+  if (T == NULL)
+    return -1;
+
+  no_apagar_splay(T->raiz);
+  T->raiz = NULL;
+
+  int falha = 0;
+  NO_SPLAY *raiz = no_construir_splay(chaves, n, &falha);
+  if (falha) {
+    no_apagar_splay(raiz);
+    return 0;
+  }
+  T->raiz = raiz;
+  return 1;
+}
+
+// Busca em profundidade com pilha explícita: a árvore pode ser um caminho
+int splay_altura(SPLAY *T) {
+  if (T == NULL || T->raiz == NULL)
+    return 0;
+
+  size_t capacidade = 64, topo = 0;
+  ALTURA_SPLAY *pilha = (ALTURA_SPLAY *)malloc(capacidade * sizeof(*pilha));
+  if (pilha == NULL)
+    return 0;
+
+  int altura = 0;
+  pilha[topo++] = (ALTURA_SPLAY){T->raiz, 1};
+  while (topo > 0) {
+    ALTURA_SPLAY a = pilha[--topo];
+    if (a.profundidade > altura)
+      altura = a.profundidade;
+    if (topo + 2 > capacidade) {
+      ALTURA_SPLAY *p =
+          (ALTURA_SPLAY *)realloc(pilha, 2 * capacidade * sizeof(*pilha));
+      if (p == NULL) {
+        free(pilha);
+        return 0;
+      }
+      pilha = p;
+      capacidade *= 2;
+    }
+    if (a.no->esq != NULL)
+      pilha[topo++] = (ALTURA_SPLAY){a.no->esq, a.profundidade + 1};
+    if (a.no->dir != NULL)
+      pilha[topo++] = (ALTURA_SPLAY){a.no->dir, a.profundidade + 1};
+  }
+  free(pilha);
+  return altura;
+}
+
+int splay_dividir(SPLAY *T, int chave, SPLAY *menores, SPLAY *maiores) {
+  if (T == NULL || menores == NULL || maiores == NULL)
+    return -1;
+
+  no_apagar_splay(menores->raiz);
+  no_apagar_splay(maiores->raiz);
+  menores->raiz = maiores->raiz = NULL;
+
+  NO_SPLAY *raiz = no_splay(T->raiz, chave);
+  T->raiz = NULL;
+  if (raiz == NULL)
+    return 1;
+  // A raiz é a chave ou uma vizinha dela: um dos lados sai inteiro
+  if (raiz->chave < chave) {
+    maiores->raiz = raiz->dir;
+    raiz->dir = NULL;
+    menores->raiz = raiz;
+  } else {
+    menores->raiz = raiz->esq;
+    raiz->esq = NULL;
+    maiores->raiz = raiz;
+  }
+  return 1;
+}
+
+int splay_juntar(SPLAY *A, SPLAY *B) {
+  if (A == NULL || B == NULL)
+    return -1;
+  if (A->raiz == NULL) {
+    A->raiz = B->raiz;
+  } else if (B->raiz != NULL) {
+    // O splay por INT_MAX traz a maior chave de A, sem filho direito
+    A->raiz = no_splay(A->raiz, INT_MAX);
+    A->raiz->dir = B->raiz;
+  }
+  B->raiz = NULL;
+  return 1;
+}
+
+int splay_extremos(SPLAY *T, int *menor, int *maior) {
+  if (T == NULL || T->raiz == NULL)
+    return 0;
+
+  NO_SPLAY *no = T->raiz;
+  while (no->esq != NULL)
+    no = no->esq;
+  *menor = no->chave;
+  for (no = T->raiz; no->dir != NULL; no = no->dir)
+    ;
+  *maior = no->chave;
+  return 1;
+}
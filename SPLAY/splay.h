@@ -0,0 +1,178 @@
+#ifndef SPLAY_H
+#define SPLAY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../set/iterador.h"
+
+/*
+    Árvore splay (Sleator e Tarjan), com o splay descendente: cada acesso
+    traz a chave acessada (ou a última visitada) para a raiz, de modo que
+    chaves muito consultadas ficam perto do topo e custam menos que
+    log2(n) passos. O custo amortizado de qualquer sequência é O(log(n))
+    por operação, e em acessos desiguais (Zipf) fica perto da entropia da
+    distribuição. Sem garantia de altura: percursos e liberação são
+    iterativos.
+*/
+
+// Estrutura do nó da árvore splay.
+typedef struct no_splay NO_SPLAY;
+
+// Árvore: raiz e modo de consulta.
+typedef struct splay SPLAY;
+
+/**
+ * @brief Cria uma árvore splay vazia, com o autoajuste ligado.
+ *
+ * @return SPLAY* Ponteiro para a árvore, ou NULL em caso de erro na alocação.
+ */
+SPLAY *splay_criar(void);
+
+/**
+ * @brief Liga ou desliga o autoajuste das consultas.
+ *
+ * Com o autoajuste ligado, splay_buscar() reorganiza a árvore e não pode
+ * rodar ao mesmo tempo que nenhuma outra operação, nem outra consulta.
+ * Desligado, a consulta é uma busca comum, sem escrita, e várias threads
+ * podem consultar juntas. Inserção e remoção sempre reorganizam.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param ligar 1 para ligar, 0 para desligar.
+ * @return int Retorna 1, ou -1 se a árvore for inválida.
+ */
+int splay_autoajuste(SPLAY *T, int ligar);
+
+/**
+ * @brief Insere uma chave; ela passa a ser a raiz.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chave Chave a ser inserida.
+ * @return int Retorna 1 se inseriu, 0 se a chave já existia (ou faltou
+ * memória), ou -1 se a árvore for inválida.
+ */
+int splay_inserir(SPLAY *T, int chave);
+
+/**
+ * @brief Remove uma chave.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chave Chave a ser removida.
+ * @return int Retorna 1 se removeu, ou 0 se a chave não foi encontrada.
+ */
+int splay_remover(SPLAY *T, int chave);
+
+/**
+ * @brief Verifica a existência de uma chave.
+ *
+ * Com o autoajuste ligado a chave (ou a última visitada) sobe para a raiz;
+ * ver splay_autoajuste().
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chave Chave a ser consultada.
+ * @return int Retorna 1 se a chave estiver presente, ou 0 caso contrário.
+ */
+int splay_buscar(SPLAY *T, int chave);
+
+/**
+ * @brief Apaga a árvore, liberando toda a memória alocada.
+ *
+ * @param T Endereço do ponteiro para a árvore. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void splay_apagar(SPLAY **T);
+
+/**
+ * @brief Prepara um iterador em ordem crescente sobre a árvore.
+ *
+ * O iterador não reorganiza a árvore, mas deixa de ser válido se ela for
+ * reorganizada (inclusive por uma consulta com autoajuste).
+ *
+ * @param T Ponteiro para a árvore.
+ * @param it Iterador a ser preparado.
+ */
+void splay_iterador(SPLAY *T, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por splay_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 ao final do percurso.
+ */
+int splay_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * Como avl_iterador_buscar(), em tempo proporcional à profundidade.
+ *
+ * @param it Iterador preparado por splay_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 se não houver chave
+ * maior ou igual a `alvo`.
+ */
+int splay_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Substitui o conteúdo por chaves ordenadas e sem repetição.
+ *
+ * A árvore sai perfeitamente balanceada, em O(n); os acessos seguintes é
+ * que a adaptam.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @param threads Ignorado: a construção é uma passada linear.
+ * @return int Retorna 1 se bem-sucedida, 0 em caso de falha de alocação (a
+ * árvore fica vazia), ou -1 se a árvore for inválida.
+ */
+int splay_construir(SPLAY *T, const int *chaves, size_t n, int threads);
+
+/**
+ * @brief Retorna a altura da árvore, em O(n).
+ *
+ * @param T Ponteiro para a árvore.
+ * @return int Altura (0 se vazia ou se faltar memória para medir).
+ */
+int splay_altura(SPLAY *T);
+
+/**
+ * @brief Divide a árvore pela chave, em O(log(n)) amortizado.
+ *
+ * Um splay pela chave deixa cada lado inteiro em uma subárvore da raiz.
+ *
+ * @param T Ponteiro para a árvore; fica vazia.
+ * @param chave Chave de corte.
+ * @param menores Recebe as chaves < chave (conteúdo anterior é apagado).
+ * @param maiores Recebe as chaves >= chave (conteúdo anterior é apagado).
+ * @return int Retorna 1 se bem-sucedida, ou -1 se algum ponteiro for
+ * inválido.
+ */
+int splay_dividir(SPLAY *T, int chave, SPLAY *menores, SPLAY *maiores);
+
+/**
+ * @brief Move todas as chaves de B para o fim de A, em O(log(n)) amortizado.
+ *
+ * Todas as chaves de A devem ser menores que as de B (não é verificado).
+ * A maior chave de A sobe para a raiz e B vira a sua subárvore direita, sem
+ * alocar nada.
+ *
+ * @param A Ponteiro para a árvore que recebe as chaves.
+ * @param B Ponteiro para a árvore de chaves maiores; fica vazia.
+ * @return int Retorna 1, ou -1 se algum ponteiro for inválido.
+ */
+int splay_juntar(SPLAY *A, SPLAY *B);
+
+/**
+ * @brief Obtém a menor e a maior chave, sem reorganizar a árvore.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param menor Recebe a menor chave.
+ * @param maior Recebe a maior chave.
+ * @return int Retorna 1 se a árvore tem chaves, ou 0 se estiver vazia.
+ */
+int splay_extremos(SPLAY *T, int *menor, int *maior);
+
+#endif // SPLAY_H
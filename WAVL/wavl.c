@@ -0,0 +1,581 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "wavl.h"
+#include "../set/estatisticas.h"
+#include "../set/executor.h"
+
+// Abaixo desse tamanho a subárvore é construída na própria thread
+#define CONSTRUCAO_MIN_PARALELO_WAVL 16384
+
+/*
+    O posto substitui a altura da AVL. Nós ausentes têm posto -1 e a
+    diferença de posto entre pai e filho é 1 ou 2; uma folha tem posto 0.
+    Inserção sem remoções mantém posto = altura - 1 (a árvore é uma AVL).
+*/
+typedef struct no_wavl {
+  struct no_wavl *esq;
+  struct no_wavl *dir;
+  int chave;
+  int posto;
+} NO_WAVL;
+
+// Metade de uma construção em lote entregue ao grupo de threads
+typedef struct construcao_wavl {
+  const int *chaves;
+  size_t n;
+  int threads;
+  int falha;
+  NO_WAVL *raiz;
+  ESTATISTICAS *estat; // Contadores da thread que criou a tarefa
+  TAREFA tarefa;
+} CONSTRUCAO_WAVL;
+
+// Protocolo das Funções
+
+// Auxiliares
+int posto_wavl(NO_WAVL *no);
+NO_WAVL *criar_no_wavl(int chave);
+
+NO_WAVL *rotacionar_direita_wavl(NO_WAVL *no);
+NO_WAVL *rotacionar_esquerda_wavl(NO_WAVL *no);
+
+NO_WAVL *balancear_insercao_wavl(NO_WAVL *no);
+NO_WAVL *balancear_remocao_wavl(NO_WAVL *no);
+
+NO_WAVL *no_inserir_wavl(NO_WAVL *no, int chave, int *resp);
+NO_WAVL *no_remover_wavl(NO_WAVL *no, int chave, int *resp);
+NO_WAVL *no_buscar_wavl(NO_WAVL *no, int chave);
+void no_apagar_wavl(NO_WAVL *no);
+int no_altura_wavl(NO_WAVL *no);
+
+void no_empilhar_esquerda_wavl(ITERADOR *it, NO_WAVL *no);
+
+NO_WAVL *no_construir_wavl(const int *chaves, size_t n, int threads,
+                           int *falha);
+void construir_wavl_tarefa(void *arg);
+
+NO_WAVL *no_juntar_wavl(NO_WAVL *menores, NO_WAVL *meio, NO_WAVL *maiores);
+void no_dividir_wavl(NO_WAVL *no, int chave, NO_WAVL **menores,
+                     NO_WAVL **maiores);
+
+// Principais
+WAVL *wavl_criar(void);
+int wavl_inserir(WAVL *T, int chave);
+int wavl_remover(WAVL *T, int chave);
+int wavl_buscar(WAVL *T, int chave);
+void wavl_apagar(WAVL **T);
+
+void wavl_iterador(WAVL *T, ITERADOR *it);
+int wavl_iterador_proximo(ITERADOR *it, int *valor);
+int wavl_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+int wavl_construir(WAVL *T, const int *chaves, size_t n, int threads);
+int wavl_altura(WAVL *T);
+
+int wavl_dividir(WAVL *T, int chave, WAVL *menores, WAVL *maiores);
+int wavl_juntar(WAVL *A, WAVL *B);
+int wavl_extremos(WAVL *T, int *menor, int *maior);
+
+WAVL *wavl_criar(void) {
+  WAVL *T = (WAVL *)malloc(sizeof(WAVL));
+  if (T != NULL)
+    *T = NULL;
+  return T;
+}
+
+int posto_wavl(NO_WAVL *no) { return no ? no->posto : -1; }
+
+NO_WAVL *criar_no_wavl(int chave) {
+  NO_WAVL *no = (NO_WAVL *)malloc(sizeof(NO_WAVL));
+  if (no == NULL)
+    return NULL;
+  ESTAT_ALOCAR(sizeof(NO_WAVL));
+  no->esq = no->dir = NULL;
+  no->chave = chave;
+  no->posto = 0;
+  return no;
+}
+
+// Rotações sem ajuste de posto: quem rotaciona sabe os postos novos
+NO_WAVL *rotacionar_direita_wavl(NO_WAVL *no) {
+  NO_WAVL *nova = no->esq;
+  no->esq = nova->dir;
+  nova->dir = no;
+  return nova;
+}
+
+NO_WAVL *rotacionar_esquerda_wavl(NO_WAVL *no) {
+  NO_WAVL *nova = no->dir;
+  no->dir = nova->esq;
+  nova->esq = no;
+  return nova;
+}
+
+/*
+    Depois de uma inserção abaixo de `no`, um filho pode ter ficado com o
+    mesmo posto dele (diferença 0). Se o outro filho está a 1, basta
+    promover `no` e o problema sobe um nível; se está a 2, uma rotação
+    simples (o filho é pesado para fora) ou dupla (pesado para dentro)
+    resolve de vez, sem mudar o posto da subárvore.
+*/
+NO_WAVL *balancear_insercao_wavl(NO_WAVL *no) {
+  int r = no->posto;
+
+  if (posto_wavl(no->esq) == r) {
+    NO_WAVL *x = no->esq;
+    if (r - posto_wavl(no->dir) == 1) {
+      no->posto++;
+      ESTAT_CONTAR(mudancas_posto, 1);
+      return no;
+    }
+    no->posto--;
+    if (x->posto - posto_wavl(x->esq) == 1) {
+      ESTAT_CONTAR(rotacoes_simples, 1);
+      ESTAT_CONTAR(mudancas_posto, 1);
+      return rotacionar_direita_wavl(no);
+    }
+    NO_WAVL *y = x->dir;
+    no->esq = rotacionar_esquerda_wavl(x);
+    x->posto--;
+    y->posto++;
+    ESTAT_CONTAR(rotacoes_duplas, 1);
+    ESTAT_CONTAR(mudancas_posto, 3);
+    return rotacionar_direita_wavl(no);
+  }
+
+  if (posto_wavl(no->dir) == r) {
+    NO_WAVL *x = no->dir;
+    if (r - posto_wavl(no->esq) == 1) {
+      no->posto++;
+      ESTAT_CONTAR(mudancas_posto, 1);
+      return no;
+    }
+    no->posto--;
+    if (x->posto - posto_wavl(x->dir) == 1) {
+      ESTAT_CONTAR(rotacoes_simples, 1);
+      ESTAT_CONTAR(mudancas_posto, 1);
+      return rotacionar_esquerda_wavl(no);
+    }
+    NO_WAVL *y = x->esq;
+    no->dir = rotacionar_direita_wavl(x);
+    x->posto--;
+    y->posto++;
+    ESTAT_CONTAR(rotacoes_duplas, 1);
+    ESTAT_CONTAR(mudancas_posto, 3);
+    return rotacionar_esquerda_wavl(no);
+  }
+
+  return no;
+}
+
+/*
+    Depois de uma remoção abaixo de `no`, ele pode ter virado uma folha de
+    posto 1 (rebaixada para 0) ou ter um filho a diferença 3. Neste caso,
+    se o irmão está a 2, ou está a 1 mas com os dois filhos a 2, rebaixa-se
+    `no` (e o irmão) e o problema sobe. Senão uma rotação simples ou dupla
+    termina o rebalanceamento.
+*/
+NO_WAVL *balancear_remocao_wavl(NO_WAVL *no) {
+  int r = no->posto;
+
+  if (no->esq == NULL && no->dir == NULL) {
+    if (r > 0) {
+      no->posto = 0;
+      ESTAT_CONTAR(mudancas_posto, 1);
+    }
+    return no;
+  }
+
+  if (r - posto_wavl(no->esq) == 3) {
+    NO_WAVL *y = no->dir;
+    if (r - y->posto == 2) {
+      no->posto--;
+      ESTAT_CONTAR(mudancas_posto, 1);
+      return no;
+    }
+    int de = y->posto - posto_wavl(y->esq), dd = y->posto - posto_wavl(y->dir);
+    if (de == 2 && dd == 2) {
+      no->posto--;
+      y->posto--;
+      ESTAT_CONTAR(mudancas_posto, 2);
+      return no;
+    }
+    if (dd == 1) {
+      NO_WAVL *raiz = rotacionar_esquerda_wavl(no);
+      y->posto++;
+      no->posto--;
+      // Uma folha não pode ficar a 2 dos dois lados
+      if (no->esq == NULL && no->dir == NULL)
+        no->posto--;
+      ESTAT_CONTAR(rotacoes_simples, 1);
+      ESTAT_CONTAR(mudancas_posto, 2);
+      return raiz;
+    }
+    NO_WAVL *v = y->esq;
+    no->dir = rotacionar_direita_wavl(y);
+    v->posto += 2;
+    y->posto--;
+    no->posto -= 2;
+    ESTAT_CONTAR(rotacoes_duplas, 1);
+    ESTAT_CONTAR(mudancas_posto, 3);
+    return rotacionar_esquerda_wavl(no);
+  }
+
+  if (r - posto_wavl(no->dir) == 3) {
+    NO_WAVL *y = no->esq;
+    if (r - y->posto == 2) {
+      no->posto--;
+      ESTAT_CONTAR(mudancas_posto, 1);
+      return no;
+    }
+    int de = y->posto - posto_wavl(y->esq), dd = y->posto - posto_wavl(y->dir);
+    if (de == 2 && dd == 2) {
+      no->posto--;
+      y->posto--;
+      ESTAT_CONTAR(mudancas_posto, 2);
+      return no;
+    }
+    if (de == 1) {
+      NO_WAVL *raiz = rotacionar_direita_wavl(no);
+      y->posto++;
+      no->posto--;
+      if (no->esq == NULL && no->dir == NULL)
+        no->posto--;
+      ESTAT_CONTAR(rotacoes_simples, 1);
+      ESTAT_CONTAR(mudancas_posto, 2);
+      return raiz;
+    }
+    NO_WAVL *v = y->dir;
+    no->esq = rotacionar_esquerda_wavl(y);
+    v->posto += 2;
+    y->posto--;
+    no->posto -= 2;
+    ESTAT_CONTAR(rotacoes_duplas, 1);
+    ESTAT_CONTAR(mudancas_posto, 3);
+    return rotacionar_direita_wavl(no);
+  }
+
+  return no;
+}
+
+NO_WAVL *no_inserir_wavl(NO_WAVL *no, int chave, int *resp) {
+  if (no == NULL) {
+    NO_WAVL *novo = criar_no_wavl(chave);
+    *resp = novo != NULL;
+    return novo;
+  }
+  ESTAT_VISITAR();
+  if (ESTAT_CMP(chave > no->chave)) {
+    no->dir = no_inserir_wavl(no->dir, chave, resp);
+  } else if (ESTAT_CMP(chave < no->chave)) {
+    no->esq = no_inserir_wavl(no->esq, chave, resp);
+  } else {
+    *resp = 0;
+    return no;
+  }
+  return balancear_insercao_wavl(no);
+}
+
+NO_WAVL *no_remover_wavl(NO_WAVL *no, int chave, int *resp) {
+  if (no == NULL)
+    return NULL;
+  ESTAT_VISITAR();
+  if (ESTAT_CMP(chave < no->chave)) {
+    no->esq = no_remover_wavl(no->esq, chave, resp);
+  } else if (ESTAT_CMP(chave > no->chave)) {
+    no->dir = no_remover_wavl(no->dir, chave, resp);
+  } else {
+    *resp = 1;
+    // Com no máximo um filho, o filho (uma folha, ou nada) toma o lugar
+    if (no->esq == NULL || no->dir == NULL) {
+      NO_WAVL *filho = no->esq ? no->esq : no->dir;
+      free(no);
+      ESTAT_LIBERAR(sizeof(NO_WAVL));
+      return filho;
+    }
+    // Com dois, o sucessor sobe e é removido da subárvore direita
+    NO_WAVL *sucessor = no->dir;
+    while (sucessor->esq != NULL)
+      sucessor = sucessor->esq;
+    no->chave = sucessor->chave;
+    no->dir = no_remover_wavl(no->dir, sucessor->chave, resp);
+  }
+  return balancear_remocao_wavl(no);
+}
+
+NO_WAVL *no_buscar_wavl(NO_WAVL *no, int chave) {
+  while (no != NULL) {
+    ESTAT_VISITAR();
+    if (ESTAT_CMP(no->chave == chave))
+      return no;
+    no = ESTAT_CMP(chave < no->chave) ? no->esq : no->dir;
+  }
+  return NULL;
+}
+
+int wavl_buscar(WAVL *T, int chave) {
+  if (T == NULL)
+    return 0;
+  return no_buscar_wavl(*T, chave) != NULL;
+}
+
+int wavl_inserir(WAVL *T, int chave) {
+  if (T == NULL)
+    return -1;
+
+  int resp = 0;
+  NO_WAVL *raiz = no_inserir_wavl(*T, chave, &resp);
+  if (raiz != NULL)
+    *T = raiz;
+  return resp;
+}
+
+int wavl_remover(WAVL *T, int chave) {
+  if (T == NULL || *T == NULL)
+    return 0;
+
+  int resp = 0;
+  *T = no_remover_wavl(*T, chave, &resp);
+  return resp;
+}
+
+void no_apagar_wavl(NO_WAVL *no) {
+  if (no != NULL) {
+    no_apagar_wavl(no->esq);
+    no_apagar_wavl(no->dir);
+    free(no);
+    ESTAT_LIBERAR(sizeof(NO_WAVL));
+  }
+}
+
+void wavl_apagar(WAVL **T) {
+  if (T != NULL && *T != NULL) {
+    no_apagar_wavl(**T);
+    free(*T);
+    *T = NULL;
+  }
+}
+
+// Empilha o nó e todo o seu caminho mais à esquerda
+void no_empilhar_esquerda_wavl(ITERADOR *it, NO_WAVL *no) {
+  while (no != NULL) {
+    iterador_empilhar(it, no);
+    no = no->esq;
+  }
+}
+
+// Mesmo percurso com pilha explícita de avl_iterador()
+void wavl_iterador(WAVL *T, ITERADOR *it) {
+  iterador_iniciar(it, T);
+  if (T != NULL)
+    no_empilhar_esquerda_wavl(it, *T);
+}
+
+int wavl_iterador_proximo(ITERADOR *it, int *valor) {
+  NO_WAVL *no = (NO_WAVL *)iterador_desempilhar(it);
+  if (no == NULL)
+    return 0;
+
+  *valor = no->chave;
+  no_empilhar_esquerda_wavl(it, no->dir);
+  return 1;
+}
+
+int wavl_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  while (it->topo > 0) {
+    NO_WAVL *topo = (NO_WAVL *)iterador_topo(it);
+    if (topo->chave >= alvo)
+      return wavl_iterador_proximo(it, valor);
+
+    iterador_desempilhar(it);
+
+    // Próximo pendente ainda menor: a subárvore direita do topo também é
+    NO_WAVL *abaixo = (NO_WAVL *)iterador_topo(it);
+    if (abaixo != NULL && abaixo->chave < alvo)
+      continue;
+
+    NO_WAVL *no = topo->dir;
+    while (no != NULL) {
+      if (no->chave >= alvo) {
+        iterador_empilhar(it, no);
+        no = no->esq;
+      } else {
+        no = no->dir;
+      }
+    }
+  }
+  return 0;
+}
+
+/*
+    Construção em lote como a da AVL: a árvore sai perfeitamente
+    balanceada, então posto = altura - 1 em todos os nós.
+*/
+NO_WAVL *no_construir_wavl(const int *chaves, size_t n, int threads,
+                           int *falha) {
+  if (n == 0)
+    return NULL;
+
+  size_t meio = n / 2;
+  NO_WAVL *raiz = criar_no_wavl(chaves[meio]);
+  if (raiz == NULL) {
+    *falha = 1;
+    return NULL;
+  }
+
+  CONSTRUCAO_WAVL esq = {chaves, meio, threads / 2, 0, NULL, ESTAT_ATUAL()};
+  int paralelo = threads > 1 && n >= CONSTRUCAO_MIN_PARALELO_WAVL;
+  if (paralelo) {
+    tarefa_iniciar(&esq.tarefa, construir_wavl_tarefa, &esq);
+    tarefa_lancar(&esq.tarefa);
+  } else {
+    raiz->esq = no_construir_wavl(chaves, meio, threads / 2, falha);
+  }
+  raiz->dir = no_construir_wavl(chaves + meio + 1, n - meio - 1,
+                                threads - threads / 2, falha);
+  if (paralelo) {
+    tarefa_esperar(&esq.tarefa);
+    raiz->esq = esq.raiz;
+    if (esq.falha)
+      *falha = 1;
+  }
+
+  int pe = posto_wavl(raiz->esq), pd = posto_wavl(raiz->dir);
+  raiz->posto = (pe > pd ? pe : pd) + 1;
+  return raiz;
+}
+
+void construir_wavl_tarefa(void *arg) {
+  CONSTRUCAO_WAVL *c = (CONSTRUCAO_WAVL *)arg;
+  ESTAT_USAR(c->estat);
+  c->raiz = no_construir_wavl(c->chaves, c->n, c->threads, &c->falha);
+}
+
+int wavl_construir(WAVL *T, const int *chaves, size_t n, int threads) {
+  if (T == NULL)
+    return -1;
+
+  no_apagar_wavl(*T);
+  *T = NULL;
+
+  int falha = 0;
+  NO_WAVL *raiz =
+      no_construir_wavl(chaves, n, threads < 1 ? 1 : threads, &falha);
+  if (falha) {
+    no_apagar_wavl(raiz);
+    return 0;
+  }
+
+  *T = raiz;
+  return 1;
+}
+
+int no_altura_wavl(NO_WAVL *no) {
+  if (no == NULL)
+    return 0;
+  int he = no_altura_wavl(no->esq), hd = no_altura_wavl(no->dir);
+  return (he > hd ? he : hd) + 1;
+}
+
+int wavl_altura(WAVL *T) {
+  if (T == NULL)
+    return 0;
+  return no_altura_wavl(*T);
+}
+
+/*
+    Junção como a da AVL, guiada pelos postos: desce pela borda da árvore
+    de posto maior até uma subárvore a no máximo 1 do posto da outra,
+    pendura ali o nó do meio e, na volta, corrige com o mesmo
+    rebalanceamento da inserção.
+*/
+NO_WAVL *no_juntar_wavl(NO_WAVL *menores, NO_WAVL *meio, NO_WAVL *maiores) {
+  int pe = posto_wavl(menores), pd = posto_wavl(maiores);
+
+  if (pe > pd + 1) {
+    ESTAT_VISITAR();
+    menores->dir = no_juntar_wavl(menores->dir, meio, maiores);
+    return balancear_insercao_wavl(menores);
+  }
+  if (pd > pe + 1) {
+    ESTAT_VISITAR();
+    maiores->esq = no_juntar_wavl(menores, meio, maiores->esq);
+    return balancear_insercao_wavl(maiores);
+  }
+
+  meio->esq = menores;
+  meio->dir = maiores;
+  meio->posto = (pe > pd ? pe : pd) + 1;
+  return meio;
+}
+
+// Divisão pelo caminho da busca, como no_dividir_avl()
+void no_dividir_wavl(NO_WAVL *no, int chave, NO_WAVL **menores,
+                     NO_WAVL **maiores) {
+  if (no == NULL) {
+    *menores = *maiores = NULL;
+    return;
+  }
+  ESTAT_VISITAR();
+
+  NO_WAVL *esq = no->esq, *dir = no->dir, *parte;
+  if (ESTAT_CMP(no->chave < chave)) {
+    no_dividir_wavl(dir, chave, &parte, maiores);
+    *menores = no_juntar_wavl(esq, no, parte);
+  } else {
+    no_dividir_wavl(esq, chave, menores, &parte);
+    *maiores = no_juntar_wavl(parte, no, dir);
+  }
+}
+
+int wavl_dividir(WAVL *T, int chave, WAVL *menores, WAVL *maiores) {
+  if (T == NULL || menores == NULL || maiores == NULL)
+    return -1;
+
+  no_apagar_wavl(*menores);
+  no_apagar_wavl(*maiores);
+  no_dividir_wavl(*T, chave, menores, maiores);
+  *T = NULL;
+  return 1;
+}
+
+// O menor nó de B vira o nó do meio, alocado antes de qualquer mudança
+int wavl_juntar(WAVL *A, WAVL *B) {
+  if (A == NULL || B == NULL)
+    return -1;
+  if (*B == NULL)
+    return 1;
+  if (*A == NULL) {
+    *A = *B;
+    *B = NULL;
+    return 1;
+  }
+
+  NO_WAVL *menor = *B;
+  while (menor->esq != NULL)
+    menor = menor->esq;
+  NO_WAVL *meio = criar_no_wavl(menor->chave);
+  if (meio == NULL)
+    return 0;
+
+  int resp;
+  *B = no_remover_wavl(*B, meio->chave, &resp);
+  *A = no_juntar_wavl(*A, meio, *B);
+  *B = NULL;
+  return 1;
+}
+
+int wavl_extremos(WAVL *T, int *menor, int *maior) {
+  if (T == NULL || *T == NULL)
+    return 0;
+
+  NO_WAVL *no = *T;
+  while (no->esq != NULL)
+    no = no->esq;
+  *menor = no->chave;
+  for (no = *T; no->dir != NULL; no = no->dir)
+    ;
+  *maior = no->chave;
+  return 1;
+}
@@ -0,0 +1,166 @@
+#ifndef WAVL_H
+#define WAVL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../set/iterador.h"
+
+/*
+    Árvore WAVL (AVL fraca, balanceada por postos): cada nó guarda um posto
+    e a diferença de posto entre pai e filho é sempre 1 ou 2 (nós ausentes
+    têm posto -1, e uma folha não pode ter diferença 2 dos dois lados).
+    Inserção e remoção fazem no máximo duas rotações cada, e o total de
+    mudanças de posto é O(1) amortizado por operação. Só com inserções a
+    árvore é exatamente uma AVL; com remoções a altura fica abaixo de
+    2 * log2(n).
+*/
+
+// Estrutura do nó da árvore WAVL.
+typedef struct no_wavl NO_WAVL;
+
+// Define WAVL como um ponteiro para a raiz.
+typedef NO_WAVL *WAVL;
+
+/**
+ * @brief Cria uma árvore WAVL vazia.
+ *
+ * @return WAVL* Ponteiro para a árvore, ou NULL em caso de erro na alocação.
+ */
+WAVL *wavl_criar(void);
+
+/**
+ * @brief Insere uma chave na árvore WAVL.
+ *
+ * O rebalanceamento sobe promovendo nós enquanto for preciso e termina com
+ * no máximo uma rotação (simples ou dupla).
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chave Chave a ser inserida.
+ * @return int Retorna 1 se inseriu, 0 se a chave já existia (ou faltou
+ * memória), ou -1 se a árvore for inválida.
+ */
+int wavl_inserir(WAVL *T, int chave);
+
+/**
+ * @brief Remove uma chave da árvore WAVL.
+ *
+ * O rebalanceamento sobe rebaixando nós enquanto for preciso e termina com
+ * no máximo uma rotação (simples ou dupla).
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chave Chave a ser removida.
+ * @return int Retorna 1 se removeu, ou 0 se a chave não foi encontrada.
+ */
+int wavl_remover(WAVL *T, int chave);
+
+/**
+ * @brief Verifica a existência de uma chave.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chave Chave a ser consultada.
+ * @return int Retorna 1 se a chave estiver presente, ou 0 caso contrário.
+ */
+int wavl_buscar(WAVL *T, int chave);
+
+/**
+ * @brief Apaga a árvore, liberando toda a memória alocada.
+ *
+ * @param T Endereço do ponteiro para a árvore. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void wavl_apagar(WAVL **T);
+
+/**
+ * @brief Prepara um iterador em ordem crescente sobre a árvore.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param it Iterador a ser preparado.
+ */
+void wavl_iterador(WAVL *T, ITERADOR *it);
+
+/**
+ * @brief Avança o iterador para a próxima chave em ordem crescente.
+ *
+ * @param it Iterador preparado por wavl_iterador().
+ * @param valor Recebe a chave visitada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 ao final do percurso.
+ */
+int wavl_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Avança o iterador até a primeira chave maior ou igual a `alvo`.
+ *
+ * Como avl_iterador_buscar(), em O(log(n)).
+ *
+ * @param it Iterador preparado por wavl_iterador().
+ * @param alvo Menor chave aceitável.
+ * @param valor Recebe a chave encontrada.
+ * @return int Retorna 1 se uma chave foi obtida, ou 0 se não houver chave
+ * maior ou igual a `alvo`.
+ */
+int wavl_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
+/**
+ * @brief Substitui o conteúdo por chaves ordenadas e sem repetição.
+ *
+ * Monta a árvore já balanceada em O(n), como avl_construir(), com as duas
+ * metades das subárvores grandes construídas em paralelo.
+ *
+ * @param T Ponteiro para a árvore.
+ * @param chaves Vetor de chaves em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @param threads Quantidade máxima de threads a usar.
+ * @return int Retorna 1 se bem-sucedida, 0 em caso de falha de alocação (a
+ * árvore fica vazia), ou -1 se a árvore for inválida.
+ */
+int wavl_construir(WAVL *T, const int *chaves, size_t n, int threads);
+
+/**
+ * @brief Retorna a altura da árvore, em O(n).
+ *
+ * O posto da raiz só limita a altura depois de remoções, então a altura é
+ * medida percorrendo a árvore.
+ *
+ * @param T Ponteiro para a árvore.
+ * @return int Altura (0 se vazia).
+ */
+int wavl_altura(WAVL *T);
+
+/**
+ * @brief Divide a árvore pela chave, em O(log(n)).
+ *
+ * Como avl_dividir(), com junções guiadas pelos postos.
+ *
+ * @param T Ponteiro para a árvore; fica vazia.
+ * @param chave Chave de corte.
+ * @param menores Recebe as chaves < chave (conteúdo anterior é apagado).
+ * @param maiores Recebe as chaves >= chave (conteúdo anterior é apagado).
+ * @return int Retorna 1 se bem-sucedida, ou -1 se algum ponteiro for
+ * inválido.
+ */
+int wavl_dividir(WAVL *T, int chave, WAVL *menores, WAVL *maiores);
+
+/**
+ * @brief Move todas as chaves de B para o fim de A, em O(log(n)).
+ *
+ * Todas as chaves de A devem ser menores que as de B (não é verificado).
+ *
+ * @param A Ponteiro para a árvore que recebe as chaves.
+ * @param B Ponteiro para a árvore de chaves maiores; fica vazia.
+ * @return int Retorna 1 se bem-sucedida, 0 em caso de falha de alocação
+ * (nada muda), ou -1 se algum ponteiro for inválido.
+ */
+int wavl_juntar(WAVL *A, WAVL *B);
+
+/**
+ * @brief Obtém a menor e a maior chave, em O(log(n)).
+ *
+ * @param T Ponteiro para a árvore.
+ * @param menor Recebe a menor chave.
+ * @param maior Recebe a maior chave.
+ * @return int Retorna 1 se a árvore tem chaves, ou 0 se estiver vazia.
+ */
+int wavl_extremos(WAVL *T, int *menor, int *maior);
+
+#endif // WAVL_H
@@ -1,24 +1,56 @@
-// Cliente - onde as entradas serão lidas, logo, faz-se um menu
-#include <../set/set.h>
+// Cliente - lê comandos (arquivo ou entrada padrão) e responde na saída padrão
+#include <../set/comandos.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-int main(void) {
-
-  // SET set = criar_set(int opt);
-
+int main(int argc, char *argv[]) {
   /*
-          Ler a opção na criação do set
+          Uma operação por linha (ver set/comandos.h), por exemplo:
 
-          1 - pertence
-          2 - uniao
-          3 - interseccao
+          criar A 0
+          inserir A 1 2 3 4
+          pertence A 3 5          -> 1 0
+          criar B 1
+          inserir B 3 4 5
+          interseccao C A B
+          imprimir C              -> 3 4
 
-					ler n elementos que serão colocados no set
-					(ou 2 sets caso seja a 2ª ou 3ª opção)
-						Pertence - Nao pertence
-						dar como resposta apenas o set
+          Uso: ./main [arquivo]   (sem arquivo, lê da entrada padrão)
   */
 
-  return 0;
-}
\ No newline at end of file
+  FILE *entrada = stdin;
+  if (argc > 1) {
+    entrada = fopen(argv[1], "r");
+    if (!entrada) {
+      perror(argv[1]);
+      return 1;
+    }
+  }
+
+  SAIDA *saida = saida_arquivo(stdout);
+  COMANDOS *comandos = comandos_criar(saida, NULL, 0);
+  if (!comandos) {
+    fprintf(stderr, "Erro: Falha na alocação de memória\n");
+    saida_apagar(&saida);
+    return 1;
+  }
+
+  int ok = comandos_executar(comandos, entrada);
+
+  // Relatório de desempenho em stderr, para não misturar com as respostas
+  COMANDOS_RESUMO resumo;
+  comandos_resumo(comandos, &resumo);
+  fprintf(stderr,
+          "%zu linhas, %zu operações em %zu lotes, %zu erros: %.3f s "
+          "(%.0f ops/s)\n",
+          resumo.linhas, resumo.operacoes, resumo.lotes, resumo.erros,
+          resumo.segundos,
+          resumo.segundos > 0 ? (double)resumo.operacoes / resumo.segundos
+                              : 0.0);
+
+  comandos_apagar(&comandos);
+  saida_apagar(&saida);
+  if (entrada != stdin)
+    fclose(entrada);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "buffer.h"
+
+// Capacidade inicial da tabela (potência de 2)
+#define BUFFER_CAPACIDADE_MIN 1024
+
+// Entrada da tabela: estado BUFFER_AUSENTE marca posição livre
+typedef struct entrada_buffer {
+  int chave;
+  int estado;
+} ENTRADA_BUFFER;
+
+/*
+    Tabela hash de endereçamento aberto (sondagem linear). Nenhuma chave sai
+    da tabela antes de buffer_limpar(): uma remoção pendente é só uma troca
+    de estado, então não há buracos a tratar. As posições usam os bits altos
+    do hash multiplicativo, que dependem de todos os bits da chave; chaves
+    sequenciais (o caso comum na ingestão) ficam bem espalhadas.
+*/
+typedef struct buffer {
+  ENTRADA_BUFFER *tabela;
+  size_t capacidade; // Potência de 2
+  unsigned bits;     // log2(capacidade)
+  size_t usados;
+} BUFFER;
+
+// Protocolo das Funções
+
+// Auxiliares
+size_t posicao_buffer(const BUFFER *b, int chave);
+ENTRADA_BUFFER *procurar_buffer(BUFFER *b, int chave);
+int crescer_buffer(BUFFER *b);
+
+// Principais
+BUFFER *buffer_criar(void);
+int buffer_consultar(BUFFER *b, int chave);
+int buffer_marcar(BUFFER *b, int chave, int estado);
+size_t buffer_tamanho(BUFFER *b);
+void buffer_extrair(BUFFER *b, int *inseridos, size_t *n_inseridos,
+                    int *removidos, size_t *n_removidos);
+void buffer_limpar(BUFFER *b);
+void buffer_apagar(BUFFER **b);
+
+size_t posicao_buffer(const BUFFER *b, int chave) {
+  uint64_t h = (uint64_t)(uint32_t)chave * 0x9E3779B97F4A7C15ULL;
+  return (size_t)(h >> (64 - b->bits));
+}
+
+// Entrada da chave, ou a posição livre onde ela entraria
+ENTRADA_BUFFER *procurar_buffer(BUFFER *b, int chave) {
+  size_t p = posicao_buffer(b, chave);
+  while (b->tabela[p].estado != BUFFER_AUSENTE && b->tabela[p].chave != chave)
+    p = (p + 1) & (b->capacidade - 1);
+  return &b->tabela[p];
+}
+
+// Dobra a tabela e reposiciona as entradas
+int crescer_buffer(BUFFER *b) {
+  size_t antiga = b->capacidade;
+  ENTRADA_BUFFER *velha = b->tabela;
+  ENTRADA_BUFFER *t =
+      (ENTRADA_BUFFER *)calloc(antiga * 2, sizeof(ENTRADA_BUFFER));
+  if (!t)
+    return 0;
+  b->tabela = t;
+  b->capacidade = antiga * 2;
+  b->bits++;
+
+  for (size_t i = 0; i < antiga; i++)
+    if (velha[i].estado != BUFFER_AUSENTE)
+      *procurar_buffer(b, velha[i].chave) = velha[i];
+  free(velha);
+  return 1;
+}
+
+BUFFER *buffer_criar(void) {
+  BUFFER *b = (BUFFER *)malloc(sizeof(BUFFER));
+  if (!b)
+    return NULL;
+  b->capacidade = BUFFER_CAPACIDADE_MIN;
+  b->bits = 10;
+  b->usados = 0;
+  b->tabela = (ENTRADA_BUFFER *)calloc(b->capacidade, sizeof(ENTRADA_BUFFER));
+  if (!b->tabela) {
+    free(b);
+    return NULL;
+  }
+  return b;
+}
+
+int buffer_consultar(BUFFER *b, int chave) {
+  return procurar_buffer(b, chave)->estado;
+}
+
+int buffer_marcar(BUFFER *b, int chave, int estado) {
+  ENTRADA_BUFFER *e = procurar_buffer(b, chave);
+  if (e->estado == BUFFER_AUSENTE) {
+    // Carga máxima de 3/4
+    if ((b->usados + 1) * 4 > b->capacidade * 3) {
+      if (!crescer_buffer(b))
+        return 0;
+      e = procurar_buffer(b, chave);
+    }
+    e->chave = chave;
+    b->usados++;
+  }
+  e->estado = estado;
+  return 1;
+}
+
+size_t buffer_tamanho(BUFFER *b) { return b->usados; }
+
+void buffer_extrair(BUFFER *b, int *inseridos, size_t *n_inseridos,
+                    int *removidos, size_t *n_removidos) {
+  size_t ni = 0, nr = 0;
+  for (size_t i = 0; i < b->capacidade; i++) {
+    if (b->tabela[i].estado == BUFFER_INSERIDO)
+      inseridos[ni++] = b->tabela[i].chave;
+    else if (b->tabela[i].estado == BUFFER_REMOVIDO)
+      removidos[nr++] = b->tabela[i].chave;
+  }
+  *n_inseridos = ni;
+  *n_removidos = nr;
+}
+
+void buffer_limpar(BUFFER *b) {
+  if (b->usados == 0)
+    return;
+  memset(b->tabela, 0, b->capacidade * sizeof(ENTRADA_BUFFER));
+  b->usados = 0;
+}
+
+void buffer_apagar(BUFFER **b) {
+  if (!b || !*b)
+    return;
+  free((*b)->tabela);
+  free(*b);
+  *b = NULL;
+}
@@ -0,0 +1,80 @@
+#ifndef BUFFER_H
+#define BUFFER_H
+
+#include <stddef.h>
+
+// Alterações pendentes de um conjunto em modo bufferizado (ver
+// set_bufferizar()), ainda não aplicadas à árvore.
+typedef struct buffer BUFFER;
+
+// Estado de uma chave no buffer
+#define BUFFER_AUSENTE 0  // Nenhuma alteração pendente: vale a árvore
+#define BUFFER_INSERIDO 1 // A chave pertence ao conjunto
+#define BUFFER_REMOVIDO 2 // Marca de remoção (tombstone)
+
+/**
+ * @brief Cria um buffer vazio.
+ *
+ * @return Ponteiro para o buffer ou NULL em caso de erro.
+ */
+BUFFER *buffer_criar(void);
+
+/**
+ * @brief Consulta o estado pendente de uma chave, em O(1) esperado.
+ *
+ * @param b Ponteiro para o buffer.
+ * @param chave Chave consultada.
+ * @return BUFFER_AUSENTE, BUFFER_INSERIDO ou BUFFER_REMOVIDO.
+ */
+int buffer_consultar(BUFFER *b, int chave);
+
+/**
+ * @brief Registra o estado de uma chave, substituindo o anterior.
+ *
+ * Só uma chave ainda ausente pode precisar de memória.
+ *
+ * @param b Ponteiro para o buffer.
+ * @param chave Chave alterada.
+ * @param estado BUFFER_INSERIDO ou BUFFER_REMOVIDO.
+ * @return 1 em caso de sucesso, 0 em caso de falha de alocação.
+ */
+int buffer_marcar(BUFFER *b, int chave, int estado);
+
+/**
+ * @brief Quantidade de chaves com alteração pendente.
+ *
+ * @param b Ponteiro para o buffer.
+ * @return Quantidade de chaves.
+ */
+size_t buffer_tamanho(BUFFER *b);
+
+/**
+ * @brief Copia as chaves pendentes, separadas por estado e sem ordem.
+ *
+ * Cada vetor deve ter espaço para buffer_tamanho() chaves.
+ *
+ * @param b Ponteiro para o buffer.
+ * @param inseridos Recebe as chaves BUFFER_INSERIDO.
+ * @param n_inseridos Recebe a quantidade de inseridos.
+ * @param removidos Recebe as chaves BUFFER_REMOVIDO.
+ * @param n_removidos Recebe a quantidade de removidos.
+ */
+void buffer_extrair(BUFFER *b, int *inseridos, size_t *n_inseridos,
+                    int *removidos, size_t *n_removidos);
+
+/**
+ * @brief Descarta todas as alterações pendentes, mantendo a memória.
+ *
+ * @param b Ponteiro para o buffer.
+ */
+void buffer_limpar(BUFFER *b);
+
+/**
+ * @brief Libera o buffer.
+ *
+ * @param b Endereço do ponteiro para o buffer. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void buffer_apagar(BUFFER **b);
+
+#endif // BUFFER_H
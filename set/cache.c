@@ -0,0 +1,373 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cache.h"
+#include "saida.h"
+
+// Quantidade inicial de baldes da tabela (potência de 2)
+#define CACHE_BALDES_MIN 64
+
+// Memória estimada de um conjunto congelado além das suas chaves
+#define CACHE_SOBRECARGA_SET 128
+
+// Estado de um operando quando o resultado foi calculado
+typedef struct operando_cache {
+  uint64_t id;
+  uint64_t versao;
+} OPERANDO_CACHE;
+
+/*
+    Cada entrada fica ao mesmo tempo numa cadeia da tabela hash (busca pela
+    chave) e na lista LRU (mais recente na cabeça). Enquanto algum leitor
+    não devolveu o resultado, a entrada também fica na lista de emprestadas;
+    uma entrada descartada nesse meio tempo sai da tabela e da LRU, mas só é
+    liberada na última devolução.
+*/
+typedef struct entrada_cache {
+  int tipo;
+  size_t k;
+  OPERANDO_CACHE *operandos; // Ordenados por id
+  uint64_t hash;
+  SET *resultado;
+  size_t bytes;
+  int emprestimos;  // cache_consultar() ainda não devolvidos
+  int descartada;   // Fora da tabela e da LRU
+  struct entrada_cache *prox_balde;
+  struct entrada_cache *ant_lru, *prox_lru;
+  struct entrada_cache *ant_emp, *prox_emp;
+} ENTRADA_CACHE;
+
+typedef struct cache {
+  ENTRADA_CACHE **baldes;
+  size_t n_baldes; // Potência de 2
+  ENTRADA_CACHE *lru_inicio, *lru_fim;
+  ENTRADA_CACHE *emprestadas;
+  size_t entradas;
+  size_t bytes;
+  size_t bytes_max;
+  uint64_t acertos, falhas, descartes;
+  pthread_mutex_t trava;
+} CACHE;
+
+// Protocolo das Funções
+
+// Auxiliares
+int comparar_operando(const void *a, const void *b);
+uint64_t misturar_cache(uint64_t x);
+void ler_operandos(SET **sets, size_t k, OPERANDO_CACHE *ops);
+uint64_t hash_cache(int tipo, const OPERANDO_CACHE *ops, size_t k);
+ENTRADA_CACHE *procurar_cache(CACHE *c, int tipo, const OPERANDO_CACHE *ops,
+                              size_t k, uint64_t hash);
+void remover_lru(CACHE *c, ENTRADA_CACHE *e);
+void inserir_lru(CACHE *c, ENTRADA_CACHE *e);
+void emprestar_cache(CACHE *c, ENTRADA_CACHE *e);
+void liberar_entrada(ENTRADA_CACHE *e);
+void descartar_cache(CACHE *c, ENTRADA_CACHE *e);
+int crescer_cache(CACHE *c);
+SET *calcular_cache(int tipo, SET **sets, size_t k);
+
+// Principais
+CACHE *cache_criar(size_t bytes_max);
+SET *cache_consultar(CACHE *cache, int tipo, SET **sets, size_t k);
+void cache_devolver(CACHE *cache, SET **resultado);
+int cache_estatisticas(CACHE *cache, CACHE_ESTATISTICAS *estat);
+void cache_apagar(CACHE **cache);
+
+int comparar_operando(const void *a, const void *b) {
+  const OPERANDO_CACHE *x = (const OPERANDO_CACHE *)a;
+  const OPERANDO_CACHE *y = (const OPERANDO_CACHE *)b;
+  return (x->id > y->id) - (x->id < y->id);
+}
+
+// Finalizador do splitmix64
+uint64_t misturar_cache(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xBF58476D1CE4E5B9ULL;
+  x ^= x >> 27;
+  x *= 0x94D049BB133111EBULL;
+  x ^= x >> 31;
+  return x;
+}
+
+// Estado atual dos operandos, em ordem de id. União e intersecção são
+// comutativas: com a ordem fixa, (A, B) e (B, A) caem na mesma entrada
+void ler_operandos(SET **sets, size_t k, OPERANDO_CACHE *ops) {
+  for (size_t i = 0; i < k; i++) {
+    ops[i].id = set_id(sets[i]);
+    ops[i].versao = set_versao(sets[i]);
+  }
+  qsort(ops, k, sizeof(OPERANDO_CACHE), comparar_operando);
+}
+
+uint64_t hash_cache(int tipo, const OPERANDO_CACHE *ops, size_t k) {
+  uint64_t h = misturar_cache((uint64_t)tipo + 0x9E3779B97F4A7C15ULL);
+  for (size_t i = 0; i < k; i++)
+    h = misturar_cache(h ^ misturar_cache(ops[i].id) ^
+                       (ops[i].versao * 0x9E3779B97F4A7C15ULL));
+  return h;
+}
+
+ENTRADA_CACHE *procurar_cache(CACHE *c, int tipo, const OPERANDO_CACHE *ops,
+                              size_t k, uint64_t hash) {
+  ENTRADA_CACHE *e = c->baldes[hash & (c->n_baldes - 1)];
+  for (; e; e = e->prox_balde)
+    if (e->hash == hash && e->tipo == tipo && e->k == k &&
+        memcmp(e->operandos, ops, k * sizeof(OPERANDO_CACHE)) == 0)
+      return e;
+  return NULL;
+}
+
+void remover_lru(CACHE *c, ENTRADA_CACHE *e) {
+  if (e->ant_lru)
+    e->ant_lru->prox_lru = e->prox_lru;
+  else
+    c->lru_inicio = e->prox_lru;
+  if (e->prox_lru)
+    e->prox_lru->ant_lru = e->ant_lru;
+  else
+    c->lru_fim = e->ant_lru;
+  e->ant_lru = e->prox_lru = NULL;
+}
+
+void inserir_lru(CACHE *c, ENTRADA_CACHE *e) {
+  e->ant_lru = NULL;
+  e->prox_lru = c->lru_inicio;
+  if (c->lru_inicio)
+    c->lru_inicio->ant_lru = e;
+  else
+    c->lru_fim = e;
+  c->lru_inicio = e;
+}
+
+// Registra mais um leitor do resultado
+void emprestar_cache(CACHE *c, ENTRADA_CACHE *e) {
+  if (e->emprestimos++ > 0)
+    return;
+  e->ant_emp = NULL;
+  e->prox_emp = c->emprestadas;
+  if (c->emprestadas)
+    c->emprestadas->ant_emp = e;
+  c->emprestadas = e;
+}
+
+void liberar_entrada(ENTRADA_CACHE *e) {
+  set_apagar(&e->resultado);
+  free(e->operandos);
+  free(e);
+}
+
+// Tira a entrada da tabela e da LRU; libera se ninguém a estiver lendo
+void descartar_cache(CACHE *c, ENTRADA_CACHE *e) {
+  ENTRADA_CACHE **p = &c->baldes[e->hash & (c->n_baldes - 1)];
+  while (*p != e)
+    p = &(*p)->prox_balde;
+  *p = e->prox_balde;
+  remover_lru(c, e);
+  c->entradas--;
+  c->bytes -= e->bytes;
+  e->descartada = 1;
+  if (e->emprestimos == 0)
+    liberar_entrada(e);
+}
+
+// Dobra a quantidade de baldes e redistribui as entradas
+int crescer_cache(CACHE *c) {
+  size_t n = c->n_baldes * 2;
+  ENTRADA_CACHE **b = (ENTRADA_CACHE **)calloc(n, sizeof(ENTRADA_CACHE *));
+  if (!b)
+    return 0;
+  for (size_t i = 0; i < c->n_baldes; i++) {
+    ENTRADA_CACHE *e = c->baldes[i];
+    while (e) {
+      ENTRADA_CACHE *prox = e->prox_balde;
+      e->prox_balde = b[e->hash & (n - 1)];
+      b[e->hash & (n - 1)] = e;
+      e = prox;
+    }
+  }
+  free(c->baldes);
+  c->baldes = b;
+  c->n_baldes = n;
+  return 1;
+}
+
+// Calcula o resultado direto num vetor ordenado e o congela
+SET *calcular_cache(int tipo, SET **sets, size_t k) {
+  SAIDA *saida = saida_vetor(set_tamanho(sets[0]));
+  if (!saida)
+    return NULL;
+  int ok = tipo == CACHE_UNIAO ? set_uniao_k_emitir(sets, k, saida)
+                               : set_interseccao_k_emitir(sets, k, saida);
+  SET *r = NULL;
+  if (ok) {
+    size_t n;
+    int *chaves = saida_dados(saida, &n);
+    r = set_construir_ordenado(SET_CONGELADO, chaves, n);
+  }
+  saida_apagar(&saida);
+  return r;
+}
+
+CACHE *cache_criar(size_t bytes_max) {
+  CACHE *c = (CACHE *)calloc(1, sizeof(CACHE));
+  if (!c)
+    return NULL;
+  c->n_baldes = CACHE_BALDES_MIN;
+  c->baldes = (ENTRADA_CACHE **)calloc(c->n_baldes, sizeof(ENTRADA_CACHE *));
+  if (!c->baldes) {
+    free(c);
+    return NULL;
+  }
+  c->bytes_max = bytes_max;
+  pthread_mutex_init(&c->trava, NULL);
+  return c;
+}
+
+SET *cache_consultar(CACHE *cache, int tipo, SET **sets, size_t k) {
+  if (!cache || !sets || k == 0 ||
+      (tipo != CACHE_UNIAO && tipo != CACHE_INTERSECCAO))
+    return NULL;
+  for (size_t i = 0; i < k; i++)
+    if (!sets[i])
+      return NULL;
+
+  OPERANDO_CACHE *ops = (OPERANDO_CACHE *)malloc(k * sizeof(OPERANDO_CACHE));
+  if (!ops)
+    return NULL;
+  ler_operandos(sets, k, ops);
+  uint64_t hash = hash_cache(tipo, ops, k);
+
+  pthread_mutex_lock(&cache->trava);
+  ENTRADA_CACHE *e = procurar_cache(cache, tipo, ops, k, hash);
+  if (e) {
+    cache->acertos++;
+    remover_lru(cache, e);
+    inserir_lru(cache, e);
+    emprestar_cache(cache, e);
+    pthread_mutex_unlock(&cache->trava);
+    free(ops);
+    return e->resultado;
+  }
+  cache->falhas++;
+  pthread_mutex_unlock(&cache->trava);
+
+  // O cálculo fica fora da trava: outras consultas seguem enquanto isso
+  SET *r = calcular_cache(tipo, sets, k);
+  OPERANDO_CACHE *depois =
+      (OPERANDO_CACHE *)malloc(k * sizeof(OPERANDO_CACHE));
+  e = r && depois ? (ENTRADA_CACHE *)calloc(1, sizeof(ENTRADA_CACHE)) : NULL;
+  if (!e) {
+    set_apagar(&r);
+    free(depois);
+    free(ops);
+    return NULL;
+  }
+  e->tipo = tipo;
+  e->k = k;
+  e->operandos = ops;
+  e->hash = hash;
+  e->resultado = r;
+  e->bytes = sizeof(ENTRADA_CACHE) + k * sizeof(OPERANDO_CACHE) +
+             set_tamanho(r) * sizeof(int) + CACHE_SOBRECARGA_SET;
+
+  // Um operando alterado durante o cálculo (skip list com escritas
+  // concorrentes) deixa o resultado sem versão definida, e um resultado
+  // maior que o limite não cabe: os dois são entregues, mas não guardados
+  ler_operandos(sets, k, depois);
+  int guardar = e->bytes <= cache->bytes_max &&
+                memcmp(depois, ops, k * sizeof(OPERANDO_CACHE)) == 0;
+  free(depois);
+
+  pthread_mutex_lock(&cache->trava);
+  ENTRADA_CACHE *outra = guardar ? procurar_cache(cache, tipo, ops, k, hash)
+                                 : NULL;
+  if (outra) {
+    // Outra thread calculou o mesmo resultado primeiro: fica o dela
+    remover_lru(cache, outra);
+    inserir_lru(cache, outra);
+    emprestar_cache(cache, outra);
+    pthread_mutex_unlock(&cache->trava);
+    liberar_entrada(e);
+    return outra->resultado;
+  }
+  if (guardar && cache->entradas >= cache->n_baldes)
+    crescer_cache(cache);
+  if (guardar) {
+    while (cache->bytes + e->bytes > cache->bytes_max) {
+      descartar_cache(cache, cache->lru_fim);
+      cache->descartes++;
+    }
+    ENTRADA_CACHE **balde = &cache->baldes[hash & (cache->n_baldes - 1)];
+    e->prox_balde = *balde;
+    *balde = e;
+    inserir_lru(cache, e);
+    cache->entradas++;
+    cache->bytes += e->bytes;
+  } else {
+    e->descartada = 1;
+  }
+  emprestar_cache(cache, e);
+  pthread_mutex_unlock(&cache->trava);
+  return r;
+}
+
+void cache_devolver(CACHE *cache, SET **resultado) {
+  if (!cache || !resultado || !*resultado)
+    return;
+  pthread_mutex_lock(&cache->trava);
+  ENTRADA_CACHE *e = cache->emprestadas;
+  while (e && e->resultado != *resultado)
+    e = e->prox_emp;
+  if (e && --e->emprestimos == 0) {
+    if (e->ant_emp)
+      e->ant_emp->prox_emp = e->prox_emp;
+    else
+      cache->emprestadas = e->prox_emp;
+    if (e->prox_emp)
+      e->prox_emp->ant_emp = e->ant_emp;
+    if (e->descartada)
+      liberar_entrada(e);
+  }
+  pthread_mutex_unlock(&cache->trava);
+  *resultado = NULL;
+}
+
+int cache_estatisticas(CACHE *cache, CACHE_ESTATISTICAS *estat) {
+  if (!cache || !estat)
+    return 0;
+  pthread_mutex_lock(&cache->trava);
+  estat->acertos = cache->acertos;
+  estat->falhas = cache->falhas;
+  estat->descartes = cache->descartes;
+  estat->entradas = cache->entradas;
+  estat->bytes = cache->bytes;
+  estat->bytes_max = cache->bytes_max;
+  pthread_mutex_unlock(&cache->trava);
+  return 1;
+}
+
+void cache_apagar(CACHE **cache) {
+  if (!cache || !*cache)
+    return;
+  CACHE *c = *cache;
+  // Emprestadas descartadas não estão na LRU; as demais saem por ela
+  ENTRADA_CACHE *e = c->emprestadas;
+  while (e) {
+    ENTRADA_CACHE *prox = e->prox_emp;
+    if (e->descartada)
+      liberar_entrada(e);
+    e = prox;
+  }
+  e = c->lru_inicio;
+  while (e) {
+    ENTRADA_CACHE *prox = e->prox_lru;
+    liberar_entrada(e);
+    e = prox;
+  }
+  pthread_mutex_destroy(&c->trava);
+  free(c->baldes);
+  free(c);
+  *cache = NULL;
+}
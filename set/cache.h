@@ -0,0 +1,86 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "set.h"
+
+// Resultados de operações guardados pela versão dos operandos (LRU).
+typedef struct cache CACHE;
+
+// Operações que podem ser guardadas
+#define CACHE_UNIAO 0
+#define CACHE_INTERSECCAO 1
+
+/**
+ * @brief Contadores de uso de um cache (ver cache_estatisticas()).
+ */
+typedef struct cache_estatisticas {
+  uint64_t acertos;  /**< Consultas respondidas com um resultado guardado. */
+  uint64_t falhas;   /**< Consultas que precisaram calcular o resultado. */
+  uint64_t descartes; /**< Resultados retirados para respeitar o limite. */
+  size_t entradas;   /**< Resultados guardados agora. */
+  size_t bytes;      /**< Memória estimada dos resultados guardados. */
+  size_t bytes_max;  /**< Limite de memória do cache. */
+} CACHE_ESTATISTICAS;
+
+/**
+ * @brief Cria um cache vazio.
+ *
+ * @param bytes_max Memória máxima (estimada) dos resultados guardados.
+ * @return Ponteiro para o cache ou NULL em caso de erro.
+ */
+CACHE *cache_criar(size_t bytes_max);
+
+/**
+ * @brief União ou intersecção de k conjuntos, reaproveitando o resultado de
+ * uma consulta anterior se nenhum operando mudou desde então.
+ *
+ * A chave é a operação e os pares (set_id(), set_versao()) dos operandos,
+ * sem depender da ordem em que eles aparecem em `sets`. Um acerto custa uma
+ * busca na tabela; uma falha calcula o resultado com set_uniao_k_emitir()
+ * ou set_interseccao_k_emitir() e o guarda congelado (SET_CONGELADO),
+ * descartando os menos usados recentemente até caber no limite.
+ *
+ * O conjunto devolvido é somente leitura e pertence ao cache: continua
+ * válido até ser devolvido com cache_devolver(), mesmo que seja descartado
+ * nesse meio tempo. Não deve ser apagado com set_apagar().
+ *
+ * @param cache Ponteiro para o cache.
+ * @param tipo CACHE_UNIAO ou CACHE_INTERSECCAO.
+ * @param sets Vetor de ponteiros para os operandos.
+ * @param k Quantidade de operandos.
+ * @return Conjunto resultado, ou NULL em caso de erro.
+ */
+SET *cache_consultar(CACHE *cache, int tipo, SET **sets, size_t k);
+
+/**
+ * @brief Devolve um resultado obtido com cache_consultar().
+ *
+ * @param cache Ponteiro para o cache.
+ * @param resultado Endereço do ponteiro para o resultado. Após a execução, o
+ * ponteiro será definido como NULL.
+ */
+void cache_devolver(CACHE *cache, SET **resultado);
+
+/**
+ * @brief Lê os contadores de uso do cache.
+ *
+ * @param cache Ponteiro para o cache.
+ * @param estat Recebe os contadores.
+ * @return 1 em caso de sucesso, 0 se algum parâmetro for inválido.
+ */
+int cache_estatisticas(CACHE *cache, CACHE_ESTATISTICAS *estat);
+
+/**
+ * @brief Libera o cache e todos os resultados guardados.
+ *
+ * Os resultados ainda não devolvidos também são liberados.
+ *
+ * @param cache Endereço do ponteiro para o cache. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void cache_apagar(CACHE **cache);
+
+#endif // CACHE_H
@@ -0,0 +1,649 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "comandos.h"
+#include "ordenacao.h"
+
+// Maior nome de conjunto (com o terminador)
+#define COMANDOS_NOME_MAX 32
+
+// Valores acumulados antes de executar o lote à força
+#define COMANDOS_LOTE_MAX 65536
+
+// Leitura de comandos_executar(); cresce se uma linha não couber
+#define COMANDOS_LEITURA 65536
+
+// A partir disso as consultas do lote são ordenadas e respondidas com um
+// único iterador que só avança (set_iterador_buscar())
+#define PERTENCE_ORDENADO_MIN 1024
+
+// Alterações só são ordenadas em lotes a partir desse tamanho; abaixo
+// disso o custo fixo da ordenação supera o ganho de localidade
+#define ALTERACAO_ORDENADA_MIN 256
+
+// Tipos de lote pendente
+#define LOTE_NENHUM 0
+#define LOTE_INSERIR 1
+#define LOTE_REMOVER 2
+#define LOTE_PERTENCE 3
+
+typedef struct conjunto_nomeado {
+  char nome[COMANDOS_NOME_MAX];
+  SET *set;
+  int opt; // Estrutura atual (muda com congelar e converter)
+} CONJUNTO_NOMEADO;
+
+/*
+    Conjuntos nomeados. Consultas seguram a trava para leitura e alterações
+    para escrita; entradas só são acessadas com a trava, porque `criar`
+    pode realocar o vetor e `apagar` move a última entrada para a vaga.
+*/
+typedef struct catalogo {
+  CONJUNTO_NOMEADO *conjuntos;
+  size_t quantidade, capacidade;
+  pthread_rwlock_t trava;
+} CATALOGO;
+
+typedef struct comandos {
+  SAIDA *saida;
+  CATALOGO *catalogo;
+  int proprio;         // Catálogo criado (e liberado) pelo motor
+  int confirmar;       // COMANDOS_CONFIRMAR: toda linha recebe resposta
+
+  // Lote pendente: `lote` sobre o conjunto `nome`
+  int lote;
+  char nome[COMANDOS_NOME_MAX];
+  int *valores;        // COMANDOS_LOTE_MAX posições
+  size_t n;
+  size_t *fins;        // Fim dos valores de cada linha que recebe resposta
+  size_t n_fins;
+  int *respostas;      // pertence: resposta de cada valor
+  uint64_t *ordem;     // pertence: (valor, posição) ordenados
+
+  size_t linha;        // Linha em execução (para mensagens de erro)
+  COMANDOS_RESUMO resumo;
+  struct timespec inicio;
+} COMANDOS;
+
+// Protocolo das Funções
+
+// Auxiliares
+void erro_comando(COMANDOS *c, const char *formato, ...);
+void pular_espacos(const char **p, const char *fim);
+size_t ler_palavra(const char **p, const char *fim, char *destino,
+                   size_t capacidade);
+int ler_inteiro(const char **p, const char *fim, int *valor);
+CONJUNTO_NOMEADO *buscar_conjunto(CATALOGO *cat, const char *nome);
+CONJUNTO_NOMEADO *ler_conjunto(COMANDOS *c, const char **p, const char *fim);
+int guardar_conjunto(CATALOGO *cat, const char *nome, SET *set, int opt);
+int comparar_ordem(const void *a, const void *b);
+void responder_pertence(COMANDOS *c, SET *set);
+int alterar_lote(COMANDOS *c, CONJUNTO_NOMEADO *e);
+void executar_lote(COMANDOS *c);
+void acumular_lote(COMANDOS *c, int tipo, const char **p, const char *fim);
+void executar_operacao(COMANDOS *c, int uniao, const char **p,
+                       const char *fim);
+int eh_predicado(const char *comando);
+int executar_comando(COMANDOS *c, const char *comando, const char **p,
+                     const char *fim);
+void executar_linha(COMANDOS *c, const char *p, const char *fim);
+
+// Principais
+CATALOGO *catalogo_criar(void);
+void catalogo_apagar(CATALOGO **catalogo);
+COMANDOS *comandos_criar(SAIDA *saida, CATALOGO *catalogo, int opcoes);
+size_t comandos_processar(COMANDOS *c, const char *dados, size_t n);
+int comandos_concluir(COMANDOS *c);
+int comandos_executar(COMANDOS *c, FILE *entrada);
+void comandos_resumo(COMANDOS *c, COMANDOS_RESUMO *resumo);
+void comandos_apagar(COMANDOS **c);
+
+// Conta e descreve um comando recusado
+void erro_comando(COMANDOS *c, const char *formato, ...) {
+  va_list args;
+  va_start(args, formato);
+  fprintf(stderr, "linha %zu: ", c->linha);
+  vfprintf(stderr, formato, args);
+  fputc('\n', stderr);
+  va_end(args);
+  c->resumo.erros++;
+}
+
+void pular_espacos(const char **p, const char *fim) {
+  while (*p < fim && (**p == ' ' || **p == '\t' || **p == '\r'))
+    (*p)++;
+}
+
+// Lê a próxima palavra (truncada em `capacidade` - 1); retorna o tamanho
+size_t ler_palavra(const char **p, const char *fim, char *destino,
+                   size_t capacidade) {
+  pular_espacos(p, fim);
+  size_t n = 0;
+  while (*p < fim && **p != ' ' && **p != '\t' && **p != '\r') {
+    if (n + 1 < capacidade)
+      destino[n] = **p;
+    n++;
+    (*p)++;
+  }
+  destino[n < capacidade ? n : capacidade - 1] = '\0';
+  return n;
+}
+
+// Lê um inteiro decimal com sinal; 0 se não houver um inteiro válido
+int ler_inteiro(const char **p, const char *fim, int *valor) {
+  pular_espacos(p, fim);
+  const char *q = *p;
+  int negativo = q < fim && *q == '-';
+  if (q < fim && (*q == '-' || *q == '+'))
+    q++;
+
+  int64_t v = 0;
+  const char *digitos = q;
+  while (q < fim && *q >= '0' && *q <= '9') {
+    v = v * 10 + (*q - '0');
+    if (v > (int64_t)INT_MAX + 1)
+      return 0;
+    q++;
+  }
+  if (q == digitos || (q < fim && *q != ' ' && *q != '\t' && *q != '\r'))
+    return 0;
+  if (negativo)
+    v = -v;
+  if (v > INT_MAX)
+    return 0;
+
+  *valor = (int)v;
+  *p = q;
+  return 1;
+}
+
+CONJUNTO_NOMEADO *buscar_conjunto(CATALOGO *cat, const char *nome) {
+  for (size_t i = 0; i < cat->quantidade; i++)
+    if (strcmp(cat->conjuntos[i].nome, nome) == 0)
+      return &cat->conjuntos[i];
+  return NULL;
+}
+
+// Lê um nome e resolve o conjunto (com a trava já obtida), reportando o erro
+CONJUNTO_NOMEADO *ler_conjunto(COMANDOS *c, const char **p, const char *fim) {
+  char nome[COMANDOS_NOME_MAX];
+  if (ler_palavra(p, fim, nome, sizeof(nome)) == 0) {
+    erro_comando(c, "nome de conjunto ausente");
+    return NULL;
+  }
+  CONJUNTO_NOMEADO *e = buscar_conjunto(c->catalogo, nome);
+  if (!e)
+    erro_comando(c, "conjunto '%s' não existe", nome);
+  return e;
+}
+
+// Associa o conjunto ao nome, substituindo (e apagando) o anterior
+int guardar_conjunto(CATALOGO *cat, const char *nome, SET *set, int opt) {
+  CONJUNTO_NOMEADO *e = buscar_conjunto(cat, nome);
+  if (e) {
+    set_apagar(&e->set);
+  } else {
+    if (cat->quantidade == cat->capacidade) {
+      size_t nova = cat->capacidade ? cat->capacidade * 2 : 16;
+      CONJUNTO_NOMEADO *v = (CONJUNTO_NOMEADO *)realloc(
+          cat->conjuntos, nova * sizeof(CONJUNTO_NOMEADO));
+      if (!v)
+        return 0;
+      cat->conjuntos = v;
+      cat->capacidade = nova;
+    }
+    e = &cat->conjuntos[cat->quantidade++];
+    strcpy(e->nome, nome);
+  }
+  e->set = set;
+  e->opt = opt;
+  return 1;
+}
+
+int comparar_ordem(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/*
+    Consultas de um lote grande são ordenadas (valor com o bit de sinal
+    invertido nos 32 bits altos, posição original nos baixos) e respondidas
+    por um único iterador que só avança: cada busca continua de onde a
+    anterior parou, em vez de descer da raiz.
+*/
+void responder_pertence(COMANDOS *c, SET *set) {
+  if (c->n < PERTENCE_ORDENADO_MIN) {
+    for (size_t i = 0; i < c->n; i++)
+      c->respostas[i] = set_pertence(set, c->valores[i]) == 1;
+    return;
+  }
+
+  for (size_t i = 0; i < c->n; i++)
+    c->ordem[i] =
+        (uint64_t)((uint32_t)c->valores[i] ^ 0x80000000u) << 32 | i;
+  qsort(c->ordem, c->n, sizeof(uint64_t), comparar_ordem);
+
+  ITERADOR it;
+  int atual = 0, tem = 1, posicionado = 0;
+  set_iterador(set, &it);
+  for (size_t i = 0; i < c->n; i++) {
+    int v = (int)((uint32_t)(c->ordem[i] >> 32) ^ 0x80000000u);
+    if (tem && (!posicionado || atual < v)) {
+      tem = set_iterador_buscar(&it, v, &atual);
+      posicionado = 1;
+    }
+    c->respostas[(uint32_t)c->ordem[i]] = tem && atual == v;
+  }
+  iterador_finalizar(&it);
+}
+
+// Aplica um lote de inserções ou remoções; 0 em caso de falha
+int alterar_lote(COMANDOS *c, CONJUNTO_NOMEADO *e) {
+  if (c->lote == LOTE_INSERIR && e->opt != SET_CONGELADO &&
+      e->opt != SET_COMPRIMIDO && set_tamanho(e->set) == 0)
+    // Conjunto vazio: construção em lote, sem rebalanceamentos
+    return set_preencher(e->set, c->valores, c->n, 0) == 1;
+
+  // Valores em ordem crescente percorrem caminhos vizinhos da árvore
+  size_t n = c->n;
+  if (n >= ALTERACAO_ORDENADA_MIN && (n = ordenar_unicos(c->valores, n, 1)) == 0)
+    return 0;
+  for (size_t i = 0; i < n; i++)
+    if ((c->lote == LOTE_INSERIR ? set_inserir(e->set, c->valores[i])
+                                 : set_remover(e->set, c->valores[i])) < 0)
+      return 0;
+  // Sob a trava de escrita do catálogo ninguém mais lê o conjunto
+  if (c->lote == LOTE_REMOVER)
+    set_recolher(e->set);
+  return 1;
+}
+
+// Executa o lote pendente (se houver)
+void executar_lote(COMANDOS *c) {
+  if (c->lote == LOTE_NENHUM)
+    return;
+
+  CATALOGO *cat = c->catalogo;
+  int consulta = c->lote == LOTE_PERTENCE, ok;
+  c->resumo.lotes++;
+
+  if (consulta)
+    pthread_rwlock_rdlock(&cat->trava);
+  else
+    pthread_rwlock_wrlock(&cat->trava);
+  CONJUNTO_NOMEADO *e = buscar_conjunto(cat, c->nome);
+  if (consulta && e && e->opt == SET_SPLAY) {
+    // Consultas a uma splay reorganizam a árvore: só com a trava de escrita
+    pthread_rwlock_unlock(&cat->trava);
+    pthread_rwlock_wrlock(&cat->trava);
+    e = buscar_conjunto(cat, c->nome);
+  }
+  if (!e) {
+    ok = 0;
+  } else if (consulta) {
+    responder_pertence(c, e->set);
+    ok = 1;
+  } else {
+    ok = alterar_lote(c, e);
+  }
+  pthread_rwlock_unlock(&cat->trava);
+
+  if (!e)
+    erro_comando(c, "conjunto '%s' não existe", c->nome);
+  else if (!ok)
+    erro_comando(c, "falha ao alterar '%s'", c->nome);
+
+  // Respostas escritas fora da trava: a saída pode bloquear
+  size_t inicio = 0;
+  for (size_t k = 0; k < c->n_fins; k++) {
+    if (consulta && ok)
+      saida_escrever(c->saida, c->respostas + inicio, c->fins[k] - inicio);
+    saida_linha(c->saida);
+    inicio = c->fins[k];
+  }
+  // Linha longa ainda em andamento: continua no próximo lote
+  if (consulta && ok)
+    saida_escrever(c->saida, c->respostas + inicio, c->n - inicio);
+
+  c->lote = LOTE_NENHUM;
+  c->n = 0;
+  c->n_fins = 0;
+}
+
+// Anexa os valores da linha ao lote do mesmo tipo e conjunto
+void acumular_lote(COMANDOS *c, int tipo, const char **p, const char *fim) {
+  char nome[COMANDOS_NOME_MAX];
+  int responde = tipo == LOTE_PERTENCE || c->confirmar;
+
+  if (ler_palavra(p, fim, nome, sizeof(nome)) == 0) {
+    executar_lote(c);
+    erro_comando(c, "nome de conjunto ausente");
+    if (responde)
+      saida_linha(c->saida);
+    return;
+  }
+
+  // O conjunto só é resolvido quando o lote executa
+  if (c->lote != tipo || strcmp(c->nome, nome) != 0)
+    executar_lote(c);
+  c->lote = tipo;
+  strcpy(c->nome, nome);
+
+  int valor;
+  while (ler_inteiro(p, fim, &valor)) {
+    if (c->n == COMANDOS_LOTE_MAX) {
+      executar_lote(c);
+      c->lote = tipo;
+    }
+    c->valores[c->n++] = valor;
+    c->resumo.operacoes++;
+  }
+  pular_espacos(p, fim);
+  if (*p < fim)
+    erro_comando(c, "valor inválido");
+
+  if (responde) {
+    // Linhas sem valores também ocupam um lugar em `fins`
+    if (c->n_fins == COMANDOS_LOTE_MAX) {
+      executar_lote(c);
+      c->lote = tipo;
+    }
+    c->fins[c->n_fins++] = c->n;
+  }
+}
+
+// uniao/interseccao <destino> <a> <b> (com a trava de escrita)
+void executar_operacao(COMANDOS *c, int uniao, const char **p,
+                       const char *fim) {
+  char destino[COMANDOS_NOME_MAX];
+  if (ler_palavra(p, fim, destino, sizeof(destino)) == 0) {
+    erro_comando(c, "destino ausente");
+    return;
+  }
+  CONJUNTO_NOMEADO *a = ler_conjunto(c, p, fim);
+  CONJUNTO_NOMEADO *b = a ? ler_conjunto(c, p, fim) : NULL;
+  if (!b)
+    return;
+
+  SET *operandos[2] = {a->set, b->set};
+  int opt = a->opt;
+  SET *resultado = uniao ? set_uniao_k(operandos, 2)
+                         : set_interseccao_k(operandos, 2);
+  if (!resultado || !guardar_conjunto(c->catalogo, destino, resultado, opt)) {
+    set_apagar(&resultado);
+    erro_comando(c, "falha ao criar '%s'", destino);
+  }
+}
+
+// igual/subconjunto/disjuntos <a> <b>: respondem 1 ou 0
+int eh_predicado(const char *comando) {
+  return strcmp(comando, "igual") == 0 ||
+         strcmp(comando, "subconjunto") == 0 ||
+         strcmp(comando, "disjuntos") == 0;
+}
+
+// Comandos fora de lote; retorna 1 se o comando já escreveu a resposta
+int executar_comando(COMANDOS *c, const char *comando, const char **p,
+                     const char *fim) {
+  if (strcmp(comando, "tamanho") == 0) {
+    CONJUNTO_NOMEADO *e = ler_conjunto(c, p, fim);
+    if (e) {
+      size_t n = set_tamanho(e->set);
+      int v = n > INT_MAX ? INT_MAX : (int)n;
+      saida_escrever(c->saida, &v, 1);
+    }
+    saida_linha(c->saida);
+    return 1;
+  }
+  if (strcmp(comando, "imprimir") == 0) {
+    CONJUNTO_NOMEADO *e = ler_conjunto(c, p, fim);
+    if (e)
+      set_emitir(e->set, c->saida);
+    saida_linha(c->saida);
+    return 1;
+  }
+  if (eh_predicado(comando)) {
+    CONJUNTO_NOMEADO *a = ler_conjunto(c, p, fim);
+    CONJUNTO_NOMEADO *b = a ? ler_conjunto(c, p, fim) : NULL;
+    if (b) {
+      int v = comando[0] == 'i'   ? set_igual(a->set, b->set)
+              : comando[0] == 's' ? set_subconjunto(a->set, b->set)
+                                  : set_disjuntos(a->set, b->set);
+      saida_escrever(c->saida, &v, 1);
+    }
+    saida_linha(c->saida);
+    return 1;
+  }
+
+  if (strcmp(comando, "criar") == 0) {
+    char nome[COMANDOS_NOME_MAX];
+    int opt = SET_AVL;
+    if (ler_palavra(p, fim, nome, sizeof(nome)) == 0) {
+      erro_comando(c, "nome de conjunto ausente");
+      return 0;
+    }
+    if (buscar_conjunto(c->catalogo, nome)) {
+      erro_comando(c, "conjunto '%s' já existe", nome);
+      return 0;
+    }
+    pular_espacos(p, fim);
+    if (*p < fim && !ler_inteiro(p, fim, &opt)) {
+      erro_comando(c, "estrutura inválida");
+      return 0;
+    }
+    SET *set = criar_set(opt);
+    if (!set || !guardar_conjunto(c->catalogo, nome, set, opt)) {
+      set_apagar(&set);
+      erro_comando(c, "falha ao criar '%s'", nome);
+    }
+  } else if (strcmp(comando, "apagar") == 0) {
+    CONJUNTO_NOMEADO *e = ler_conjunto(c, p, fim);
+    if (e) {
+      set_apagar(&e->set);
+      *e = c->catalogo->conjuntos[--c->catalogo->quantidade];
+    }
+  } else if (strcmp(comando, "uniao") == 0) {
+    executar_operacao(c, 1, p, fim);
+  } else if (strcmp(comando, "interseccao") == 0) {
+    executar_operacao(c, 0, p, fim);
+  } else if (strcmp(comando, "congelar") == 0) {
+    CONJUNTO_NOMEADO *e = ler_conjunto(c, p, fim);
+    if (e && set_congelar(e->set) == 1)
+      e->opt = SET_CONGELADO;
+    else if (e)
+      erro_comando(c, "falha ao congelar '%s'", e->nome);
+  } else if (strcmp(comando, "converter") == 0) {
+    CONJUNTO_NOMEADO *e = ler_conjunto(c, p, fim);
+    int opt;
+    pular_espacos(p, fim);
+    if (e && !ler_inteiro(p, fim, &opt))
+      erro_comando(c, "estrutura inválida");
+    else if (e && set_converter(e->set, opt) == 1)
+      e->opt = opt;
+    else if (e)
+      erro_comando(c, "falha ao converter '%s'", e->nome);
+  } else if (strcmp(comando, "filtrar") == 0) {
+    CONJUNTO_NOMEADO *e = ler_conjunto(c, p, fim);
+    int ligar = 1;
+    pular_espacos(p, fim);
+    if (e && *p < fim && !ler_inteiro(p, fim, &ligar))
+      erro_comando(c, "opção inválida");
+    else if (e && set_filtrar(e->set, ligar) != 1)
+      erro_comando(c, "falha ao filtrar '%s'", e->nome);
+  } else {
+    erro_comando(c, "comando desconhecido '%s'", comando);
+  }
+  return 0;
+}
+
+void executar_linha(COMANDOS *c, const char *p, const char *fim) {
+  char comando[16];
+  c->linha++;
+  pular_espacos(&p, fim);
+  if (p == fim || *p == '#')
+    return;
+  ler_palavra(&p, fim, comando, sizeof(comando));
+  c->resumo.linhas++;
+
+  if (strcmp(comando, "inserir") == 0) {
+    acumular_lote(c, LOTE_INSERIR, &p, fim);
+    return;
+  }
+  if (strcmp(comando, "remover") == 0) {
+    acumular_lote(c, LOTE_REMOVER, &p, fim);
+    return;
+  }
+  if (strcmp(comando, "pertence") == 0) {
+    acumular_lote(c, LOTE_PERTENCE, &p, fim);
+    return;
+  }
+
+  // Demais comandos enxergam o efeito de todo o lote anterior
+  executar_lote(c);
+  c->resumo.operacoes++;
+
+  int leitura = strcmp(comando, "tamanho") == 0 ||
+                strcmp(comando, "imprimir") == 0 || eh_predicado(comando);
+  if (leitura)
+    pthread_rwlock_rdlock(&c->catalogo->trava);
+  else
+    pthread_rwlock_wrlock(&c->catalogo->trava);
+  int respondeu = executar_comando(c, comando, &p, fim);
+  pthread_rwlock_unlock(&c->catalogo->trava);
+
+  if (!respondeu && c->confirmar)
+    saida_linha(c->saida);
+}
+
+CATALOGO *catalogo_criar(void) {
+  CATALOGO *cat = (CATALOGO *)calloc(1, sizeof(CATALOGO));
+  if (cat && pthread_rwlock_init(&cat->trava, NULL) != 0) {
+    free(cat);
+    return NULL;
+  }
+  return cat;
+}
+
+void catalogo_apagar(CATALOGO **catalogo) {
+  if (!catalogo || !*catalogo)
+    return;
+  CATALOGO *cat = *catalogo;
+  for (size_t i = 0; i < cat->quantidade; i++)
+    set_apagar(&cat->conjuntos[i].set);
+  pthread_rwlock_destroy(&cat->trava);
+  free(cat->conjuntos);
+  free(cat);
+  *catalogo = NULL;
+}
+
+COMANDOS *comandos_criar(SAIDA *saida, CATALOGO *catalogo, int opcoes) {
+  if (!saida)
+    return NULL;
+  COMANDOS *c = (COMANDOS *)calloc(1, sizeof(COMANDOS));
+  if (!c)
+    return NULL;
+  c->saida = saida;
+  c->confirmar = (opcoes & COMANDOS_CONFIRMAR) != 0;
+  c->catalogo = catalogo;
+  if (!catalogo) {
+    c->catalogo = catalogo_criar();
+    c->proprio = 1;
+  }
+  c->valores = (int *)malloc(COMANDOS_LOTE_MAX * sizeof(int));
+  c->fins = (size_t *)malloc(COMANDOS_LOTE_MAX * sizeof(size_t));
+  c->respostas = (int *)malloc(COMANDOS_LOTE_MAX * sizeof(int));
+  c->ordem = (uint64_t *)malloc(COMANDOS_LOTE_MAX * sizeof(uint64_t));
+  if (!c->catalogo || !c->valores || !c->fins || !c->respostas || !c->ordem) {
+    comandos_apagar(&c);
+    return NULL;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &c->inicio);
+  return c;
+}
+
+size_t comandos_processar(COMANDOS *c, const char *dados, size_t n) {
+  if (!c || !dados)
+    return 0;
+  const char *p = dados, *fim = dados + n;
+  const char *quebra;
+  while (p < fim && (quebra = memchr(p, '\n', (size_t)(fim - p))) != NULL) {
+    executar_linha(c, p, quebra);
+    p = quebra + 1;
+  }
+  return (size_t)(p - dados);
+}
+
+int comandos_concluir(COMANDOS *c) {
+  if (!c)
+    return 0;
+  executar_lote(c);
+  return saida_finalizar(c->saida);
+}
+
+int comandos_executar(COMANDOS *c, FILE *entrada) {
+  if (!c || !entrada)
+    return 0;
+
+  size_t capacidade = COMANDOS_LEITURA, usado = 0, lidos;
+  char *buffer = (char *)malloc(capacidade);
+  if (!buffer)
+    return 0;
+
+  int ok = 1;
+  while ((lidos = fread(buffer + usado, 1, capacidade - usado, entrada)) > 0) {
+    usado += lidos;
+    size_t consumidos = comandos_processar(c, buffer, usado);
+    memmove(buffer, buffer + consumidos, usado - consumidos);
+    usado -= consumidos;
+
+    // Linha maior que o buffer inteiro
+    if (usado == capacidade) {
+      char *maior = (char *)realloc(buffer, capacidade * 2);
+      if (!maior) {
+        ok = 0;
+        break;
+      }
+      buffer = maior;
+      capacidade *= 2;
+    }
+  }
+  if (ferror(entrada))
+    ok = 0;
+
+  // Última linha sem quebra
+  if (ok && usado > 0)
+    executar_linha(c, buffer, buffer + usado);
+  free(buffer);
+
+  return comandos_concluir(c) && ok;
+}
+
+void comandos_resumo(COMANDOS *c, COMANDOS_RESUMO *resumo) {
+  if (!c || !resumo)
+    return;
+  struct timespec agora;
+  clock_gettime(CLOCK_MONOTONIC, &agora);
+  *resumo = c->resumo;
+  resumo->segundos = (double)(agora.tv_sec - c->inicio.tv_sec) +
+                     (double)(agora.tv_nsec - c->inicio.tv_nsec) / 1e9;
+}
+
+void comandos_apagar(COMANDOS **c) {
+  if (!c || !*c)
+    return;
+  if ((*c)->proprio)
+    catalogo_apagar(&(*c)->catalogo);
+  free((*c)->valores);
+  free((*c)->fins);
+  free((*c)->respostas);
+  free((*c)->ordem);
+  free(*c);
+  *c = NULL;
+}
@@ -0,0 +1,143 @@
+#ifndef COMANDOS_H
+#define COMANDOS_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "saida.h"
+#include "set.h"
+
+/*
+    Motor de comandos em texto, uma operação por linha:
+
+      criar <nome> [estrutura]      estrutura de criar_set() (padrão SET_AVL)
+      apagar <nome>
+      inserir <nome> <v> [v ...]
+      remover <nome> <v> [v ...]
+      pertence <nome> <v> [v ...]   responde "1"/"0" para cada valor
+      tamanho <nome>                responde a quantidade de elementos
+      imprimir <nome>               responde os elementos em ordem
+      uniao <destino> <a> <b>       cria (ou substitui) <destino>
+      interseccao <destino> <a> <b>
+      congelar <nome>
+      converter <nome> <estrutura>  troca a estrutura (ex.: 5, comprimido)
+      filtrar <nome> [0|1]          liga (padrão) ou desliga o pré-filtro
+      igual <a> <b>                 responde "1"/"0" (também subconjunto,
+      subconjunto <a> <b>           a ⊆ b, e disjuntos)
+      disjuntos <a> <b>
+
+    Linhas vazias ou iniciadas por '#' são ignoradas. Cada comando que
+    responde ocupa exatamente uma linha da saída (vazia em caso de erro);
+    os erros são descritos em stderr.
+*/
+typedef struct comandos COMANDOS;
+
+// Conjuntos nomeados, que podem ser compartilhados por vários motores.
+typedef struct catalogo CATALOGO;
+
+// Opção de comandos_criar(): toda linha de comando recebe uma linha de
+// resposta (vazia para os comandos que não respondem), para clientes que
+// enviam vários pedidos sem esperar (pipeline) e casam as respostas.
+#define COMANDOS_CONFIRMAR 1
+
+/**
+ * @brief Contadores de uma execução do motor.
+ */
+typedef struct comandos_resumo {
+  size_t linhas;     /**< Linhas de comando processadas. */
+  size_t operacoes;  /**< Operações (cada valor de inserir/remover/pertence
+                          conta uma). */
+  size_t lotes;      /**< Lotes executados. */
+  size_t erros;      /**< Comandos recusados. */
+  double segundos;   /**< Tempo desde a criação do motor. */
+} COMANDOS_RESUMO;
+
+/**
+ * @brief Cria um catálogo vazio de conjuntos nomeados.
+ *
+ * O catálogo tem uma trava de leitura/escrita: motores em threads diferentes
+ * podem usá-lo ao mesmo tempo (consultas em paralelo, alterações uma por vez).
+ *
+ * @return Ponteiro para o catálogo ou NULL em caso de erro.
+ */
+CATALOGO *catalogo_criar(void);
+
+/**
+ * @brief Libera o catálogo e todos os seus conjuntos.
+ *
+ * Nenhum motor pode estar usando o catálogo.
+ *
+ * @param catalogo Endereço do ponteiro para o catálogo. Após a execução, o
+ * ponteiro será definido como NULL.
+ */
+void catalogo_apagar(CATALOGO **catalogo);
+
+/**
+ * @brief Cria um motor de comandos.
+ *
+ * Linhas seguidas do mesmo comando sobre o mesmo conjunto (inserir, remover
+ * ou pertence) são agrupadas em um lote e executadas juntas: inserções em
+ * conjunto vazio viram uma construção em lote (set_preencher()); as demais
+ * são ordenadas antes, para que nós vizinhos sejam visitados em sequência.
+ *
+ * @param saida Saída das respostas (normalmente saida_arquivo() ou
+ *              saida_descritor()); continua sendo do chamador.
+ * @param catalogo Catálogo compartilhado, ou NULL para um catálogo próprio
+ *                 (liberado junto com o motor).
+ * @param opcoes 0 ou COMANDOS_CONFIRMAR.
+ * @return Ponteiro para o motor ou NULL em caso de erro.
+ */
+COMANDOS *comandos_criar(SAIDA *saida, CATALOGO *catalogo, int opcoes);
+
+/**
+ * @brief Processa as linhas completas de um trecho de texto.
+ *
+ * Feito para entrada em pedaços (arquivo, socket): só linhas terminadas em
+ * '\n' são consumidas, e o restante deve ser reapresentado na próxima chamada
+ * junto com os dados seguintes. Respostas podem ficar retidas no lote
+ * pendente até comandos_concluir().
+ *
+ * @param c Ponteiro para o motor.
+ * @param dados Texto recebido.
+ * @param n Quantidade de bytes de `dados`.
+ * @return Quantidade de bytes consumidos.
+ */
+size_t comandos_processar(COMANDOS *c, const char *dados, size_t n);
+
+/**
+ * @brief Executa o lote pendente e despeja a saída.
+ *
+ * @param c Ponteiro para o motor.
+ * @return 1 em caso de sucesso, 0 em caso de erro de escrita.
+ */
+int comandos_concluir(COMANDOS *c);
+
+/**
+ * @brief Lê e executa todos os comandos de um arquivo até o fim.
+ *
+ * Uma última linha sem '\n' também é executada. Ao final chama
+ * comandos_concluir().
+ *
+ * @param c Ponteiro para o motor.
+ * @param entrada Arquivo aberto para leitura (ex.: stdin).
+ * @return 1 em caso de sucesso, 0 em caso de erro de leitura ou escrita.
+ */
+int comandos_executar(COMANDOS *c, FILE *entrada);
+
+/**
+ * @brief Lê os contadores do motor.
+ *
+ * @param c Ponteiro para o motor.
+ * @param resumo Recebe os contadores.
+ */
+void comandos_resumo(COMANDOS *c, COMANDOS_RESUMO *resumo);
+
+/**
+ * @brief Libera o motor (e o catálogo, se for próprio).
+ *
+ * @param c Endereço do ponteiro para o motor. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void comandos_apagar(COMANDOS **c);
+
+#endif // COMANDOS_H
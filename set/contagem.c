@@ -0,0 +1,61 @@
+#include <stdint.h>
+
+#include "contagem.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Protocolo das Funções
+
+// Principais
+size_t contar_comuns_blocos(const int *a, size_t *ia, size_t na,
+                            const int *b, size_t *ib, size_t nb);
+
+/*
+    Intersecção por blocos (Schlegel et al.; Lemire et al.): cada chave de
+    `a` aparece no máximo uma vez em `b`, então o OU das quatro comparações
+    (bloco de `b` girado 0, 1, 2 e 3 posições) tem um bit por chave de `a`
+    encontrada, e a contagem é o popcount da máscara. Um bloco só é
+    descartado quando seu máximo não passa do máximo do outro: nenhuma chave
+    dele pode aparecer mais adiante no outro trecho.
+*/
+size_t contar_comuns_blocos(const int *a, size_t *ia, size_t na,
+                            const int *b, size_t *ib, size_t nb) {
+  size_t i = *ia, j = *ib, total = 0;
+#ifdef __SSE2__
+  while (i + 4 <= na && j + 4 <= nb) {
+    __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+    __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+    __m128i iguais = _mm_cmpeq_epi32(va, vb);
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    iguais = _mm_or_si128(iguais, _mm_cmpeq_epi32(va, vb));
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    iguais = _mm_or_si128(iguais, _mm_cmpeq_epi32(va, vb));
+    vb = _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1));
+    iguais = _mm_or_si128(iguais, _mm_cmpeq_epi32(va, vb));
+    total += (size_t)__builtin_popcount(
+        (unsigned)_mm_movemask_ps(_mm_castsi128_ps(iguais)));
+
+    int maior_a = a[i + 3], maior_b = b[j + 3];
+    i += (size_t)(maior_a <= maior_b) * 4;
+    j += (size_t)(maior_b <= maior_a) * 4;
+  }
+#else
+  // Sem SSE2: intercalação comum, com o mesmo ponto de parada
+  while (i + 4 <= na && j + 4 <= nb) {
+    if (a[i] < b[j]) {
+      i++;
+    } else if (a[i] > b[j]) {
+      j++;
+    } else {
+      total++;
+      i++;
+      j++;
+    }
+  }
+#endif
+  *ia = i;
+  *ib = j;
+  return total;
+}
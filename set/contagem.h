@@ -0,0 +1,26 @@
+#ifndef CONTAGEM_H
+#define CONTAGEM_H
+
+#include <stddef.h>
+
+/**
+ * @brief Conta as chaves comuns a dois trechos ordenados, de 4 em 4.
+ *
+ * Compara cada bloco de 4 chaves de `a` com o bloco de 4 de `b` em todas as
+ * rotações (SSE2, quando disponível) e avança o bloco de menor máximo (ou
+ * os dois, se os máximos forem iguais). Para quando algum dos trechos tem
+ * menos de 4 chaves restantes, deixando o resto para o chamador (que pode
+ * completar o trecho e chamar de novo).
+ *
+ * @param a Chaves em ordem estritamente crescente.
+ * @param ia Posição inicial em `a`; recebe a posição onde parou.
+ * @param na Quantidade de chaves de `a`.
+ * @param b Chaves em ordem estritamente crescente.
+ * @param ib Posição inicial em `b`; recebe a posição onde parou.
+ * @param nb Quantidade de chaves de `b`.
+ * @return Quantidade de chaves comuns entre as posições consumidas.
+ */
+size_t contar_comuns_blocos(const int *a, size_t *ia, size_t na,
+                            const int *b, size_t *ib, size_t nb);
+
+#endif // CONTAGEM_H
@@ -0,0 +1,166 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esboco.h"
+
+#define ESBOCO_REGISTRADORES (1 << ESBOCO_BITS)
+
+// Faixa MinHash ainda vazia
+#define ESBOCO_VAZIO UINT64_MAX
+
+typedef struct esboco {
+  uint8_t registradores[ESBOCO_REGISTRADORES]; // HyperLogLog
+  uint64_t minimos[ESBOCO_FAIXAS];             // MinHash
+  size_t adicionadas; // Desde a criação, incluindo repetidas e removidas
+  size_t removidas;
+} ESBOCO;
+
+// Protocolo das Funções
+
+// Auxiliares
+uint64_t misturar_esboco(uint64_t x);
+double estimar_registradores(const uint8_t *registradores);
+
+// Principais
+ESBOCO *esboco_criar(void);
+void esboco_adicionar(ESBOCO *e, int chave);
+void esboco_remover(ESBOCO *e);
+int esboco_saturado(const ESBOCO *e);
+void esboco_limpar(ESBOCO *e);
+void esboco_juntar(ESBOCO *e, const ESBOCO *outro);
+double esboco_uniao(const ESBOCO *const *esbocos, size_t k);
+double esboco_jaccard(const ESBOCO *const *esbocos, size_t k);
+void esboco_apagar(ESBOCO **e);
+
+// Finalizador do splitmix64
+uint64_t misturar_esboco(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+/*
+    Estimador do HyperLogLog: média harmônica de 2^registrador, corrigida
+    pela constante alfa. Com poucas chaves (estimativa até 2.5 m e algum
+    registrador zerado) a contagem linear dos registradores zerados é mais
+    precisa. Com hash de 64 bits não há correção para cardinalidades
+    grandes.
+*/
+double estimar_registradores(const uint8_t *registradores) {
+  // Soma de 2^-r em ponto fixo (2^50 = 1): só deslocamentos e adições
+  // inteiras independentes, sem divisões nem cadeia de somas em double
+  uint64_t soma = 0;
+  size_t zerados = 0;
+  for (size_t j = 0; j < ESBOCO_REGISTRADORES; j++) {
+    soma += (1ULL << 50) >> registradores[j];
+    zerados += registradores[j] == 0;
+  }
+
+  double m = (double)ESBOCO_REGISTRADORES;
+  double alfa = 0.7213 / (1.0 + 1.079 / m);
+  double estimativa = alfa * m * m / ((double)soma / (double)(1ULL << 50));
+  if (estimativa <= 2.5 * m && zerados > 0)
+    estimativa = m * log(m / (double)zerados);
+  return estimativa;
+}
+
+ESBOCO *esboco_criar(void) {
+  ESBOCO *e = (ESBOCO *)malloc(sizeof(ESBOCO));
+  if (e)
+    esboco_limpar(e);
+  return e;
+}
+
+void esboco_adicionar(ESBOCO *e, int chave) {
+  uint64_t h = misturar_esboco((uint64_t)(uint32_t)chave);
+  // Os ESBOCO_BITS altos escolhem o registrador; o resto guarda a posição
+  // do primeiro bit 1 (o bit de guarda limita a contagem)
+  size_t j = (size_t)(h >> (64 - ESBOCO_BITS));
+  uint64_t resto = (h << ESBOCO_BITS) | (1ULL << (ESBOCO_BITS - 1));
+  uint8_t posicao = (uint8_t)(__builtin_clzll(resto) + 1);
+  if (posicao > e->registradores[j])
+    e->registradores[j] = posicao;
+
+  uint64_t g = misturar_esboco(h);
+  size_t faixa = (size_t)(((g >> 32) * ESBOCO_FAIXAS) >> 32);
+  if (g < e->minimos[faixa])
+    e->minimos[faixa] = g;
+  e->adicionadas++;
+}
+
+void esboco_remover(ESBOCO *e) { e->removidas++; }
+
+int esboco_saturado(const ESBOCO *e) {
+  return e->removidas * ESBOCO_TOLERANCIA > e->adicionadas;
+}
+
+void esboco_limpar(ESBOCO *e) {
+  memset(e->registradores, 0, sizeof(e->registradores));
+  for (size_t i = 0; i < ESBOCO_FAIXAS; i++)
+    e->minimos[i] = ESBOCO_VAZIO;
+  e->adicionadas = 0;
+  e->removidas = 0;
+}
+
+void esboco_juntar(ESBOCO *e, const ESBOCO *outro) {
+  for (size_t j = 0; j < ESBOCO_REGISTRADORES; j++) {
+    uint8_t r = outro->registradores[j];
+    e->registradores[j] = r > e->registradores[j] ? r : e->registradores[j];
+  }
+  for (size_t i = 0; i < ESBOCO_FAIXAS; i++)
+    if (outro->minimos[i] < e->minimos[i])
+      e->minimos[i] = outro->minimos[i];
+  e->adicionadas += outro->adicionadas;
+  e->removidas += outro->removidas;
+}
+
+double esboco_uniao(const ESBOCO *const *esbocos, size_t k) {
+  if (!esbocos || k == 0)
+    return 0.0;
+  uint8_t juntos[ESBOCO_REGISTRADORES];
+  memcpy(juntos, esbocos[0]->registradores, sizeof(juntos));
+  // Máximo sem desvio, que o compilador vetoriza
+  for (size_t i = 1; i < k; i++) {
+    const uint8_t *r = esbocos[i]->registradores;
+    for (size_t j = 0; j < ESBOCO_REGISTRADORES; j++)
+      juntos[j] = r[j] > juntos[j] ? r[j] : juntos[j];
+  }
+  return estimar_registradores(juntos);
+}
+
+/*
+    Numa faixa onde algum conjunto tem chave, o menor hash da união está em
+    todos os conjuntos exatamente quando é o menor de cada um: a fração de
+    faixas em que os k mínimos coincidem estima |∩| / |∪|. Faixas vazias em
+    todos não dizem nada e ficam de fora.
+*/
+double esboco_jaccard(const ESBOCO *const *esbocos, size_t k) {
+  if (!esbocos || k == 0)
+    return 0.0;
+  size_t iguais = 0, usadas = 0;
+  for (size_t f = 0; f < ESBOCO_FAIXAS; f++) {
+    uint64_t menor = esbocos[0]->minimos[f], maior = menor;
+    for (size_t i = 1; i < k; i++) {
+      uint64_t v = esbocos[i]->minimos[f];
+      if (v < menor)
+        menor = v;
+      if (v > maior)
+        maior = v;
+    }
+    if (menor == ESBOCO_VAZIO)
+      continue;
+    usadas++;
+    iguais += menor == maior;
+  }
+  return usadas ? (double)iguais / (double)usadas : 1.0;
+}
+
+void esboco_apagar(ESBOCO **e) {
+  if (!e || !*e)
+    return;
+  free(*e);
+  *e = NULL;
+}
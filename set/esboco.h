@@ -0,0 +1,104 @@
+#ifndef ESBOCO_H
+#define ESBOCO_H
+
+#include <stddef.h>
+
+/*
+    Esboço de cardinalidade de um conjunto: um HyperLogLog com
+    2^ESBOCO_BITS registradores e uma assinatura MinHash de ESBOCO_FAIXAS
+    faixas (uma permutação só: a faixa de cada chave é escolhida pelo hash e
+    cada faixa guarda o menor hash que recebeu). Os dois aceitam novas
+    chaves em O(1) e se juntam registrador a registrador, então o esboço de
+    uma união é a junção dos esboços, sem tocar nos elementos.
+
+    Erros típicos (um desvio padrão):
+      - cardinalidade (HyperLogLog): 1.04 / sqrt(2^ESBOCO_BITS) ~ 1.6%;
+      - Jaccard J (MinHash): sqrt(J (1 - J) / ESBOCO_FAIXAS) <= 3.1%;
+      - intersecção: J estimado vezes a união estimada, erro relativo ~
+        3.1% / J + 1.6% (ruim para intersecções muito menores que a
+        união).
+*/
+typedef struct esboco ESBOCO;
+
+#define ESBOCO_BITS 12    // log2 dos registradores do HyperLogLog
+#define ESBOCO_FAIXAS 256 // Faixas da assinatura MinHash
+#define ESBOCO_TOLERANCIA 32 // Reconstrói com 1/32 das chaves removidas
+
+/**
+ * @brief Cria um esboço vazio.
+ *
+ * @return Ponteiro para o esboço ou NULL em caso de erro.
+ */
+ESBOCO *esboco_criar(void);
+
+/**
+ * @brief Acrescenta uma chave ao esboço (repetições não mudam nada).
+ *
+ * @param e Ponteiro para o esboço.
+ * @param chave Chave acrescentada.
+ */
+void esboco_adicionar(ESBOCO *e, int chave);
+
+/**
+ * @brief Registra que uma chave saiu do conjunto.
+ *
+ * O esboço não consegue esquecer a chave; só conta a remoção para
+ * esboco_saturado().
+ *
+ * @param e Ponteiro para o esboço.
+ */
+void esboco_remover(ESBOCO *e);
+
+/**
+ * @brief Informa se as remoções acumuladas pedem uma reconstrução.
+ *
+ * Satura quando mais de 1/ESBOCO_TOLERANCIA das chaves recebidas já foram
+ * removidas; até lá as estimativas exageram no máximo essa fração.
+ *
+ * @param e Ponteiro para o esboço.
+ * @return 1 se a reconstrução é recomendada, 0 caso contrário.
+ */
+int esboco_saturado(const ESBOCO *e);
+
+/**
+ * @brief Esvazia o esboço.
+ *
+ * @param e Ponteiro para o esboço.
+ */
+void esboco_limpar(ESBOCO *e);
+
+/**
+ * @brief Junta o esboço `outro` em `e` (e passa a representar a união).
+ *
+ * @param e Ponteiro para o esboço que recebe a junção.
+ * @param outro Ponteiro para o esboço juntado (não é modificado).
+ */
+void esboco_juntar(ESBOCO *e, const ESBOCO *outro);
+
+/**
+ * @brief Estima a quantidade de chaves distintas da união de k esboços.
+ *
+ * @param esbocos Vetor de ponteiros para os esboços.
+ * @param k Quantidade de esboços.
+ * @return Cardinalidade estimada.
+ */
+double esboco_uniao(const ESBOCO *const *esbocos, size_t k);
+
+/**
+ * @brief Estima a similaridade de Jaccard |∩| / |∪| de k esboços.
+ *
+ * @param esbocos Vetor de ponteiros para os esboços.
+ * @param k Quantidade de esboços.
+ * @return Similaridade estimada, entre 0 e 1 (1 se todos forem vazios).
+ */
+double esboco_jaccard(const ESBOCO *const *esbocos, size_t k);
+
+/**
+ * @brief Libera o esboço.
+ *
+ * @param e Endereço do ponteiro para o esboço. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void esboco_apagar(ESBOCO **e);
+
+#endif // ESBOCO_H
@@ -0,0 +1,53 @@
+#include "estatisticas.h"
+
+#ifdef SET_ESTATISTICAS
+_Thread_local ESTATISTICAS *estatisticas_atual = NULL;
+_Thread_local uint64_t estatisticas_caminho = 0;
+#endif
+
+// Protocolo das Funções
+
+void estatisticas_iniciar(ESTATISTICAS *e);
+void estatisticas_copiar(ESTATISTICAS *e, struct set_stats *saida);
+void estatisticas_registrar_altura(ESTATISTICAS *e, uint64_t altura);
+
+void estatisticas_iniciar(ESTATISTICAS *e) {
+  atomic_init(&e->comparacoes, 0);
+  atomic_init(&e->nos_visitados, 0);
+  atomic_init(&e->rotacoes_simples, 0);
+  atomic_init(&e->rotacoes_duplas, 0);
+  atomic_init(&e->mudancas_posto, 0);
+  atomic_init(&e->rotacoes_llrb, 0);
+  atomic_init(&e->trocas_cor, 0);
+  atomic_init(&e->movimentos_red, 0);
+  atomic_init(&e->alocacoes, 0);
+  atomic_init(&e->liberacoes, 0);
+  atomic_init(&e->bytes_vivos, 0);
+  atomic_init(&e->altura_max, 0);
+}
+
+void estatisticas_copiar(ESTATISTICAS *e, struct set_stats *saida) {
+  saida->comparacoes = atomic_load(&e->comparacoes);
+  saida->nos_visitados = atomic_load(&e->nos_visitados);
+  saida->rotacoes_simples = atomic_load(&e->rotacoes_simples);
+  saida->rotacoes_duplas = atomic_load(&e->rotacoes_duplas);
+  saida->mudancas_posto = atomic_load(&e->mudancas_posto);
+  saida->rotacoes_llrb = atomic_load(&e->rotacoes_llrb);
+  saida->trocas_cor = atomic_load(&e->trocas_cor);
+  saida->movimentos_red = atomic_load(&e->movimentos_red);
+  saida->alocacoes = atomic_load(&e->alocacoes);
+  saida->liberacoes = atomic_load(&e->liberacoes);
+  saida->bytes_vivos = atomic_load(&e->bytes_vivos);
+}
+
+// Máximo atômico: só escreve se a altura nova for maior
+void estatisticas_registrar_altura(ESTATISTICAS *e, uint64_t altura) {
+  if (e == NULL)
+    return;
+  uint64_t atual = atomic_load_explicit(&e->altura_max, memory_order_relaxed);
+  while (altura > atual &&
+         !atomic_compare_exchange_weak_explicit(&e->altura_max, &atual, altura,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed))
+    ;
+}
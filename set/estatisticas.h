@@ -0,0 +1,140 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Contadores estruturais de um conjunto (ver set_estatisticas()).
+ *
+ * Os contadores cobrem inserção, remoção, busca e construção em lote. Só são
+ * registrados quando o projeto é compilado com -DSET_ESTATISTICAS
+ * (`make ESTATISTICAS=1`); sem a flag, as macros abaixo somem do código.
+ */
+struct set_stats {
+  uint64_t comparacoes;      /**< Comparações entre chaves. */
+  uint64_t nos_visitados;    /**< Nós percorridos pelas operações. */
+  uint64_t rotacoes_simples; /**< AVL, WAVL e splay: rotações simples. */
+  uint64_t rotacoes_duplas;  /**< AVL e WAVL: rotações duplas. */
+  uint64_t mudancas_posto;   /**< WAVL: promoções e rebaixamentos. */
+  uint64_t rotacoes_llrb;    /**< LLRB: rotações à esquerda ou à direita. */
+  uint64_t trocas_cor;       /**< LLRB: chamadas a troca_cor(). */
+  uint64_t movimentos_red;   /**< LLRB: move2_esq_red() e move2_dir_red(). */
+  uint64_t alocacoes;        /**< Nós alocados. */
+  uint64_t liberacoes;       /**< Nós liberados. */
+  uint64_t bytes_vivos;      /**< Bytes ocupados pelos nós ainda alocados. */
+  uint64_t altura_atual;     /**< Altura atual (calculada na consulta). */
+  uint64_t altura_max;       /**< Maior altura já observada. */
+};
+
+/**
+ * @brief Contadores internos de um conjunto.
+ *
+ * Atômicos porque a skip list aceita escritas de várias threads ao mesmo
+ * tempo; os incrementos são relaxados.
+ */
+typedef struct estatisticas {
+  _Atomic uint64_t comparacoes;
+  _Atomic uint64_t nos_visitados;
+  _Atomic uint64_t rotacoes_simples;
+  _Atomic uint64_t rotacoes_duplas;
+  _Atomic uint64_t mudancas_posto;
+  _Atomic uint64_t rotacoes_llrb;
+  _Atomic uint64_t trocas_cor;
+  _Atomic uint64_t movimentos_red;
+  _Atomic uint64_t alocacoes;
+  _Atomic uint64_t liberacoes;
+  _Atomic uint64_t bytes_vivos;
+  _Atomic uint64_t altura_max;
+} ESTATISTICAS;
+
+/**
+ * @brief Zera os contadores.
+ *
+ * @param e Ponteiro para os contadores.
+ */
+void estatisticas_iniciar(ESTATISTICAS *e);
+
+/**
+ * @brief Copia os contadores para a estrutura pública.
+ *
+ * @param e Ponteiro para os contadores.
+ * @param saida Estrutura que recebe os valores (as alturas não são tocadas).
+ */
+void estatisticas_copiar(ESTATISTICAS *e, struct set_stats *saida);
+
+/**
+ * @brief Registra uma altura observada, mantendo a maior.
+ *
+ * @param e Ponteiro para os contadores (NULL é ignorado).
+ * @param altura Altura observada.
+ */
+void estatisticas_registrar_altura(ESTATISTICAS *e, uint64_t altura);
+
+#ifdef SET_ESTATISTICAS
+
+// Contadores do conjunto em operação nesta thread (ligados pelo set.c)
+extern _Thread_local ESTATISTICAS *estatisticas_atual;
+
+// Nós visitados na operação corrente desta thread
+extern _Thread_local uint64_t estatisticas_caminho;
+
+#define ESTAT_CONTAR(campo, q)                                                 \
+  (estatisticas_atual                                                          \
+       ? (void)atomic_fetch_add_explicit(&estatisticas_atual->campo,           \
+                                        (uint64_t)(q), memory_order_relaxed)   \
+       : (void)0)
+
+#define ESTAT_DESCONTAR(campo, q)                                              \
+  (estatisticas_atual                                                          \
+       ? (void)atomic_fetch_sub_explicit(&estatisticas_atual->campo,           \
+                                        (uint64_t)(q), memory_order_relaxed)   \
+       : (void)0)
+
+// Conta uma comparação e devolve o seu resultado
+#define ESTAT_CMP(c) (ESTAT_CONTAR(comparacoes, 1), (c))
+
+#define ESTAT_VISITAR()                                                        \
+  do {                                                                         \
+    estatisticas_caminho++;                                                    \
+    ESTAT_CONTAR(nos_visitados, 1);                                            \
+  } while (0)
+
+#define ESTAT_ALOCAR(bytes)                                                    \
+  do {                                                                         \
+    ESTAT_CONTAR(alocacoes, 1);                                                \
+    ESTAT_CONTAR(bytes_vivos, bytes);                                          \
+  } while (0)
+
+#define ESTAT_LIBERAR(bytes)                                                   \
+  do {                                                                         \
+    ESTAT_CONTAR(liberacoes, 1);                                               \
+    ESTAT_DESCONTAR(bytes_vivos, bytes);                                       \
+  } while (0)
+
+#define ESTAT_CAMINHO_INICIAR() (estatisticas_caminho = 0)
+#define ESTAT_CAMINHO() (estatisticas_caminho)
+#define ESTAT_ALTURA(h) estatisticas_registrar_altura(estatisticas_atual, (h))
+
+// Liga a thread aos contadores de um conjunto (NULL desliga)
+#define ESTAT_ATUAL() (estatisticas_atual)
+#define ESTAT_USAR(e) (estatisticas_atual = (e))
+
+#else
+
+#define ESTAT_CONTAR(campo, q) ((void)0)
+#define ESTAT_DESCONTAR(campo, q) ((void)0)
+#define ESTAT_CMP(c) (c)
+#define ESTAT_VISITAR() ((void)0)
+#define ESTAT_ALOCAR(bytes) ((void)0)
+#define ESTAT_LIBERAR(bytes) ((void)0)
+#define ESTAT_CAMINHO_INICIAR() ((void)0)
+#define ESTAT_CAMINHO() 0
+#define ESTAT_ALTURA(h) ((void)0)
+#define ESTAT_ATUAL() NULL
+#define ESTAT_USAR(e) ((void)0)
+
+#endif // SET_ESTATISTICAS
+
+#endif // ESTATISTICAS_H
@@ -0,0 +1,305 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "estatisticas.h"
+#include "executor.h"
+#include "ordenacao.h"
+
+// Capacidade inicial de cada fila
+#define EXECUTOR_FILA_INICIAL 64
+
+/*
+    Fila dupla de tarefas pendentes, protegida por uma trava própria. A dona
+    usa o fim e as ladras o início; as tarefas ficam em [ini, fim). Uma
+    tarefa só sai da fila sob a trava, já marcada como TAREFA_RODANDO (ou
+    cancelada), então ninguém mais a toca depois que ela é cancelada.
+*/
+typedef struct fila {
+  pthread_mutex_t trava;
+  TAREFA **itens;
+  size_t ini, fim, capacidade;
+} FILA;
+
+typedef struct executor {
+  int threads;           // Trabalhadoras previstas; a i-ésima usa a fila i
+  int criadas;           // Trabalhadoras que de fato existem
+  FILA *filas;           // threads + 1 filas; a de índice 0 é a de entrada
+  pthread_mutex_t trava; // Protege `versao`
+  pthread_cond_t sinal;
+  uint64_t versao; // Muda a cada tarefa lançada, concluída ou cancelada
+} EXECUTOR;
+
+static EXECUTOR executor;
+static pthread_once_t executor_iniciado = PTHREAD_ONCE_INIT;
+
+// Fila da trabalhadora atual (-1 fora do grupo)
+static _Thread_local int fila_atual = -1;
+
+typedef struct paralelo {
+  void (*executar)(void *ctx, size_t i);
+  void *ctx;
+} PARALELO;
+
+typedef struct parte_paralelo {
+  TAREFA tarefa;
+  PARALELO *p;
+  size_t i;
+} PARTE_PARALELO;
+
+// Protocolo das Funções
+
+// Auxiliares
+void iniciar_executor(void);
+void *trabalhadora_executor(void *arg);
+int empilhar_fila(FILA *f, TAREFA *t);
+TAREFA *retirar_fila(FILA *f, int do_fim);
+int tomar_tarefa(TAREFA *t, int novo_estado);
+void rodar_tarefa(TAREFA *t);
+void avisar_executor(void);
+int executar_alguma(int propria);
+void executar_parte(void *arg);
+
+// Principais
+void tarefa_iniciar(TAREFA *t, void (*executar)(void *arg), void *arg);
+void tarefa_lancar(TAREFA *t);
+int tarefa_concluida(TAREFA *t);
+void tarefa_esperar(TAREFA *t);
+int tarefa_cancelar(TAREFA *t);
+void executor_paralelo(size_t n, void (*executar)(void *ctx, size_t i),
+                       void *ctx);
+int executor_threads(void);
+
+void iniciar_executor(void) {
+  static FILA entrada;
+
+  pthread_mutex_init(&executor.trava, NULL);
+  pthread_cond_init(&executor.sinal, NULL);
+  executor.threads = ordenacao_threads(0);
+  executor.filas = (FILA *)calloc((size_t)executor.threads + 1, sizeof(FILA));
+  if (!executor.filas) {
+    // Sem grupo: só a fila de entrada, que as próprias esperas esvaziam
+    executor.filas = &entrada;
+    executor.threads = 0;
+  }
+  for (int i = 0; i <= executor.threads; i++)
+    pthread_mutex_init(&executor.filas[i].trava, NULL);
+
+  // Se faltarem threads, as filas das que não nasceram ficam sempre vazias
+  for (int i = 1; i <= executor.threads; i++) {
+    pthread_t id;
+    if (pthread_create(&id, NULL, trabalhadora_executor,
+                       (void *)(intptr_t)i) != 0)
+      break;
+    pthread_detach(id);
+    executor.criadas++;
+  }
+}
+
+void *trabalhadora_executor(void *arg) {
+  fila_atual = (int)(intptr_t)arg;
+  for (;;) {
+    pthread_mutex_lock(&executor.trava);
+    uint64_t vista = executor.versao;
+    pthread_mutex_unlock(&executor.trava);
+
+    if (executar_alguma(fila_atual))
+      continue;
+
+    // Nada em nenhuma fila: dorme até alguém lançar ou concluir algo
+    pthread_mutex_lock(&executor.trava);
+    while (executor.versao == vista)
+      pthread_cond_wait(&executor.sinal, &executor.trava);
+    pthread_mutex_unlock(&executor.trava);
+  }
+  return NULL;
+}
+
+int empilhar_fila(FILA *f, TAREFA *t) {
+  if (f->fim == f->capacidade) {
+    if (f->ini > 0) {
+      // Reaproveita o espaço deixado pelos roubos
+      memmove(f->itens, f->itens + f->ini,
+              (f->fim - f->ini) * sizeof(TAREFA *));
+      f->fim -= f->ini;
+      f->ini = 0;
+    } else {
+      size_t nova = f->capacidade ? 2 * f->capacidade : EXECUTOR_FILA_INICIAL;
+      TAREFA **itens = (TAREFA **)realloc(f->itens, nova * sizeof(TAREFA *));
+      if (!itens)
+        return 0;
+      f->itens = itens;
+      f->capacidade = nova;
+    }
+  }
+  f->itens[f->fim++] = t;
+  return 1;
+}
+
+// Retira e marca como TAREFA_RODANDO a tarefa do fim ou do início
+TAREFA *retirar_fila(FILA *f, int do_fim) {
+  TAREFA *t = NULL;
+  pthread_mutex_lock(&f->trava);
+  if (f->ini < f->fim) {
+    t = do_fim ? f->itens[--f->fim] : f->itens[f->ini++];
+    if (f->ini == f->fim)
+      f->ini = f->fim = 0;
+    atomic_store(&t->estado, TAREFA_RODANDO);
+  }
+  pthread_mutex_unlock(&f->trava);
+  return t;
+}
+
+// Tira uma tarefa ainda pendente do meio da sua fila (1 se conseguiu)
+int tomar_tarefa(TAREFA *t, int novo_estado) {
+  if (atomic_load(&t->estado) != TAREFA_PENDENTE)
+    return 0;
+  FILA *f = &executor.filas[t->fila];
+  int tomada = 0;
+  pthread_mutex_lock(&f->trava);
+  if (atomic_load(&t->estado) == TAREFA_PENDENTE) {
+    for (size_t i = f->fim; i > f->ini; i--) {
+      if (f->itens[i - 1] == t) {
+        memmove(f->itens + i - 1, f->itens + i,
+                (f->fim - i) * sizeof(TAREFA *));
+        f->fim--;
+        if (f->ini == f->fim)
+          f->ini = f->fim = 0;
+        break;
+      }
+    }
+    atomic_store(&t->estado, novo_estado);
+    tomada = 1;
+  }
+  pthread_mutex_unlock(&f->trava);
+  return tomada;
+}
+
+// Executa uma tarefa já retirada da fila e avisa quem espera
+void rodar_tarefa(TAREFA *t) {
+  // A tarefa pode trocar os contadores estruturais da thread
+  ESTATISTICAS *estat = ESTAT_ATUAL();
+  (void)estat;
+  t->executar(t->arg);
+  ESTAT_USAR(estat);
+  // Depois disso quem espera pode liberar a tarefa: não tocar mais nela
+  atomic_store(&t->estado, TAREFA_CONCLUIDA);
+  avisar_executor();
+}
+
+void avisar_executor(void) {
+  pthread_mutex_lock(&executor.trava);
+  executor.versao++;
+  pthread_cond_broadcast(&executor.sinal);
+  pthread_mutex_unlock(&executor.trava);
+}
+
+// Executa uma tarefa da própria fila ou roubada de outra (1 se executou)
+int executar_alguma(int propria) {
+  TAREFA *t = retirar_fila(&executor.filas[propria], 1);
+  int total = executor.threads + 1;
+  // Começa a roubar da vizinha, para as ladras não disputarem a mesma fila
+  for (int i = 1; !t && i < total; i++)
+    t = retirar_fila(&executor.filas[(propria + i) % total], 0);
+  if (!t)
+    return 0;
+  rodar_tarefa(t);
+  return 1;
+}
+
+void tarefa_iniciar(TAREFA *t, void (*executar)(void *arg), void *arg) {
+  t->executar = executar;
+  t->arg = arg;
+  atomic_init(&t->estado, TAREFA_PENDENTE);
+  t->fila = 0;
+}
+
+void tarefa_lancar(TAREFA *t) {
+  pthread_once(&executor_iniciado, iniciar_executor);
+  atomic_store(&t->estado, TAREFA_PENDENTE);
+  t->fila = fila_atual >= 0 ? fila_atual : 0;
+
+  FILA *f = &executor.filas[t->fila];
+  pthread_mutex_lock(&f->trava);
+  int ok = empilhar_fila(f, t);
+  pthread_mutex_unlock(&f->trava);
+  if (!ok) {
+    // Sem memória para enfileirar: executa aqui mesmo
+    atomic_store(&t->estado, TAREFA_RODANDO);
+    rodar_tarefa(t);
+    return;
+  }
+  avisar_executor();
+}
+
+int tarefa_concluida(TAREFA *t) {
+  return atomic_load(&t->estado) == TAREFA_CONCLUIDA;
+}
+
+void tarefa_esperar(TAREFA *t) {
+  pthread_once(&executor_iniciado, iniciar_executor);
+
+  // Ninguém pegou a tarefa ainda: a thread chamadora a executa
+  if (tomar_tarefa(t, TAREFA_RODANDO)) {
+    rodar_tarefa(t);
+    return;
+  }
+
+  while (!tarefa_concluida(t)) {
+    pthread_mutex_lock(&executor.trava);
+    uint64_t vista = executor.versao;
+    pthread_mutex_unlock(&executor.trava);
+
+    // Trabalhadoras ajudam com outras tarefas enquanto esperam
+    if (fila_atual >= 0 && executar_alguma(fila_atual))
+      continue;
+
+    pthread_mutex_lock(&executor.trava);
+    while (executor.versao == vista && !tarefa_concluida(t))
+      pthread_cond_wait(&executor.sinal, &executor.trava);
+    pthread_mutex_unlock(&executor.trava);
+  }
+}
+
+int tarefa_cancelar(TAREFA *t) {
+  pthread_once(&executor_iniciado, iniciar_executor);
+  if (!tomar_tarefa(t, TAREFA_CONCLUIDA))
+    return 0;
+  avisar_executor();
+  return 1;
+}
+
+void executar_parte(void *arg) {
+  PARTE_PARALELO *parte = (PARTE_PARALELO *)arg;
+  parte->p->executar(parte->p->ctx, parte->i);
+}
+
+void executor_paralelo(size_t n, void (*executar)(void *ctx, size_t i),
+                       void *ctx) {
+  PARTE_PARALELO *partes =
+      n > 1 ? (PARTE_PARALELO *)malloc(n * sizeof(PARTE_PARALELO)) : NULL;
+  if (!partes) {
+    for (size_t i = 0; i < n; i++)
+      executar(ctx, i);
+    return;
+  }
+
+  PARALELO p = {executar, ctx};
+  for (size_t i = 1; i < n; i++) {
+    partes[i].p = &p;
+    partes[i].i = i;
+    tarefa_iniciar(&partes[i].tarefa, executar_parte, &partes[i]);
+    tarefa_lancar(&partes[i].tarefa);
+  }
+  executar(ctx, 0);
+  // Na ordem inversa: as últimas lançadas são as primeiras da própria fila
+  for (size_t i = n - 1; i >= 1; i--)
+    tarefa_esperar(&partes[i].tarefa);
+  free(partes);
+}
+
+int executor_threads(void) {
+  pthread_once(&executor_iniciado, iniciar_executor);
+  return executor.criadas;
+}
@@ -0,0 +1,107 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+/*
+    Grupo de threads compartilhado com roubo de tarefas ("work stealing").
+    Cada trabalhadora tem uma fila dupla: as tarefas que ela lança entram e
+    saem pelo fim (a mais recente primeiro, que ainda está quente na cache),
+    e as trabalhadoras sem serviço roubam pelo início (a mais antiga, em
+    geral a maior). Tarefas lançadas por threads de fora do grupo vão para
+    uma fila de entrada comum.
+
+    O grupo é criado no primeiro uso, com uma trabalhadora por núcleo, e
+    dura até o fim do processo.
+*/
+
+// Estados de uma tarefa
+#define TAREFA_PENDENTE 0  // Na fila, ainda não começou
+#define TAREFA_RODANDO 1   // Alguma thread está executando
+#define TAREFA_CONCLUIDA 2 // Terminou (ou foi cancelada antes de começar)
+
+/**
+ * @brief Uma unidade de trabalho do grupo.
+ *
+ * A memória é do chamador e deve continuar válida até a tarefa ser
+ * esperada com tarefa_esperar() ou cancelada com tarefa_cancelar().
+ */
+typedef struct tarefa {
+  void (*executar)(void *arg); /**< Função executada. */
+  void *arg;                   /**< Argumento repassado a `executar`. */
+  atomic_int estado;           /**< TAREFA_PENDENTE, _RODANDO, _CONCLUIDA. */
+  int fila;                    /**< Fila em que foi lançada (uso interno). */
+} TAREFA;
+
+/**
+ * @brief Prepara uma tarefa para ser lançada.
+ *
+ * @param t Ponteiro para a tarefa.
+ * @param executar Função a executar.
+ * @param arg Argumento repassado a `executar`.
+ */
+void tarefa_iniciar(TAREFA *t, void (*executar)(void *arg), void *arg);
+
+/**
+ * @brief Entrega a tarefa ao grupo, sem esperar.
+ *
+ * Lançada de dentro de outra tarefa, vai para a fila da trabalhadora
+ * atual; de fora do grupo, vai para a fila de entrada.
+ *
+ * @param t Ponteiro para a tarefa (preparada com tarefa_iniciar()).
+ */
+void tarefa_lancar(TAREFA *t);
+
+/**
+ * @brief Consulta a tarefa sem bloquear.
+ *
+ * @param t Ponteiro para a tarefa.
+ * @return 1 se a tarefa terminou ou foi cancelada, 0 caso contrário.
+ */
+int tarefa_concluida(TAREFA *t);
+
+/**
+ * @brief Espera a tarefa terminar.
+ *
+ * Se ninguém começou a tarefa, a própria thread chamadora a executa. Uma
+ * trabalhadora que espera também executa outras tarefas pendentes nesse
+ * meio tempo, então tarefas podem lançar e esperar subtarefas sem prender
+ * threads do grupo. Threads de fora do grupo nunca executam tarefas
+ * alheias: só dormem.
+ *
+ * @param t Ponteiro para a tarefa.
+ */
+void tarefa_esperar(TAREFA *t);
+
+/**
+ * @brief Cancela uma tarefa que ainda não começou.
+ *
+ * @param t Ponteiro para a tarefa.
+ * @return 1 se a tarefa foi retirada da fila (e não vai mais executar), 0 se
+ *         ela já começou ou terminou.
+ */
+int tarefa_cancelar(TAREFA *t);
+
+/**
+ * @brief Executa executar(ctx, i) para i em [0, n) no grupo e espera todas.
+ *
+ * A chamada i = 0 roda na thread chamadora. Sem memória para as tarefas,
+ * tudo roda em sequência na thread chamadora.
+ *
+ * @param n Quantidade de chamadas.
+ * @param executar Função chamada.
+ * @param ctx Ponteiro repassado a cada chamada.
+ */
+void executor_paralelo(size_t n, void (*executar)(void *ctx, size_t i),
+                       void *ctx);
+
+/**
+ * @brief Quantidade de trabalhadoras do grupo.
+ *
+ * @return Quantidade de threads (0 se nenhuma pôde ser criada; nesse caso
+ *         as tarefas rodam em tarefa_esperar()).
+ */
+int executor_threads(void);
+
+#endif // EXECUTOR_H
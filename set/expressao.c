@@ -0,0 +1,321 @@
+#include <stdlib.h>
+
+#include "expressao.h"
+
+// Tipos de nó da expressão
+#define EXPR_CONJUNTO 0
+#define EXPR_UNIAO 1
+#define EXPR_INTERSECCAO 2
+#define EXPR_DIFERENCA 3
+
+// Estado do elemento antecipado de cada nó
+#define ESPIA_VAZIA 0 // Ainda não buscado
+#define ESPIA_CHEIA 1 // `valor` guarda o próximo elemento não consumido
+#define ESPIA_FIM 2   // Nó esgotado
+
+/*
+    Cada nó é um cursor em ordem crescente que pode antecipar um elemento:
+    os operadores olham o próximo elemento dos operandos (espiar), saltam
+    até um valor (saltar) e só então o consomem (consumir). As operações
+    "cruas" de cada tipo (proximo_no e buscar_no) não conhecem a antecipação.
+*/
+typedef struct expressao {
+  int tipo;
+  SET *set;             // Folha: conjunto percorrido
+  ITERADOR it;          // Folha: iterador (preparado no primeiro uso)
+  int iniciado;         // Folha: iterador preparado
+  struct expressao *a;  // Operador: primeiro operando
+  struct expressao *b;  // Operador: segundo operando
+  int espia;            // Estado do elemento antecipado
+  int valor;            // Elemento antecipado
+} EXPRESSAO;
+
+// Protocolo das Funções
+
+// Auxiliares
+EXPRESSAO *criar_expressao(int tipo);
+EXPRESSAO *criar_operador(int tipo, EXPRESSAO *a, EXPRESSAO *b);
+int proximo_no(EXPRESSAO *e, int *valor);
+int buscar_no(EXPRESSAO *e, int alvo, int *valor);
+int espiar(EXPRESSAO *e, int *valor);
+int saltar(EXPRESSAO *e, int alvo, int *valor);
+void consumir(EXPRESSAO *e);
+int alinhar_interseccao(EXPRESSAO *e, int x, int *valor);
+int filtrar_diferenca(EXPRESSAO *e, int *valor);
+
+// Principais
+EXPRESSAO *expr_conjunto(SET *set);
+EXPRESSAO *expr_uniao(EXPRESSAO *a, EXPRESSAO *b);
+EXPRESSAO *expr_interseccao(EXPRESSAO *a, EXPRESSAO *b);
+EXPRESSAO *expr_diferenca(EXPRESSAO *a, EXPRESSAO *b);
+void expr_apagar(EXPRESSAO **e);
+void expr_reiniciar(EXPRESSAO *e);
+int expr_proximo(EXPRESSAO *e, int *valor);
+int expr_buscar(EXPRESSAO *e, int alvo, int *valor);
+size_t expr_contar(EXPRESSAO *e);
+size_t expr_emitir(EXPRESSAO *e, size_t limite, SAIDA *saida);
+SET *expr_materializar(EXPRESSAO *e, int opt);
+
+EXPRESSAO *criar_expressao(int tipo) {
+  EXPRESSAO *e = (EXPRESSAO *)calloc(1, sizeof(EXPRESSAO));
+  if (e)
+    e->tipo = tipo;
+  return e;
+}
+
+// Cria um operador dono dos dois operandos (liberados em caso de falha)
+EXPRESSAO *criar_operador(int tipo, EXPRESSAO *a, EXPRESSAO *b) {
+  EXPRESSAO *e = (a && b) ? criar_expressao(tipo) : NULL;
+  if (!e) {
+    expr_apagar(&a);
+    expr_apagar(&b);
+    return NULL;
+  }
+  e->a = a;
+  e->b = b;
+  return e;
+}
+
+EXPRESSAO *expr_conjunto(SET *set) {
+  if (!set)
+    return NULL;
+  EXPRESSAO *e = criar_expressao(EXPR_CONJUNTO);
+  if (e)
+    e->set = set;
+  return e;
+}
+
+EXPRESSAO *expr_uniao(EXPRESSAO *a, EXPRESSAO *b) {
+  return criar_operador(EXPR_UNIAO, a, b);
+}
+
+EXPRESSAO *expr_interseccao(EXPRESSAO *a, EXPRESSAO *b) {
+  return criar_operador(EXPR_INTERSECCAO, a, b);
+}
+
+EXPRESSAO *expr_diferenca(EXPRESSAO *a, EXPRESSAO *b) {
+  return criar_operador(EXPR_DIFERENCA, a, b);
+}
+
+void expr_apagar(EXPRESSAO **e) {
+  if (!e || !*e)
+    return;
+  expr_apagar(&(*e)->a);
+  expr_apagar(&(*e)->b);
+  if ((*e)->iniciado)
+    iterador_finalizar(&(*e)->it);
+  free(*e);
+  *e = NULL;
+}
+
+void expr_reiniciar(EXPRESSAO *e) {
+  if (!e)
+    return;
+  expr_reiniciar(e->a);
+  expr_reiniciar(e->b);
+  if (e->iniciado)
+    iterador_finalizar(&e->it);
+  e->iniciado = 0;
+  e->espia = ESPIA_VAZIA;
+}
+
+// Próximo elemento antecipado do nó, sem consumi-lo
+int espiar(EXPRESSAO *e, int *valor) {
+  if (e->espia == ESPIA_VAZIA)
+    e->espia = proximo_no(e, &e->valor) ? ESPIA_CHEIA : ESPIA_FIM;
+  *valor = e->valor;
+  return e->espia == ESPIA_CHEIA;
+}
+
+// Antecipa o primeiro elemento não consumido >= alvo
+int saltar(EXPRESSAO *e, int alvo, int *valor) {
+  if (e->espia == ESPIA_FIM)
+    return 0;
+  if (e->espia == ESPIA_VAZIA || e->valor < alvo)
+    e->espia = buscar_no(e, alvo, &e->valor) ? ESPIA_CHEIA : ESPIA_FIM;
+  *valor = e->valor;
+  return e->espia == ESPIA_CHEIA;
+}
+
+// Descarta o elemento antecipado
+void consumir(EXPRESSAO *e) {
+  if (e->espia == ESPIA_CHEIA)
+    e->espia = ESPIA_VAZIA;
+}
+
+/*
+    Intersecção (leapfrog): cada operando salta até o elemento do outro.
+    Quando os dois param no mesmo valor, ele pertence ao resultado.
+*/
+int alinhar_interseccao(EXPRESSAO *e, int x, int *valor) {
+  int y;
+  for (;;) {
+    if (!saltar(e->b, x, &y))
+      return 0;
+    if (y == x) {
+      consumir(e->a);
+      consumir(e->b);
+      *valor = x;
+      return 1;
+    }
+    if (!saltar(e->a, y, &x))
+      return 0;
+  }
+}
+
+// Diferença: entrega o próximo elemento de `a` que `b` não tem
+int filtrar_diferenca(EXPRESSAO *e, int *valor) {
+  int x, y;
+  while (espiar(e->a, &x)) {
+    consumir(e->a);
+    if (!saltar(e->b, x, &y) || y != x) {
+      *valor = x;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int proximo_no(EXPRESSAO *e, int *valor) {
+  int x, y, tem_x, tem_y;
+
+  switch (e->tipo) {
+  case EXPR_CONJUNTO:
+    if (!e->iniciado) {
+      set_iterador(e->set, &e->it);
+      e->iniciado = 1;
+    }
+    return set_iterador_proximo(&e->it, valor);
+
+  case EXPR_UNIAO:
+    tem_x = espiar(e->a, &x);
+    tem_y = espiar(e->b, &y);
+    if (!tem_x && !tem_y)
+      return 0;
+    // Entrega o menor; se os dois forem iguais, ambos são consumidos
+    *valor = (!tem_y || (tem_x && x < y)) ? x : y;
+    if (tem_x && x == *valor)
+      consumir(e->a);
+    if (tem_y && y == *valor)
+      consumir(e->b);
+    return 1;
+
+  case EXPR_INTERSECCAO:
+    if (!espiar(e->a, &x))
+      return 0;
+    return alinhar_interseccao(e, x, valor);
+
+  case EXPR_DIFERENCA:
+    return filtrar_diferenca(e, valor);
+  }
+  return 0;
+}
+
+int buscar_no(EXPRESSAO *e, int alvo, int *valor) {
+  int x, y;
+
+  switch (e->tipo) {
+  case EXPR_CONJUNTO:
+    if (!e->iniciado) {
+      set_iterador(e->set, &e->it);
+      e->iniciado = 1;
+    }
+    return set_iterador_buscar(&e->it, alvo, valor);
+
+  case EXPR_UNIAO:
+    // Posiciona os dois operandos e entrega o menor
+    saltar(e->a, alvo, &x);
+    saltar(e->b, alvo, &y);
+    return proximo_no(e, valor);
+
+  case EXPR_INTERSECCAO:
+    if (!saltar(e->a, alvo, &x))
+      return 0;
+    return alinhar_interseccao(e, x, valor);
+
+  case EXPR_DIFERENCA:
+    if (!saltar(e->a, alvo, &x))
+      return 0;
+    return filtrar_diferenca(e, valor);
+  }
+  return 0;
+}
+
+int expr_proximo(EXPRESSAO *e, int *valor) {
+  if (!e || !espiar(e, valor))
+    return 0;
+  consumir(e);
+  return 1;
+}
+
+int expr_buscar(EXPRESSAO *e, int alvo, int *valor) {
+  if (!e || !saltar(e, alvo, valor))
+    return 0;
+  consumir(e);
+  return 1;
+}
+
+size_t expr_contar(EXPRESSAO *e) {
+  if (!e)
+    return 0;
+  if (e->tipo == EXPR_CONJUNTO)
+    return set_tamanho(e->set);
+
+  size_t n = 0;
+  int valor;
+  expr_reiniciar(e);
+  while (expr_proximo(e, &valor))
+    n++;
+  expr_reiniciar(e);
+  return n;
+}
+
+size_t expr_emitir(EXPRESSAO *e, size_t limite, SAIDA *saida) {
+  if (!e || !saida)
+    return 0;
+
+  LOTE_SAIDA lote;
+  size_t n = 0, antes = saida_quantidade(saida);
+  int valor, aceita = 1;
+
+  expr_reiniciar(e);
+  lote_iniciar(&lote, saida);
+  while (aceita && n < limite && expr_proximo(e, &valor)) {
+    n++;
+    aceita = lote_anexar(&lote, valor);
+  }
+  lote_descarregar(&lote);
+  expr_reiniciar(e);
+
+  // Conta só o que a saída de fato aceitou
+  return saida_quantidade(saida) - antes;
+}
+
+SET *expr_materializar(EXPRESSAO *e, int opt) {
+  if (!e)
+    return NULL;
+
+  SAIDA *saida = saida_vetor(0);
+  if (!saida)
+    return NULL;
+
+  LOTE_SAIDA lote;
+  int valor, aceita = 1;
+
+  // Uma saída de vetor só recusa elementos por falta de memória
+  expr_reiniciar(e);
+  lote_iniciar(&lote, saida);
+  while (aceita && expr_proximo(e, &valor))
+    aceita = lote_anexar(&lote, valor);
+  aceita = lote_descarregar(&lote) && aceita;
+  expr_reiniciar(e);
+
+  SET *resultado = NULL;
+  if (aceita) {
+    size_t n;
+    int *chaves = saida_dados(saida, &n);
+    resultado = set_construir_ordenado(opt, chaves, n);
+  }
+  saida_apagar(&saida);
+  return resultado;
+}
@@ -0,0 +1,131 @@
+#ifndef EXPRESSAO_H
+#define EXPRESSAO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "saida.h"
+#include "set.h"
+
+// Expressão preguiçosa sobre conjuntos (ex.: (A ∪ B) ∩ (C − D)).
+typedef struct expressao EXPRESSAO;
+
+// Sem limite em expr_emitir()
+#define EXPR_TODOS SIZE_MAX
+
+/**
+ * @brief Cria uma folha da expressão que referencia um conjunto.
+ *
+ * O conjunto não é copiado nem liberado pela expressão, e não deve ser
+ * alterado enquanto ela estiver sendo avaliada.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return Ponteiro para a expressão ou NULL em caso de erro.
+ */
+EXPRESSAO *expr_conjunto(SET *set);
+
+/**
+ * @brief Cria a união de duas expressões.
+ *
+ * A nova expressão passa a ser dona dos operandos. Se um deles for NULL (ex.:
+ * falha em uma construção aninhada), o outro é liberado e o retorno é NULL,
+ * então expressões inteiras podem ser montadas em uma única chamada.
+ *
+ * @param a Primeiro operando.
+ * @param b Segundo operando.
+ * @return Ponteiro para a expressão ou NULL em caso de erro.
+ */
+EXPRESSAO *expr_uniao(EXPRESSAO *a, EXPRESSAO *b);
+
+/**
+ * @brief Cria a intersecção de duas expressões (mesmas regras de
+ * expr_uniao()).
+ *
+ * @param a Primeiro operando.
+ * @param b Segundo operando.
+ * @return Ponteiro para a expressão ou NULL em caso de erro.
+ */
+EXPRESSAO *expr_interseccao(EXPRESSAO *a, EXPRESSAO *b);
+
+/**
+ * @brief Cria a diferença `a − b` (mesmas regras de expr_uniao()).
+ *
+ * @param a Expressão da qual os elementos são tirados.
+ * @param b Expressão com os elementos a excluir.
+ * @return Ponteiro para a expressão ou NULL em caso de erro.
+ */
+EXPRESSAO *expr_diferenca(EXPRESSAO *a, EXPRESSAO *b);
+
+/**
+ * @brief Libera a expressão e todos os seus operandos (os conjuntos não).
+ *
+ * @param e Endereço do ponteiro para a expressão. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void expr_apagar(EXPRESSAO **e);
+
+/**
+ * @brief Volta a avaliação da expressão para o início.
+ *
+ * @param e Ponteiro para a expressão.
+ */
+void expr_reiniciar(EXPRESSAO *e);
+
+/**
+ * @brief Obtém o próximo elemento do resultado, em ordem crescente.
+ *
+ * A avaliação é puxada pela raiz: nada é calculado antes de ser pedido e
+ * nenhum conjunto intermediário é criado. Intersecções e diferenças saltam
+ * faixas inteiras dos operandos com buscas em O(log(n)).
+ *
+ * @param e Ponteiro para a expressão.
+ * @param valor Recebe o elemento.
+ * @return 1 se um elemento foi obtido, 0 ao final do resultado.
+ */
+int expr_proximo(EXPRESSAO *e, int *valor);
+
+/**
+ * @brief Avança até o primeiro elemento do resultado maior ou igual a `alvo`.
+ *
+ * @param e Ponteiro para a expressão.
+ * @param alvo Menor elemento aceitável.
+ * @param valor Recebe o elemento encontrado.
+ * @return 1 se um elemento foi obtido, 0 se não houver elemento >= alvo.
+ */
+int expr_buscar(EXPRESSAO *e, int alvo, int *valor);
+
+/**
+ * @brief Conta os elementos do resultado sem materializá-lo.
+ *
+ * Avalia a expressão desde o início; uma folha sozinha é respondida em O(1).
+ * Ao final a expressão é reiniciada.
+ *
+ * @param e Ponteiro para a expressão.
+ * @return Quantidade de elementos do resultado.
+ */
+size_t expr_contar(EXPRESSAO *e);
+
+/**
+ * @brief Envia os primeiros elementos do resultado para uma saída.
+ *
+ * Avalia a expressão desde o início e para assim que `limite` elementos
+ * forem emitidos (ou a saída recusar), sem calcular o restante.
+ *
+ * @param e Ponteiro para a expressão.
+ * @param limite Quantidade máxima de elementos (EXPR_TODOS para todos).
+ * @param saida Saída de destino (ver saida.h).
+ * @return Quantidade de elementos entregues à saída.
+ */
+size_t expr_emitir(EXPRESSAO *e, size_t limite, SAIDA *saida);
+
+/**
+ * @brief Materializa o resultado em um novo conjunto.
+ *
+ * @param e Ponteiro para a expressão.
+ * @param opt Estrutura do conjunto criado (ver criar_set()).
+ * @return Novo conjunto com o resultado, ou NULL em caso de erro. Deve ser
+ *         liberado com set_apagar().
+ */
+SET *expr_materializar(EXPRESSAO *e, int opt);
+
+#endif // EXPRESSAO_H
@@ -0,0 +1,252 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "filtro.h"
+
+// Bits do filtro de Bloom por chave prevista
+#define FILTRO_BITS_POR_CHAVE 12
+
+// Tentativas de sementes na construção do filtro xor
+#define FILTRO_XOR_TENTATIVAS 64
+
+/*
+    Bloom em blocos ("split block"): cada bloco tem 8 palavras de 32 bits e
+    cada chave liga um bit em cada palavra do seu bloco, escolhido por uma
+    multiplicação com um sal diferente. Uma consulta é um acesso à memória
+    e 8 testes independentes (que o compilador vetoriza), contra os k
+    acessos espalhados de um Bloom comum, ao custo de uma taxa de falsos
+    positivos um pouco maior para o mesmo espaço.
+
+    Filtro xor: três segmentos de impressões de 8 bits; a chave pertence ao
+    filtro se a xor das suas três posições (uma por segmento) é a sua
+    impressão. A construção acha uma ordem em que cada chave tem uma
+    posição só sua ("descascamento") e preenche as posições na ordem
+    inversa. Com ~1.23 posições por chave o descascamento funciona quase
+    sempre; quando falha, troca-se a semente.
+*/
+typedef struct filtro {
+  int tipo;
+  // FILTRO_BLOOM
+  uint32_t *palavras; // n_blocos * 8, alinhado a 64 bytes
+  size_t n_blocos;
+  size_t capacidade;
+  size_t adicionadas; // Desde a criação, incluindo as já removidas
+  size_t removidas;
+  // FILTRO_XOR
+  uint8_t *impressoes; // 3 * segmento
+  size_t segmento;
+  uint64_t semente;
+  size_t n;
+} FILTRO;
+
+static const uint32_t SAL_BLOOM[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                      0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                      0x9efc4947U, 0x5c6bfb31U};
+
+// Protocolo das Funções
+
+// Auxiliares
+uint64_t misturar_filtro(uint64_t x);
+uint32_t reduzir_filtro(uint32_t x, size_t n);
+uint32_t *bloco_bloom(const FILTRO *f, uint64_t h);
+void posicoes_xor(const FILTRO *f, uint64_t h, size_t pos[3]);
+int descascar_xor(FILTRO *f, const int *chaves, size_t n, uint64_t *mascara,
+                  uint32_t *contagem, size_t *fila, uint64_t *pilha_h,
+                  size_t *pilha_pos);
+
+// Principais
+FILTRO *filtro_bloom(size_t capacidade);
+FILTRO *filtro_xor(const int *chaves, size_t n);
+int filtro_tipo(const FILTRO *f);
+int filtro_adicionar(FILTRO *f, int chave);
+void filtro_remover(FILTRO *f);
+int filtro_saturado(const FILTRO *f);
+int filtro_contem(const FILTRO *f, int chave);
+size_t filtro_bytes(const FILTRO *f);
+void filtro_apagar(FILTRO **f);
+
+// Finalizador do splitmix64
+uint64_t misturar_filtro(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+// Leva x uniformemente para [0, n) com uma multiplicação, sem divisão
+uint32_t reduzir_filtro(uint32_t x, size_t n) {
+  return (uint32_t)(((uint64_t)x * (uint64_t)n) >> 32);
+}
+
+uint32_t *bloco_bloom(const FILTRO *f, uint64_t h) {
+  return f->palavras + 8 * (size_t)reduzir_filtro((uint32_t)(h >> 32),
+                                                  f->n_blocos);
+}
+
+void posicoes_xor(const FILTRO *f, uint64_t h, size_t pos[3]) {
+  pos[0] = reduzir_filtro((uint32_t)h, f->segmento);
+  pos[1] = f->segmento +
+           reduzir_filtro((uint32_t)((h << 21) | (h >> 43)), f->segmento);
+  pos[2] = 2 * f->segmento +
+           reduzir_filtro((uint32_t)((h << 42) | (h >> 22)), f->segmento);
+}
+
+// Uma tentativa de ordenar as chaves com a semente atual (1 se conseguiu)
+int descascar_xor(FILTRO *f, const int *chaves, size_t n, uint64_t *mascara,
+                  uint32_t *contagem, size_t *fila, uint64_t *pilha_h,
+                  size_t *pilha_pos) {
+  size_t tam = 3 * f->segmento, pos[3];
+  memset(mascara, 0, tam * sizeof(uint64_t));
+  memset(contagem, 0, tam * sizeof(uint32_t));
+  for (size_t i = 0; i < n; i++) {
+    uint64_t h = misturar_filtro((uint64_t)(uint32_t)chaves[i] ^ f->semente);
+    posicoes_xor(f, h, pos);
+    for (int j = 0; j < 3; j++) {
+      mascara[pos[j]] ^= h;
+      contagem[pos[j]]++;
+    }
+  }
+
+  // Posições com uma só chave saem primeiro; tirar a chave das outras duas
+  // posições pode liberar novas posições
+  size_t topo_fila = 0, topo_pilha = 0;
+  for (size_t i = 0; i < tam; i++)
+    if (contagem[i] == 1)
+      fila[topo_fila++] = i;
+  while (topo_fila > 0) {
+    size_t i = fila[--topo_fila];
+    if (contagem[i] != 1)
+      continue;
+    uint64_t h = mascara[i];
+    pilha_h[topo_pilha] = h;
+    pilha_pos[topo_pilha++] = i;
+    posicoes_xor(f, h, pos);
+    for (int j = 0; j < 3; j++) {
+      mascara[pos[j]] ^= h;
+      if (--contagem[pos[j]] == 1)
+        fila[topo_fila++] = pos[j];
+    }
+  }
+  if (topo_pilha != n)
+    return 0;
+
+  memset(f->impressoes, 0, tam);
+  while (topo_pilha > 0) {
+    topo_pilha--;
+    uint64_t h = pilha_h[topo_pilha];
+    posicoes_xor(f, h, pos);
+    f->impressoes[pilha_pos[topo_pilha]] =
+        (uint8_t)(h ^ (h >> 32)) ^ f->impressoes[pos[0]] ^
+        f->impressoes[pos[1]] ^ f->impressoes[pos[2]];
+  }
+  return 1;
+}
+
+FILTRO *filtro_bloom(size_t capacidade) {
+  FILTRO *f = (FILTRO *)calloc(1, sizeof(FILTRO));
+  if (!f)
+    return NULL;
+  f->tipo = FILTRO_BLOOM;
+  f->capacidade = capacidade > 0 ? capacidade : 1;
+  f->n_blocos = (f->capacidade * FILTRO_BITS_POR_CHAVE + 255) / 256;
+  // Dois blocos por linha de cache; aligned_alloc() pede múltiplo de 64
+  size_t bytes = ((f->n_blocos * 32) + 63) & ~(size_t)63;
+  f->palavras = (uint32_t *)aligned_alloc(64, bytes);
+  if (!f->palavras) {
+    free(f);
+    return NULL;
+  }
+  memset(f->palavras, 0, bytes);
+  return f;
+}
+
+FILTRO *filtro_xor(const int *chaves, size_t n) {
+  FILTRO *f = (FILTRO *)calloc(1, sizeof(FILTRO));
+  if (!f)
+    return NULL;
+  f->tipo = FILTRO_XOR;
+  f->n = n;
+  if (n == 0)
+    return f;
+
+  f->segmento = (32 + n + n / 4 + 2) / 3; // ~1.23n + 32 posições no total
+  size_t tam = 3 * f->segmento;
+  f->impressoes = (uint8_t *)malloc(tam);
+  uint64_t *mascara = (uint64_t *)malloc(tam * sizeof(uint64_t));
+  uint32_t *contagem = (uint32_t *)malloc(tam * sizeof(uint32_t));
+  size_t *fila = (size_t *)malloc(tam * sizeof(size_t));
+  uint64_t *pilha_h = (uint64_t *)malloc(n * sizeof(uint64_t));
+  size_t *pilha_pos = (size_t *)malloc(n * sizeof(size_t));
+  int ok = 0;
+  if (f->impressoes && mascara && contagem && fila && pilha_h && pilha_pos) {
+    for (int t = 0; t < FILTRO_XOR_TENTATIVAS && !ok; t++) {
+      f->semente = misturar_filtro((uint64_t)t + 1);
+      ok = descascar_xor(f, chaves, n, mascara, contagem, fila, pilha_h,
+                         pilha_pos);
+    }
+  }
+  free(mascara);
+  free(contagem);
+  free(fila);
+  free(pilha_h);
+  free(pilha_pos);
+  if (!ok)
+    filtro_apagar(&f);
+  return f;
+}
+
+int filtro_tipo(const FILTRO *f) { return f->tipo; }
+
+int filtro_adicionar(FILTRO *f, int chave) {
+  if (f->tipo != FILTRO_BLOOM)
+    return 0;
+  uint64_t h = misturar_filtro((uint64_t)(uint32_t)chave);
+  uint32_t *bloco = bloco_bloom(f, h);
+  for (int i = 0; i < 8; i++)
+    bloco[i] |= 1U << (((uint32_t)h * SAL_BLOOM[i]) >> 27);
+  f->adicionadas++;
+  return 1;
+}
+
+void filtro_remover(FILTRO *f) { f->removidas++; }
+
+int filtro_saturado(const FILTRO *f) {
+  return f->tipo == FILTRO_BLOOM &&
+         (f->adicionadas > f->capacidade || f->removidas * 2 > f->adicionadas);
+}
+
+int filtro_contem(const FILTRO *f, int chave) {
+  if (f->tipo == FILTRO_BLOOM) {
+    uint64_t h = misturar_filtro((uint64_t)(uint32_t)chave);
+    const uint32_t *bloco = bloco_bloom(f, h);
+    uint32_t falta = 0;
+    for (int i = 0; i < 8; i++)
+      falta |= ~bloco[i] & (1U << (((uint32_t)h * SAL_BLOOM[i]) >> 27));
+    return falta == 0;
+  }
+
+  if (f->n == 0)
+    return 0;
+  uint64_t h = misturar_filtro((uint64_t)(uint32_t)chave ^ f->semente);
+  size_t pos[3];
+  posicoes_xor(f, h, pos);
+  return (uint8_t)(h ^ (h >> 32)) == (f->impressoes[pos[0]] ^
+                                      f->impressoes[pos[1]] ^
+                                      f->impressoes[pos[2]]);
+}
+
+size_t filtro_bytes(const FILTRO *f) {
+  if (f->tipo == FILTRO_BLOOM)
+    return sizeof(FILTRO) + f->n_blocos * 32;
+  return sizeof(FILTRO) + 3 * f->segmento;
+}
+
+void filtro_apagar(FILTRO **f) {
+  if (!f || !*f)
+    return;
+  free((*f)->palavras);
+  free((*f)->impressoes);
+  free(*f);
+  *f = NULL;
+}
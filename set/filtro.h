@@ -0,0 +1,103 @@
+#ifndef FILTRO_H
+#define FILTRO_H
+
+#include <stddef.h>
+
+// Pré-filtro de pertinência: responde "certamente ausente" ou "talvez".
+typedef struct filtro FILTRO;
+
+// Tipos de filtro
+#define FILTRO_BLOOM 0 // Bloom em blocos: aceita novas chaves
+#define FILTRO_XOR 1   // Filtro xor: imutável, menor e mais preciso
+
+/**
+ * @brief Cria um filtro de Bloom em blocos vazio.
+ *
+ * Cada chave marca 8 bits de um único bloco de 32 bytes, então uma consulta
+ * lê uma só linha de cache. Com até `capacidade` chaves os falsos positivos
+ * ficam abaixo de ~1%; além disso o filtro continua correto, só menos
+ * seletivo (ver filtro_saturado()).
+ *
+ * @param capacidade Quantidade de chaves prevista.
+ * @return Ponteiro para o filtro ou NULL em caso de erro.
+ */
+FILTRO *filtro_bloom(size_t capacidade);
+
+/**
+ * @brief Cria um filtro xor com as chaves dadas.
+ *
+ * Guarda uma impressão de 8 bits por posição em ~1.23 posições por chave
+ * (falsos positivos ~0.4%); cada consulta lê três posições.
+ *
+ * @param chaves Vetor de chaves sem repetição.
+ * @param n Quantidade de chaves.
+ * @return Ponteiro para o filtro ou NULL em caso de erro.
+ */
+FILTRO *filtro_xor(const int *chaves, size_t n);
+
+/**
+ * @brief Tipo do filtro.
+ *
+ * @param f Ponteiro para o filtro.
+ * @return FILTRO_BLOOM ou FILTRO_XOR.
+ */
+int filtro_tipo(const FILTRO *f);
+
+/**
+ * @brief Acrescenta uma chave a um filtro de Bloom.
+ *
+ * @param f Ponteiro para o filtro.
+ * @param chave Chave acrescentada.
+ * @return 1 em caso de sucesso, 0 se o filtro for xor.
+ */
+int filtro_adicionar(FILTRO *f, int chave);
+
+/**
+ * @brief Registra que uma chave saiu do conjunto.
+ *
+ * O filtro não consegue esquecer a chave (ela continua respondendo
+ * "talvez"); só conta a remoção para filtro_saturado().
+ *
+ * @param f Ponteiro para o filtro.
+ */
+void filtro_remover(FILTRO *f);
+
+/**
+ * @brief Informa se vale reconstruir o filtro.
+ *
+ * Um filtro de Bloom satura quando recebeu mais chaves que a capacidade ou
+ * quando mais da metade das chaves que recebeu já foram removidas. Um
+ * filtro xor nunca satura.
+ *
+ * @param f Ponteiro para o filtro.
+ * @return 1 se a reconstrução é recomendada, 0 caso contrário.
+ */
+int filtro_saturado(const FILTRO *f);
+
+/**
+ * @brief Consulta uma chave.
+ *
+ * @param f Ponteiro para o filtro.
+ * @param chave Chave consultada.
+ * @return 0 se a chave certamente não foi acrescentada, 1 se talvez tenha
+ *         sido.
+ */
+int filtro_contem(const FILTRO *f, int chave);
+
+/**
+ * @brief Memória ocupada pelo filtro.
+ *
+ * @param f Ponteiro para o filtro.
+ * @return Quantidade de bytes.
+ */
+size_t filtro_bytes(const FILTRO *f);
+
+/**
+ * @brief Libera o filtro.
+ *
+ * @param f Endereço do ponteiro para o filtro. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void filtro_apagar(FILTRO **f);
+
+#endif // FILTRO_H
@@ -0,0 +1,163 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "executor.h"
+#include "futuro.h"
+
+// Operações que um futuro pode executar
+#define FUTURO_UNIAO 0
+#define FUTURO_INTERSECCAO 1
+#define FUTURO_CONSTRUIR 2
+
+typedef struct futuro {
+  TAREFA tarefa;
+  int tipo;
+  SET **sets; // Cópia do vetor de operandos
+  size_t k;
+  int opt;
+  const int *valores;
+  size_t n;
+  SAIDA *vetor; // Resultado de união e intersecção, antes de montar
+  atomic_int cancelado;
+  SET *resultado;
+  int entregue;
+} FUTURO;
+
+// Protocolo das Funções
+
+// Auxiliares
+int acumular_futuro(void *ctx, const int *valores, size_t n);
+void executar_futuro(void *arg);
+FUTURO *lancar_futuro(FUTURO *f);
+FUTURO *futuro_operacao(int tipo, SET **sets, size_t k);
+
+// Principais
+FUTURO *set_uniao_assincrona(SET **sets, size_t k);
+FUTURO *set_interseccao_assincrona(SET **sets, size_t k);
+FUTURO *set_construir_assincrono(int opt, const int *valores, size_t n);
+int futuro_pronto(FUTURO *f);
+SET *futuro_esperar(FUTURO *f);
+int futuro_cancelar(FUTURO *f);
+void futuro_apagar(FUTURO **f);
+
+// Repassa um lote ao vetor do resultado; interrompe se houve cancelamento
+int acumular_futuro(void *ctx, const int *valores, size_t n) {
+  FUTURO *f = (FUTURO *)ctx;
+  if (atomic_load(&f->cancelado))
+    return 0;
+  return saida_escrever(f->vetor, valores, n);
+}
+
+void executar_futuro(void *arg) {
+  FUTURO *f = (FUTURO *)arg;
+  if (atomic_load(&f->cancelado))
+    return;
+
+  if (f->tipo == FUTURO_CONSTRUIR) {
+    f->resultado = set_construir(f->opt, f->valores, f->n, 0);
+    return;
+  }
+
+  // Mesma montagem de set_uniao_k() / set_interseccao_k(), mas com um
+  // ponto de parada a cada lote
+  SAIDA *saida = saida_callback(acumular_futuro, f);
+  if (!saida)
+    return;
+  int completo = f->tipo == FUTURO_UNIAO
+                     ? set_uniao_k_emitir(f->sets, f->k, saida)
+                     : set_interseccao_k_emitir(f->sets, f->k, saida);
+  if (completo)
+    completo = saida_finalizar(saida);
+  saida_apagar(&saida);
+  if (completo && !atomic_load(&f->cancelado)) {
+    size_t n;
+    int *chaves = saida_dados(f->vetor, &n);
+    f->resultado = set_construir_ordenado(set_estrutura(f->sets[0]), chaves, n);
+  }
+}
+
+FUTURO *lancar_futuro(FUTURO *f) {
+  atomic_init(&f->cancelado, 0);
+  tarefa_iniciar(&f->tarefa, executar_futuro, f);
+  tarefa_lancar(&f->tarefa);
+  return f;
+}
+
+FUTURO *futuro_operacao(int tipo, SET **sets, size_t k) {
+  if (!sets || k == 0)
+    return NULL;
+  for (size_t i = 0; i < k; i++)
+    if (!sets[i])
+      return NULL;
+
+  FUTURO *f = (FUTURO *)calloc(1, sizeof(FUTURO));
+  if (!f)
+    return NULL;
+  f->tipo = tipo;
+  f->k = k;
+  f->sets = (SET **)malloc(k * sizeof(SET *));
+  f->vetor = saida_vetor(0);
+  if (!f->sets || !f->vetor) {
+    free(f->sets);
+    saida_apagar(&f->vetor);
+    free(f);
+    return NULL;
+  }
+  memcpy(f->sets, sets, k * sizeof(SET *));
+  return lancar_futuro(f);
+}
+
+FUTURO *set_uniao_assincrona(SET **sets, size_t k) {
+  return futuro_operacao(FUTURO_UNIAO, sets, k);
+}
+
+FUTURO *set_interseccao_assincrona(SET **sets, size_t k) {
+  return futuro_operacao(FUTURO_INTERSECCAO, sets, k);
+}
+
+FUTURO *set_construir_assincrono(int opt, const int *valores, size_t n) {
+  if (!valores && n > 0)
+    return NULL;
+  FUTURO *f = (FUTURO *)calloc(1, sizeof(FUTURO));
+  if (!f)
+    return NULL;
+  f->tipo = FUTURO_CONSTRUIR;
+  f->opt = opt;
+  f->valores = valores;
+  f->n = n;
+  return lancar_futuro(f);
+}
+
+int futuro_pronto(FUTURO *f) { return f ? tarefa_concluida(&f->tarefa) : 1; }
+
+SET *futuro_esperar(FUTURO *f) {
+  if (!f)
+    return NULL;
+  tarefa_esperar(&f->tarefa);
+  if (f->entregue || atomic_load(&f->cancelado))
+    return NULL;
+  f->entregue = 1;
+  return f->resultado;
+}
+
+int futuro_cancelar(FUTURO *f) {
+  if (!f || tarefa_concluida(&f->tarefa))
+    return 0;
+  atomic_store(&f->cancelado, 1);
+  tarefa_cancelar(&f->tarefa);
+  return 1;
+}
+
+void futuro_apagar(FUTURO **f) {
+  if (!f || !*f)
+    return;
+  futuro_cancelar(*f);
+  tarefa_esperar(&(*f)->tarefa);
+  if (!(*f)->entregue)
+    set_apagar(&(*f)->resultado);
+  saida_apagar(&(*f)->vetor);
+  free((*f)->sets);
+  free(*f);
+  *f = NULL;
+}
@@ -0,0 +1,90 @@
+#ifndef FUTURO_H
+#define FUTURO_H
+
+#include <stddef.h>
+
+#include "set.h"
+
+/*
+    Operações de conjunto em segundo plano. Cada chamada devolve na hora um
+    FUTURO e a operação roda no grupo de threads compartilhado (executor.h),
+    dividindo-se em subtarefas nele quando o algoritmo é paralelo. Os
+    operandos (e o vetor de valores de set_construir_assincrono()) não podem
+    ser alterados nem liberados até o futuro terminar.
+*/
+typedef struct futuro FUTURO;
+
+/**
+ * @brief Calcula set_uniao_k() em segundo plano.
+ *
+ * @param sets Vetor de ponteiros para os operandos (é copiado).
+ * @param k Quantidade de operandos.
+ * @return Ponteiro para o futuro ou NULL em caso de erro.
+ */
+FUTURO *set_uniao_assincrona(SET **sets, size_t k);
+
+/**
+ * @brief Calcula set_interseccao_k() em segundo plano.
+ *
+ * @param sets Vetor de ponteiros para os operandos (é copiado).
+ * @param k Quantidade de operandos.
+ * @return Ponteiro para o futuro ou NULL em caso de erro.
+ */
+FUTURO *set_interseccao_assincrona(SET **sets, size_t k);
+
+/**
+ * @brief Executa set_construir() em segundo plano, com todos os núcleos.
+ *
+ * @param opt Identificador da estrutura (ver criar_set()).
+ * @param valores Vetor de valores (não é copiado nem modificado).
+ * @param n Quantidade de valores.
+ * @return Ponteiro para o futuro ou NULL em caso de erro.
+ */
+FUTURO *set_construir_assincrono(int opt, const int *valores, size_t n);
+
+/**
+ * @brief Consulta o futuro sem bloquear.
+ *
+ * @param f Ponteiro para o futuro.
+ * @return 1 se a operação terminou (ou foi cancelada), 0 caso contrário.
+ */
+int futuro_pronto(FUTURO *f);
+
+/**
+ * @brief Espera a operação terminar e entrega o resultado.
+ *
+ * Se nenhuma thread do grupo começou a operação, ela roda na própria thread
+ * chamadora. O conjunto passa a ser do chamador (set_apagar()); chamadas
+ * seguintes devolvem NULL.
+ *
+ * @param f Ponteiro para o futuro.
+ * @return Conjunto resultado, ou NULL se a operação falhou, foi cancelada ou
+ *         já foi entregue.
+ */
+SET *futuro_esperar(FUTURO *f);
+
+/**
+ * @brief Cancela a operação.
+ *
+ * Uma operação que ainda não começou sai da fila. União e intersecção em
+ * andamento param no próximo lote de elementos produzidos; uma construção
+ * em andamento termina, mas o resultado é descartado. Depois do
+ * cancelamento futuro_esperar() devolve NULL.
+ *
+ * @param f Ponteiro para o futuro.
+ * @return 1 se a operação foi cancelada, 0 se ela já tinha terminado.
+ */
+int futuro_cancelar(FUTURO *f);
+
+/**
+ * @brief Libera o futuro, cancelando a operação se ela não terminou.
+ *
+ * Bloqueia até a operação em andamento (se houver) perceber o
+ * cancelamento. Um resultado não entregue é liberado junto.
+ *
+ * @param f Endereço do ponteiro para o futuro. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void futuro_apagar(FUTURO **f);
+
+#endif // FUTURO_H
@@ -0,0 +1,94 @@
+#ifndef ITERADOR_H
+#define ITERADOR_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacidade da pilha embutida no iterador. Cobre a altura de qualquer
+// AVL ou LLRB com até 2^32 nós sem precisar de memória dinâmica.
+#define ITERADOR_PILHA 64
+
+// Chaves que cabem no espaço da pilha embutida (estruturas comprimidas
+// decodificam ali um bloco inteiro)
+#define ITERADOR_CHAVES 128
+
+/**
+ * @brief Iterador em ordem crescente, comum a todas as estruturas.
+ *
+ * O iterador é alocado pelo chamador (normalmente na pilha) e preenchido pela
+ * estrutura que está sendo percorrida. Árvores usam a pilha de nós pendentes;
+ * listas usam apenas o campo `atual`. Estruturas com várias chaves por nó
+ * guardam em `posicao` onde o percurso parou dentro de `atual`, e
+ * estruturas comprimidas usam o espaço da pilha para as chaves
+ * decodificadas.
+ */
+typedef struct iterador {
+  void *estrutura; /**< Estrutura percorrida. */
+  void *origem;    /**< Uso do TAD que criou o iterador (despacho). */
+  void *atual;     /**< Nó corrente, para estruturas lineares. */
+  int64_t posicao; /**< Próxima chave dentro do nó corrente. */
+  void **extra;    /**< Pilha em heap, usada apenas se a embutida encher. */
+  size_t topo;     /**< Quantidade de nós empilhados. */
+  size_t capacidade; /**< Capacidade atual da pilha. */
+  union {
+    void *pilha[ITERADOR_PILHA]; /**< Pilha embutida de nós pendentes. */
+    int chaves[ITERADOR_CHAVES]; /**< Bloco decodificado (comprimidos). */
+  };
+} ITERADOR;
+
+// Prepara o iterador vazio sobre uma estrutura
+static inline void iterador_iniciar(ITERADOR *it, void *estrutura) {
+  it->estrutura = estrutura;
+  it->origem = NULL;
+  it->atual = NULL;
+  it->posicao = 0;
+  it->extra = NULL;
+  it->topo = 0;
+  it->capacidade = ITERADOR_PILHA;
+}
+
+// Pilha efetivamente em uso (embutida ou em heap)
+static inline void **iterador_pilha(ITERADOR *it) {
+  return it->extra ? it->extra : it->pilha;
+}
+
+// Empilha um nó, migrando a pilha para o heap se necessário
+static inline int iterador_empilhar(ITERADOR *it, void *no) {
+  if (it->topo == it->capacidade) {
+    size_t nova = it->capacidade * 2;
+    void **p = (void **)realloc(it->extra, nova * sizeof(void *));
+    if (!p)
+      return 0;
+    if (!it->extra)
+      memcpy(p, it->pilha, it->topo * sizeof(void *));
+    it->extra = p;
+    it->capacidade = nova;
+  }
+  iterador_pilha(it)[it->topo++] = no;
+  return 1;
+}
+
+// Desempilha um nó, ou NULL se a pilha estiver vazia
+static inline void *iterador_desempilhar(ITERADOR *it) {
+  if (it->topo == 0)
+    return NULL;
+  return iterador_pilha(it)[--it->topo];
+}
+
+// Consulta o topo sem desempilhar
+static inline void *iterador_topo(ITERADOR *it) {
+  if (it->topo == 0)
+    return NULL;
+  return iterador_pilha(it)[it->topo - 1];
+}
+
+// Libera a pilha em heap, se houver
+static inline void iterador_finalizar(ITERADOR *it) {
+  free(it->extra);
+  it->extra = NULL;
+  it->topo = 0;
+  it->capacidade = ITERADOR_PILHA;
+}
+
+#endif // ITERADOR_H
@@ -0,0 +1,197 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "executor.h"
+#include "ordenacao.h"
+
+#define RADIX_BITS 8
+#define RADIX_BALDES (1 << RADIX_BITS)
+#define RADIX_PASSADAS (32 / RADIX_BITS)
+
+// Abaixo disso o custo de dividir em tarefas não compensa
+#define ORDENACAO_MIN_POR_THREAD 65536
+
+/*
+    Estado compartilhado pelas fatias da ordenação. Cada fatia trabalha
+    sempre na mesma faixa [inicio, fim) do vetor; as fases rodam como
+    tarefas do grupo de threads (executor_paralelo()), e entre uma fase e
+    outra a thread chamadora faz as somas de prefixo.
+*/
+typedef struct ordenacao {
+  uint32_t *origem;  // Vetor lido na passada atual
+  uint32_t *destino; // Vetor escrito na passada atual
+  size_t n;
+  int threads;       // Quantidade de fatias
+  int passada;
+  size_t *contagem;  // contagem[t * RADIX_BALDES + digito]
+  size_t *unicos;    // Valores únicos por fatia (e seus deslocamentos)
+  int pular;         // Passada atual pode ser pulada
+  uint32_t *saida;   // Vetor que deve conter o resultado (o do usuário)
+} ORDENACAO;
+
+// Protocolo das Funções
+
+int ordenacao_threads(int threads);
+void fatia_ordenacao(ORDENACAO *o, int id, size_t *inicio, size_t *fim);
+uint32_t digito_radix(uint32_t v, int passada);
+void prefixo_radix(ORDENACAO *o);
+void histograma_radix(void *ctx, size_t id);
+void distribuir_radix(void *ctx, size_t id);
+void contar_unicos(void *ctx, size_t id);
+void compactar_unicos(void *ctx, size_t id);
+void devolver_unicos(void *ctx, size_t id);
+size_t ordenar_unicos(int *valores, size_t n, int threads);
+
+int ordenacao_threads(int threads) {
+  if (threads > 0)
+    return threads;
+  long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+  return nucleos > 0 ? (int)nucleos : 1;
+}
+
+// Fatia do vetor que cabe à tarefa `id`
+void fatia_ordenacao(ORDENACAO *o, int id, size_t *inicio, size_t *fim) {
+  *inicio = o->n * (size_t)id / (size_t)o->threads;
+  *fim = o->n * (size_t)(id + 1) / (size_t)o->threads;
+}
+
+// Dígito da passada. Inverter o bit de sinal na última passada faz a ordem
+// sem sinal coincidir com a de `int`, sem precisar transformar o vetor.
+uint32_t digito_radix(uint32_t v, int passada) {
+  uint32_t d = (v >> (passada * RADIX_BITS)) & (RADIX_BALDES - 1);
+  if (passada == RADIX_PASSADAS - 1)
+    d ^= RADIX_BALDES >> 1;
+  return d;
+}
+
+// Transforma as contagens em posições de escrita (dígito maior, fatia menor)
+void prefixo_radix(ORDENACAO *o) {
+  size_t soma = 0;
+  o->pular = 0;
+  for (int d = 0; d < RADIX_BALDES; d++) {
+    size_t total = 0;
+    for (int t = 0; t < o->threads; t++) {
+      size_t c = o->contagem[t * RADIX_BALDES + d];
+      o->contagem[t * RADIX_BALDES + d] = soma;
+      soma += c;
+      total += c;
+    }
+    // Todos os valores no mesmo balde: a passada não muda nada
+    if (total == o->n)
+      o->pular = 1;
+  }
+}
+
+// Histograma local da fatia
+void histograma_radix(void *ctx, size_t id) {
+  ORDENACAO *o = (ORDENACAO *)ctx;
+  size_t inicio, fim;
+  fatia_ordenacao(o, (int)id, &inicio, &fim);
+  size_t *minha = &o->contagem[id * RADIX_BALDES];
+  memset(minha, 0, RADIX_BALDES * sizeof(size_t));
+  for (size_t i = inicio; i < fim; i++)
+    minha[digito_radix(o->origem[i], o->passada)]++;
+}
+
+// Distribuição estável: cada fatia escreve em faixas disjuntas
+void distribuir_radix(void *ctx, size_t id) {
+  ORDENACAO *o = (ORDENACAO *)ctx;
+  size_t inicio, fim;
+  fatia_ordenacao(o, (int)id, &inicio, &fim);
+  size_t *minha = &o->contagem[id * RADIX_BALDES];
+  for (size_t i = inicio; i < fim; i++) {
+    uint32_t v = o->origem[i];
+    o->destino[minha[digito_radix(v, o->passada)]++] = v;
+  }
+}
+
+// Remoção de repetidos: conta os únicos da fatia...
+void contar_unicos(void *ctx, size_t id) {
+  ORDENACAO *o = (ORDENACAO *)ctx;
+  size_t inicio, fim, unicos = 0;
+  fatia_ordenacao(o, (int)id, &inicio, &fim);
+  for (size_t i = inicio; i < fim; i++)
+    if (i == 0 || o->origem[i] != o->origem[i - 1])
+      unicos++;
+  o->unicos[id] = unicos;
+}
+
+// ...e os compacta no outro vetor a partir do seu deslocamento
+void compactar_unicos(void *ctx, size_t id) {
+  ORDENACAO *o = (ORDENACAO *)ctx;
+  size_t inicio, fim, pos = o->unicos[id];
+  fatia_ordenacao(o, (int)id, &inicio, &fim);
+  for (size_t i = inicio; i < fim; i++)
+    if (i == 0 || o->origem[i] != o->origem[i - 1])
+      o->destino[pos++] = o->origem[i];
+}
+
+// Se o resultado caiu no buffer auxiliar, cada fatia devolve a sua parte
+// (numa fase própria: antes disso ainda há fatias lendo o vetor original)
+void devolver_unicos(void *ctx, size_t id) {
+  ORDENACAO *o = (ORDENACAO *)ctx;
+  memcpy(o->saida + o->unicos[id], o->destino + o->unicos[id],
+         (o->unicos[id + 1] - o->unicos[id]) * sizeof(uint32_t));
+}
+
+size_t ordenar_unicos(int *valores, size_t n, int threads) {
+  if (n == 0)
+    return 0;
+
+  threads = ordenacao_threads(threads);
+  if ((size_t)threads > n / ORDENACAO_MIN_POR_THREAD)
+    threads = (int)(n / ORDENACAO_MIN_POR_THREAD);
+  if (threads < 1)
+    threads = 1;
+
+  ORDENACAO o;
+  o.n = n;
+  o.threads = threads;
+  o.destino = (uint32_t *)malloc(n * sizeof(uint32_t));
+  o.contagem = (size_t *)malloc((size_t)threads * RADIX_BALDES * sizeof(size_t));
+  o.unicos = (size_t *)malloc((size_t)(threads + 1) * sizeof(size_t));
+  if (!o.destino || !o.contagem || !o.unicos) {
+    free(o.destino);
+    free(o.contagem);
+    free(o.unicos);
+    return 0;
+  }
+
+  uint32_t *chaves = (uint32_t *)valores;
+  o.origem = chaves;
+  o.saida = chaves;
+
+  size_t fatias = (size_t)threads;
+  for (o.passada = 0; o.passada < RADIX_PASSADAS; o.passada++) {
+    executor_paralelo(fatias, histograma_radix, &o);
+    prefixo_radix(&o);
+    if (!o.pular) {
+      executor_paralelo(fatias, distribuir_radix, &o);
+      uint32_t *aux = o.origem;
+      o.origem = o.destino;
+      o.destino = aux;
+    }
+  }
+
+  executor_paralelo(fatias, contar_unicos, &o);
+  size_t soma = 0;
+  for (int t = 0; t < threads; t++) {
+    size_t c = o.unicos[t];
+    o.unicos[t] = soma;
+    soma += c;
+  }
+  o.unicos[threads] = soma;
+  executor_paralelo(fatias, compactar_unicos, &o);
+  if (o.destino != o.saida)
+    executor_paralelo(fatias, devolver_unicos, &o);
+
+  // O buffer auxiliar é o que não for o vetor do usuário
+  free(o.origem == chaves ? o.destino : o.origem);
+  free(o.contagem);
+  free(o.unicos);
+  return soma;
+}
@@ -0,0 +1,31 @@
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+#include <stddef.h>
+
+/**
+ * @brief Ordena um vetor de inteiros e remove os valores repetidos.
+ *
+ * Usa radix sort LSD (4 passadas de 8 bits) seguido de uma compactação dos
+ * valores únicos, ambos divididos em `threads` fatias executadas pelo grupo
+ * de threads compartilhado (ver executor.h). Passadas em que todos os
+ * valores têm o mesmo dígito são puladas.
+ *
+ * @param valores Vetor a ser ordenado; ao final contém os valores únicos em
+ *                ordem crescente nas primeiras posições.
+ * @param n Quantidade de valores.
+ * @param threads Quantidade de fatias (valores <= 0 usam todos os núcleos).
+ * @return Quantidade de valores únicos, ou 0 em caso de falha de alocação
+ *         (com n > 0).
+ */
+size_t ordenar_unicos(int *valores, size_t n, int threads);
+
+/**
+ * @brief Quantidade de threads efetiva para um pedido do usuário.
+ *
+ * @param threads Quantidade pedida; valores <= 0 significam "todos os núcleos".
+ * @return Quantidade de threads a ser usada (pelo menos 1).
+ */
+int ordenacao_threads(int threads);
+
+#endif // ORDENACAO_H
@@ -0,0 +1,606 @@
+#define _GNU_SOURCE
+
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ordenacao.h"
+#include "particao.h"
+
+// Trabalhos executados pelas donas sobre as suas fatias
+#define PARTICAO_CRIAR 0
+#define PARTICAO_CONSTRUIR 1
+#define PARTICAO_INSERIR 2
+#define PARTICAO_REMOVER 3
+#define PARTICAO_PERTENCE 4
+#define PARTICAO_UNIAO 5
+#define PARTICAO_INTERSECCAO 6
+
+typedef struct fatia {
+  SET *set;
+  pthread_rwlock_t trava;
+} FATIA;
+
+/*
+    Trabalho em andamento. Um lote é agrupado por fatia na thread chamadora
+    (contagem por fatia, somas de prefixo e distribuição, como um passo de
+    radix sort) e cada dona percorre os grupos das suas fatias: a fatia f
+    pertence à dona f % N, sendo N o tamanho do grupo de donas.
+*/
+typedef struct trabalho {
+  int tipo;
+  const int *chaves;        // Chaves agrupadas por fatia
+  const size_t *inicio;     // Grupo da fatia f: [inicio[f], inicio[f + 1])
+  const size_t *posicao;    // Posição de cada chave no lote original
+  unsigned char *resultado; // PARTICAO_PERTENCE
+  PARTICAO *a, *b;          // Operandos de união e intersecção
+} TRABALHO;
+
+/*
+    Parte de um despacho entregue a uma dona: as fatias dela, mais o que ela
+    apurou. Fica na fila da dona até ser executada.
+*/
+typedef struct pedido {
+  struct despacho *despacho;
+  int dona;
+  size_t contagem; // Alterações feitas
+  int falhou;
+  struct pedido *prox;
+} PEDIDO;
+
+// Um trabalho publicado para as donas, esperado pela thread chamadora
+typedef struct despacho {
+  PARTICAO *p;
+  TRABALHO trabalho;
+  size_t passo;  // Distância entre as fatias de uma mesma dona
+  int pendentes; // Pedidos ainda não executados
+  pthread_cond_t fim;
+} DESPACHO;
+
+typedef struct dona {
+  pthread_cond_t partida;
+  PEDIDO *inicio, *fim; // Fila de pedidos, na ordem de chegada
+} DONA;
+
+/*
+    Grupo de donas do processo, criado no primeiro uso com uma dona fixada
+    em cada núcleo e compartilhado por todas as partições. A fatia f de
+    qualquer partição é sempre da mesma dona, que cria a fatia e executa
+    sobre ela os lotes na ordem em que chegam.
+*/
+typedef struct grupo_donas {
+  int threads; // Donas que de fato existem
+  DONA *donas;
+  pthread_mutex_t trava; // Protege as filas e os despachos pendentes
+} GRUPO_DONAS;
+
+static GRUPO_DONAS grupo_donas;
+static pthread_once_t donas_iniciadas = PTHREAD_ONCE_INIT;
+
+typedef struct particao {
+  int opt;
+  size_t n_fatias;
+  int *limites; // n_fatias - 1 limites
+  FATIA *fatias;
+  pthread_mutex_t lote; // Um trabalho por vez
+} PARTICAO;
+
+// Protocolo das Funções
+
+// Auxiliares
+size_t fatia_da_chave(const PARTICAO *p, int chave);
+void fixar_dona(int id, int threads);
+void iniciar_donas(void);
+void executar_dona(PEDIDO *pedido);
+void *trabalhador_particao(void *arg);
+int despachar_particao(PARTICAO *p, const TRABALHO *t, size_t *contagem);
+int agrupar_particao(PARTICAO *p, const int *valores, size_t n,
+                     int **chaves, size_t **inicio, size_t **posicao);
+int executar_lote_particao(PARTICAO *p, int tipo, const int *valores,
+                           size_t n, unsigned char *resultado,
+                           size_t *contagem);
+PARTICAO *particao_iniciar(int opt, const int *limites, size_t n_fatias);
+int mesmos_limites_particao(const PARTICAO *a, const PARTICAO *b);
+PARTICAO *particao_operacao(int tipo, PARTICAO *a, PARTICAO *b);
+
+// Principais
+PARTICAO *particao_criar(int opt, const int *limites, size_t n_fatias);
+PARTICAO *particao_construir(int opt, const int *valores, size_t n,
+                             size_t n_fatias, int threads);
+void particao_apagar(PARTICAO **p);
+int particao_inserir(PARTICAO *p, int valor);
+int particao_remover(PARTICAO *p, int valor);
+int particao_pertence(PARTICAO *p, int valor);
+int particao_inserir_lote(PARTICAO *p, const int *valores, size_t n,
+                          size_t *inseridos);
+int particao_remover_lote(PARTICAO *p, const int *valores, size_t n,
+                          size_t *removidos);
+int particao_pertence_lote(PARTICAO *p, const int *valores, size_t n,
+                           unsigned char *resultado);
+PARTICAO *particao_uniao(PARTICAO *a, PARTICAO *b);
+PARTICAO *particao_interseccao(PARTICAO *a, PARTICAO *b);
+size_t particao_tamanho(PARTICAO *p);
+size_t particao_fatias(PARTICAO *p);
+SET *particao_fatia(PARTICAO *p, size_t f);
+int particao_emitir(PARTICAO *p, SAIDA *saida);
+
+// Quantidade de limites <= chave (busca binária)
+size_t fatia_da_chave(const PARTICAO *p, int chave) {
+  size_t ini = 0, fim = p->n_fatias - 1;
+  while (ini < fim) {
+    size_t meio = ini + (fim - ini) / 2;
+    if (chave < p->limites[meio])
+      fim = meio;
+    else
+      ini = meio + 1;
+  }
+  return ini;
+}
+
+/*
+    Fixa a dona em um núcleo, espalhando as donas pelos núcleos permitidos
+    ao processo. Os núcleos de um mesmo nó NUMA costumam ter números
+    vizinhos, então donas distantes caem em nós diferentes. Falhas são
+    ignoradas: a dona só perde a garantia de localidade.
+*/
+void fixar_dona(int id, int threads) {
+  cpu_set_t permitidos, alvo;
+  if (sched_getaffinity(0, sizeof(permitidos), &permitidos) != 0)
+    return;
+  int total = CPU_COUNT(&permitidos);
+  if (total <= 1)
+    return;
+
+  int escolhido = threads <= total ? (int)((long)id * total / threads)
+                                   : id % total;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (!CPU_ISSET(cpu, &permitidos))
+      continue;
+    if (escolhido-- == 0) {
+      CPU_ZERO(&alvo);
+      CPU_SET(cpu, &alvo);
+      pthread_setaffinity_np(pthread_self(), sizeof(alvo), &alvo);
+      return;
+    }
+  }
+}
+
+// Cria o grupo de donas; se faltarem threads, o grupo fica menor
+void iniciar_donas(void) {
+  pthread_mutex_init(&grupo_donas.trava, NULL);
+  int previstas = ordenacao_threads(0);
+  grupo_donas.donas = (DONA *)calloc((size_t)previstas, sizeof(DONA));
+  if (!grupo_donas.donas)
+    return; // Sem donas: as chamadoras executam os trabalhos
+  for (int i = 0; i < previstas; i++)
+    pthread_cond_init(&grupo_donas.donas[i].partida, NULL);
+
+  for (int i = 0; i < previstas; i++) {
+    pthread_t id;
+    if (pthread_create(&id, NULL, trabalhador_particao,
+                       (void *)(intptr_t)i) != 0)
+      break;
+    pthread_detach(id);
+    grupo_donas.threads++;
+  }
+}
+
+// Executa o trabalho do despacho sobre as fatias da dona
+void executar_dona(PEDIDO *pedido) {
+  DESPACHO *d = pedido->despacho;
+  PARTICAO *p = d->p;
+  const TRABALHO *t = &d->trabalho;
+
+  for (size_t f = (size_t)pedido->dona; f < p->n_fatias; f += d->passo) {
+    FATIA *fatia = &p->fatias[f];
+    size_t ini = t->inicio ? t->inicio[f] : 0;
+    size_t fim = t->inicio ? t->inicio[f + 1] : 0;
+
+    switch (t->tipo) {
+    case PARTICAO_CRIAR:
+      if (!(fatia->set = criar_set(p->opt)))
+        pedido->falhou = 1;
+      break;
+    case PARTICAO_CONSTRUIR:
+      fatia->set = set_construir_ordenado(p->opt, t->chaves + ini, fim - ini);
+      if (!fatia->set)
+        pedido->falhou = 1;
+      break;
+    case PARTICAO_INSERIR:
+    case PARTICAO_REMOVER:
+      pthread_rwlock_wrlock(&fatia->trava);
+      for (size_t i = ini; i < fim; i++) {
+        int r = t->tipo == PARTICAO_INSERIR
+                    ? set_inserir(fatia->set, t->chaves[i])
+                    : set_remover(fatia->set, t->chaves[i]);
+        if (r == 1)
+          pedido->contagem++;
+        else if (r < 0)
+          pedido->falhou = 1;
+      }
+      if (t->tipo == PARTICAO_REMOVER)
+        set_recolher(fatia->set);
+      pthread_rwlock_unlock(&fatia->trava);
+      break;
+    case PARTICAO_PERTENCE:
+      pthread_rwlock_rdlock(&fatia->trava);
+      for (size_t i = ini; i < fim; i++)
+        t->resultado[t->posicao[i]] =
+            (unsigned char)(set_pertence(fatia->set, t->chaves[i]) == 1);
+      pthread_rwlock_unlock(&fatia->trava);
+      break;
+    case PARTICAO_UNIAO:
+    case PARTICAO_INTERSECCAO: {
+      // A fatia do resultado ainda é só da dona; os operandos são lidos
+      // sob as travas deles (uma vez só se forem o mesmo conjunto)
+      FATIA *fa = &t->a->fatias[f], *fb = &t->b->fatias[f];
+      SET *operandos[2] = {fa->set, fb->set};
+      pthread_rwlock_rdlock(&fa->trava);
+      if (fb != fa)
+        pthread_rwlock_rdlock(&fb->trava);
+      SET *r = t->tipo == PARTICAO_UNIAO ? set_uniao_k(operandos, 2)
+                                         : set_interseccao_k(operandos, 2);
+      if (fb != fa)
+        pthread_rwlock_unlock(&fb->trava);
+      pthread_rwlock_unlock(&fa->trava);
+      if (r) {
+        set_apagar(&fatia->set);
+        fatia->set = r;
+      } else {
+        pedido->falhou = 1;
+      }
+      break;
+    }
+    }
+  }
+}
+
+void *trabalhador_particao(void *arg) {
+  int id = (int)(intptr_t)arg;
+  DONA *dona = &grupo_donas.donas[id];
+  fixar_dona(id, ordenacao_threads(0));
+
+  pthread_mutex_lock(&grupo_donas.trava);
+  for (;;) {
+    while (!dona->inicio)
+      pthread_cond_wait(&dona->partida, &grupo_donas.trava);
+    PEDIDO *pedido = dona->inicio;
+    dona->inicio = pedido->prox;
+    if (!dona->inicio)
+      dona->fim = NULL;
+    pthread_mutex_unlock(&grupo_donas.trava);
+
+    executar_dona(pedido);
+
+    pthread_mutex_lock(&grupo_donas.trava);
+    if (--pedido->despacho->pendentes == 0)
+      pthread_cond_signal(&pedido->despacho->fim);
+  }
+  return NULL;
+}
+
+// Entrega um trabalho às donas das fatias, espera todas e soma as contagens
+int despachar_particao(PARTICAO *p, const TRABALHO *t, size_t *contagem) {
+  pthread_once(&donas_iniciadas, iniciar_donas);
+  int donas = grupo_donas.threads;
+  int envolvidas = (size_t)donas < p->n_fatias ? donas : (int)p->n_fatias;
+  int n_pedidos = envolvidas ? envolvidas : 1;
+
+  PEDIDO *pedidos = (PEDIDO *)calloc((size_t)n_pedidos, sizeof(PEDIDO));
+  if (!pedidos)
+    return 0;
+  DESPACHO d = {p, *t, donas ? (size_t)donas : 1, envolvidas};
+  pthread_cond_init(&d.fim, NULL);
+  for (int i = 0; i < n_pedidos; i++) {
+    pedidos[i].despacho = &d;
+    pedidos[i].dona = i;
+  }
+
+  pthread_mutex_lock(&p->lote);
+  if (envolvidas == 0) {
+    // Sem grupo de donas: a própria chamadora percorre todas as fatias
+    executar_dona(&pedidos[0]);
+  } else {
+    pthread_mutex_lock(&grupo_donas.trava);
+    for (int i = 0; i < envolvidas; i++) {
+      DONA *dona = &grupo_donas.donas[i];
+      if (dona->fim)
+        dona->fim->prox = &pedidos[i];
+      else
+        dona->inicio = &pedidos[i];
+      dona->fim = &pedidos[i];
+      pthread_cond_signal(&dona->partida);
+    }
+    while (d.pendentes > 0)
+      pthread_cond_wait(&d.fim, &grupo_donas.trava);
+    pthread_mutex_unlock(&grupo_donas.trava);
+  }
+  pthread_mutex_unlock(&p->lote);
+  pthread_cond_destroy(&d.fim);
+
+  int ok = 1;
+  size_t soma = 0;
+  for (int i = 0; i < n_pedidos; i++) {
+    soma += pedidos[i].contagem;
+    if (pedidos[i].falhou)
+      ok = 0;
+  }
+  free(pedidos);
+  if (contagem)
+    *contagem = soma;
+  return ok;
+}
+
+// Agrupa o lote por fatia, guardando a posição original de cada chave
+int agrupar_particao(PARTICAO *p, const int *valores, size_t n,
+                     int **chaves, size_t **inicio, size_t **posicao) {
+  *chaves = (int *)malloc((n ? n : 1) * sizeof(int));
+  *inicio = (size_t *)calloc(p->n_fatias + 1, sizeof(size_t));
+  *posicao = (size_t *)malloc((n ? n : 1) * sizeof(size_t));
+  uint32_t *destino = (uint32_t *)malloc((n ? n : 1) * sizeof(uint32_t));
+  if (!*chaves || !*inicio || !*posicao || !destino) {
+    free(*chaves);
+    free(*inicio);
+    free(*posicao);
+    free(destino);
+    return 0;
+  }
+
+  // inicio[f + 1] conta a fatia f; depois das somas, inicio[f] é o começo
+  // do grupo f e serve de cursor de escrita, deslocado uma posição
+  size_t *cursor = *inicio + 1;
+  for (size_t i = 0; i < n; i++) {
+    destino[i] = (uint32_t)fatia_da_chave(p, valores[i]);
+    cursor[destino[i]]++;
+  }
+  size_t soma = 0;
+  for (size_t f = 0; f < p->n_fatias; f++) {
+    size_t c = cursor[f];
+    cursor[f] = soma;
+    soma += c;
+  }
+  for (size_t i = 0; i < n; i++) {
+    size_t j = cursor[destino[i]]++;
+    (*chaves)[j] = valores[i];
+    (*posicao)[j] = i;
+  }
+  // Cada cursor terminou no fim do seu grupo: inicio[f + 1]
+  free(destino);
+  return 1;
+}
+
+int executar_lote_particao(PARTICAO *p, int tipo, const int *valores,
+                           size_t n, unsigned char *resultado,
+                           size_t *contagem) {
+  if (contagem)
+    *contagem = 0;
+  if (!p || (!valores && n > 0) || (tipo == PARTICAO_PERTENCE && !resultado))
+    return 0;
+  if (n == 0)
+    return 1;
+
+  int *chaves;
+  size_t *inicio, *posicao;
+  if (!agrupar_particao(p, valores, n, &chaves, &inicio, &posicao))
+    return 0;
+  TRABALHO t = {tipo, chaves, inicio, posicao, resultado, NULL, NULL};
+  int ok = despachar_particao(p, &t, contagem);
+  free(chaves);
+  free(inicio);
+  free(posicao);
+  return ok;
+}
+
+// Aloca a partição; as fatias ainda não existem
+PARTICAO *particao_iniciar(int opt, const int *limites, size_t n_fatias) {
+  if (opt < SET_AVL || opt > SET_WAVL || opt == SET_CONGELADO ||
+      opt == SET_COMPRIMIDO || n_fatias == 0)
+    return NULL;
+  for (size_t i = 1; limites && i + 1 < n_fatias; i++)
+    if (limites[i - 1] >= limites[i])
+      return NULL;
+
+  PARTICAO *p = (PARTICAO *)calloc(1, sizeof(PARTICAO));
+  if (!p)
+    return NULL;
+  p->opt = opt;
+  p->n_fatias = n_fatias;
+  p->limites = (int *)malloc(n_fatias * sizeof(int));
+  p->fatias = (FATIA *)calloc(n_fatias, sizeof(FATIA));
+  if (!p->limites || !p->fatias) {
+    free(p->limites);
+    free(p->fatias);
+    free(p);
+    return NULL;
+  }
+
+  for (size_t f = 1; f < n_fatias; f++) {
+    // Sem limites: fatias de mesma largura em [INT_MIN, INT_MAX]
+    p->limites[f - 1] =
+        limites ? limites[f - 1]
+                : (int)((int64_t)INT_MIN +
+                        (int64_t)(((uint64_t)f << 32) / n_fatias));
+  }
+  for (size_t f = 0; f < n_fatias; f++)
+    pthread_rwlock_init(&p->fatias[f].trava, NULL);
+  pthread_mutex_init(&p->lote, NULL);
+  return p;
+}
+
+int mesmos_limites_particao(const PARTICAO *a, const PARTICAO *b) {
+  return a->n_fatias == b->n_fatias &&
+         memcmp(a->limites, b->limites,
+                (a->n_fatias - 1) * sizeof(int)) == 0;
+}
+
+// União ou intersecção fatia a fatia, calculada pelas donas do resultado
+PARTICAO *particao_operacao(int tipo, PARTICAO *a, PARTICAO *b) {
+  if (!a || !b || !mesmos_limites_particao(a, b))
+    return NULL;
+  PARTICAO *r = particao_criar(a->opt, a->limites, a->n_fatias);
+  if (!r)
+    return NULL;
+  TRABALHO t = {tipo, NULL, NULL, NULL, NULL, a, b};
+  if (!despachar_particao(r, &t, NULL))
+    particao_apagar(&r);
+  return r;
+}
+
+PARTICAO *particao_criar(int opt, const int *limites, size_t n_fatias) {
+  PARTICAO *p = particao_iniciar(opt, limites, n_fatias);
+  if (!p)
+    return NULL;
+  TRABALHO t = {PARTICAO_CRIAR, NULL, NULL, NULL, NULL, NULL, NULL};
+  if (!despachar_particao(p, &t, NULL))
+    particao_apagar(&p);
+  return p;
+}
+
+PARTICAO *particao_construir(int opt, const int *valores, size_t n,
+                             size_t n_fatias, int threads) {
+  if ((!valores && n > 0) || n_fatias == 0)
+    return NULL;
+  if (n == 0)
+    return particao_criar(opt, NULL, n_fatias);
+
+  int *chaves = (int *)malloc(n * sizeof(int));
+  if (!chaves)
+    return NULL;
+  memcpy(chaves, valores, n * sizeof(int));
+  size_t unicos = ordenar_unicos(chaves, n, threads);
+  if (unicos == 0) {
+    free(chaves);
+    return NULL;
+  }
+
+  // Limites nos quantis: a fatia f recebe as chaves [f u / P, (f + 1) u / P)
+  if (n_fatias > unicos)
+    n_fatias = unicos;
+  int *limites = (int *)malloc(n_fatias * sizeof(int));
+  size_t *inicio = (size_t *)malloc((n_fatias + 1) * sizeof(size_t));
+  PARTICAO *p = NULL;
+  if (limites && inicio) {
+    for (size_t f = 0; f <= n_fatias; f++)
+      inicio[f] = unicos * f / n_fatias;
+    for (size_t f = 1; f < n_fatias; f++)
+      limites[f - 1] = chaves[inicio[f]];
+    p = particao_iniciar(opt, limites, n_fatias);
+  }
+  if (p) {
+    TRABALHO t = {PARTICAO_CONSTRUIR, chaves, inicio, NULL, NULL, NULL, NULL};
+    if (!despachar_particao(p, &t, NULL))
+      particao_apagar(&p);
+  }
+  free(chaves);
+  free(limites);
+  free(inicio);
+  return p;
+}
+
+void particao_apagar(PARTICAO **p) {
+  if (!p || !*p)
+    return;
+  PARTICAO *q = *p;
+  for (size_t f = 0; f < q->n_fatias; f++) {
+    set_apagar(&q->fatias[f].set);
+    pthread_rwlock_destroy(&q->fatias[f].trava);
+  }
+  pthread_mutex_destroy(&q->lote);
+  free(q->limites);
+  free(q->fatias);
+  free(q);
+  *p = NULL;
+}
+
+int particao_inserir(PARTICAO *p, int valor) {
+  if (!p)
+    return -1;
+  FATIA *fatia = &p->fatias[fatia_da_chave(p, valor)];
+  pthread_rwlock_wrlock(&fatia->trava);
+  int r = set_inserir(fatia->set, valor);
+  pthread_rwlock_unlock(&fatia->trava);
+  return r;
+}
+
+int particao_remover(PARTICAO *p, int valor) {
+  if (!p)
+    return -1;
+  FATIA *fatia = &p->fatias[fatia_da_chave(p, valor)];
+  pthread_rwlock_wrlock(&fatia->trava);
+  int r = set_remover(fatia->set, valor);
+  set_recolher(fatia->set); // A trava de escrita exclui os leitores
+  pthread_rwlock_unlock(&fatia->trava);
+  return r;
+}
+
+int particao_pertence(PARTICAO *p, int valor) {
+  if (!p)
+    return 0;
+  FATIA *fatia = &p->fatias[fatia_da_chave(p, valor)];
+  pthread_rwlock_rdlock(&fatia->trava);
+  int r = set_pertence(fatia->set, valor);
+  pthread_rwlock_unlock(&fatia->trava);
+  return r == 1;
+}
+
+int particao_inserir_lote(PARTICAO *p, const int *valores, size_t n,
+                          size_t *inseridos) {
+  return executar_lote_particao(p, PARTICAO_INSERIR, valores, n, NULL,
+                                inseridos);
+}
+
+int particao_remover_lote(PARTICAO *p, const int *valores, size_t n,
+                          size_t *removidos) {
+  return executar_lote_particao(p, PARTICAO_REMOVER, valores, n, NULL,
+                                removidos);
+}
+
+int particao_pertence_lote(PARTICAO *p, const int *valores, size_t n,
+                           unsigned char *resultado) {
+  return executar_lote_particao(p, PARTICAO_PERTENCE, valores, n,
+                                resultado, NULL);
+}
+
+PARTICAO *particao_uniao(PARTICAO *a, PARTICAO *b) {
+  return particao_operacao(PARTICAO_UNIAO, a, b);
+}
+
+PARTICAO *particao_interseccao(PARTICAO *a, PARTICAO *b) {
+  return particao_operacao(PARTICAO_INTERSECCAO, a, b);
+}
+
+size_t particao_tamanho(PARTICAO *p) {
+  if (!p)
+    return 0;
+  size_t total = 0;
+  for (size_t f = 0; f < p->n_fatias; f++) {
+    pthread_rwlock_rdlock(&p->fatias[f].trava);
+    total += set_tamanho(p->fatias[f].set);
+    pthread_rwlock_unlock(&p->fatias[f].trava);
+  }
+  return total;
+}
+
+size_t particao_fatias(PARTICAO *p) { return p ? p->n_fatias : 0; }
+
+SET *particao_fatia(PARTICAO *p, size_t f) {
+  if (!p || f >= p->n_fatias)
+    return NULL;
+  return p->fatias[f].set;
+}
+
+int particao_emitir(PARTICAO *p, SAIDA *saida) {
+  if (!p || !saida)
+    return 0;
+  for (size_t f = 0; f < p->n_fatias; f++) {
+    pthread_rwlock_rdlock(&p->fatias[f].trava);
+    int ok = set_emitir(p->fatias[f].set, saida);
+    pthread_rwlock_unlock(&p->fatias[f].trava);
+    if (!ok)
+      return 0;
+  }
+  return 1;
+}
@@ -0,0 +1,198 @@
+#ifndef PARTICAO_H
+#define PARTICAO_H
+
+#include <stddef.h>
+
+#include "saida.h"
+#include "set.h"
+
+/*
+    Conjunto particionado por faixas de chaves: P fatias, cada uma um SET
+    comum (qualquer estrutura mutável, menos a splay) com a sua trava de
+    leitura/escrita. Cada fatia tem uma thread dona, fixada em um núcleo,
+    que cria a fatia e executa sobre ela as operações em lote, então os nós
+    da fatia saem da arena de malloc dessa thread e são tocados primeiro por
+    ela: em máquinas NUMA a memória fica no nó do núcleo que a usa.
+
+    As donas formam um grupo único do processo, com uma thread por núcleo,
+    criado no primeiro uso e compartilhado por todas as partições: a fatia
+    f de qualquer partição pertence à dona f % N.
+*/
+typedef struct particao PARTICAO;
+
+/**
+ * @brief Cria um conjunto particionado vazio.
+ *
+ * A fatia f guarda as chaves em [limites[f - 1], limites[f]) (a primeira
+ * começa em INT_MIN e a última termina em INT_MAX). Com `limites` NULL o
+ * intervalo de `int` é dividido em fatias de mesma largura.
+ *
+ * @param opt Estrutura das fatias (ver criar_set(); SET_CONGELADO,
+ *            SET_COMPRIMIDO e SET_SPLAY, cujas consultas alteram a árvore,
+ *            não são aceitos).
+ * @param limites Vetor com n_fatias - 1 limites em ordem estritamente
+ *                crescente, ou NULL.
+ * @param n_fatias Quantidade de fatias (pelo menos 1).
+ * @return Ponteiro para o conjunto criado ou NULL em caso de erro.
+ */
+PARTICAO *particao_criar(int opt, const int *limites, size_t n_fatias);
+
+/**
+ * @brief Cria um conjunto particionado já preenchido.
+ *
+ * Os valores são ordenados e deduplicados (ver set_construir()), os limites
+ * são os quantis, para que as fatias fiquem do mesmo tamanho, e cada dona
+ * monta a sua fatia com set_construir_ordenado().
+ *
+ * @param opt Estrutura das fatias (ver particao_criar()).
+ * @param valores Vetor de valores (não é modificado).
+ * @param n Quantidade de valores.
+ * @param n_fatias Quantidade de fatias desejada (menos, se houver menos
+ *                 valores distintos).
+ * @param threads Quantidade de threads da ordenação (valores <= 0 usam
+ *                todos os núcleos).
+ * @return Ponteiro para o conjunto criado ou NULL em caso de erro.
+ */
+PARTICAO *particao_construir(int opt, const int *valores, size_t n,
+                             size_t n_fatias, int threads);
+
+/**
+ * @brief Libera o conjunto (as donas continuam no grupo do processo).
+ *
+ * @param p Endereço do ponteiro para o conjunto. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void particao_apagar(PARTICAO **p);
+
+/**
+ * @brief Insere um elemento, na thread chamadora, travando só a sua fatia.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param valor Elemento a ser inserido.
+ * @return 1 se inseriu, 0 se já existia, -1 em caso de erro.
+ */
+int particao_inserir(PARTICAO *p, int valor);
+
+/**
+ * @brief Remove um elemento, travando só a sua fatia.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param valor Elemento a ser removido.
+ * @return 1 se removeu, 0 se não existia, -1 em caso de erro.
+ */
+int particao_remover(PARTICAO *p, int valor);
+
+/**
+ * @brief Verifica se um elemento pertence ao conjunto.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param valor Elemento a ser verificado.
+ * @return 1 se pertence, 0 caso contrário.
+ */
+int particao_pertence(PARTICAO *p, int valor);
+
+/**
+ * @brief Insere um lote de elementos.
+ *
+ * O lote é agrupado por fatia e cada grupo é inserido pela dona da fatia,
+ * com todas as donas trabalhando em paralelo. Lotes do mesmo conjunto são
+ * executados um por vez; operações isoladas (particao_inserir() etc.)
+ * podem rodar ao mesmo tempo.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param valores Vetor de elementos (pode ter repetições).
+ * @param n Quantidade de elementos.
+ * @param inseridos Recebe quantos elementos eram novos (pode ser NULL).
+ * @return 1 em caso de sucesso, 0 em caso de erro.
+ */
+int particao_inserir_lote(PARTICAO *p, const int *valores, size_t n,
+                          size_t *inseridos);
+
+/**
+ * @brief Remove um lote de elementos (ver particao_inserir_lote()).
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param valores Vetor de elementos.
+ * @param n Quantidade de elementos.
+ * @param removidos Recebe quantos elementos existiam (pode ser NULL).
+ * @return 1 em caso de sucesso, 0 em caso de erro.
+ */
+int particao_remover_lote(PARTICAO *p, const int *valores, size_t n,
+                          size_t *removidos);
+
+/**
+ * @brief Consulta um lote de elementos (ver particao_inserir_lote()).
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param valores Vetor de elementos.
+ * @param n Quantidade de elementos.
+ * @param resultado Recebe, na posição i, 1 se valores[i] pertence ao
+ *                  conjunto e 0 caso contrário.
+ * @return 1 em caso de sucesso, 0 em caso de erro.
+ */
+int particao_pertence_lote(PARTICAO *p, const int *valores, size_t n,
+                           unsigned char *resultado);
+
+/**
+ * @brief União de dois conjuntos particionados com os mesmos limites.
+ *
+ * Cada fatia do resultado é a união das fatias correspondentes, calculada
+ * pela sua dona (set_uniao_k()), todas em paralelo.
+ *
+ * @param a Ponteiro para o primeiro conjunto.
+ * @param b Ponteiro para o segundo conjunto.
+ * @return Novo conjunto (mesma estrutura e limites de `a`), ou
+ *         NULL se os limites forem diferentes ou em caso de erro.
+ */
+PARTICAO *particao_uniao(PARTICAO *a, PARTICAO *b);
+
+/**
+ * @brief Intersecção de dois conjuntos particionados com os mesmos limites.
+ *
+ * @param a Ponteiro para o primeiro conjunto.
+ * @param b Ponteiro para o segundo conjunto.
+ * @return Novo conjunto (ver particao_uniao()), ou NULL se os limites forem
+ *         diferentes ou em caso de erro.
+ */
+PARTICAO *particao_interseccao(PARTICAO *a, PARTICAO *b);
+
+/**
+ * @brief Quantidade de elementos do conjunto.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @return Soma dos tamanhos das fatias.
+ */
+size_t particao_tamanho(PARTICAO *p);
+
+/**
+ * @brief Quantidade de fatias do conjunto.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @return Quantidade de fatias.
+ */
+size_t particao_fatias(PARTICAO *p);
+
+/**
+ * @brief Acessa uma fatia.
+ *
+ * O conjunto devolvido pertence à partição e não tem trava: só deve ser
+ * usado enquanto ninguém altera a partição.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param f Índice da fatia, em ordem crescente de chaves.
+ * @return Fatia, ou NULL se o índice for inválido.
+ */
+SET *particao_fatia(PARTICAO *p, size_t f);
+
+/**
+ * @brief Envia todos os elementos, em ordem crescente, para uma saída.
+ *
+ * As fatias são percorridas em ordem, cada uma sob a sua trava de leitura.
+ *
+ * @param p Ponteiro para o conjunto.
+ * @param saida Saída de destino.
+ * @return 1 se todos os elementos foram aceitos, 0 se a saída interrompeu.
+ */
+int particao_emitir(PARTICAO *p, SAIDA *saida);
+
+#endif // PARTICAO_H
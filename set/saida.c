@@ -0,0 +1,348 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "saida.h"
+
+// Buffer de texto das saídas de arquivo
+#define SAIDA_TEXTO 65536
+
+// Espaço para o maior inteiro formatado ("-2147483648 ")
+#define SAIDA_MAX_INT 12
+
+/**
+ * @brief Estrutura de operações de uma saída.
+ *
+ * Assim como as árvores do conjunto, cada tipo de saída preenche os ponteiros
+ * de função com a sua implementação.
+ */
+typedef struct saida {
+  int (*escrever)(struct saida *s, const int *valores,
+                  size_t n);               /**< Recebe um lote. */
+  int (*finalizar)(struct saida *s);       /**< Encerra um registro. */
+  void (*liberar)(struct saida *s);        /**< Libera o estado próprio. */
+  size_t quantidade; /**< Total de elementos aceitos (cada tipo conta). */
+
+  // Callback
+  int (*emitir)(void *ctx, const int *valores, size_t n);
+  void *ctx;
+
+  // Vetor
+  int *vetor;
+  size_t n, capacidade;
+  int cresce; // 1 se o vetor é da saída e pode crescer
+
+  // Texto
+  FILE *arquivo;
+  int fd;
+  char *texto;
+  size_t usado;
+  int registro_vazio;
+} SAIDA;
+
+// Pares de dígitos "00".."99" para converter dois dígitos por vez
+static const char DIGITOS_PARES[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536"
+    "37383940414243444546474849505152535455565758596061626364656667686970717273"
+    "7475767778798081828384858687888990919293949596979899";
+
+// Protocolo das Funções
+
+// Auxiliares
+SAIDA *criar_saida(void);
+int escrever_callback(SAIDA *s, const int *valores, size_t n);
+int escrever_vetor(SAIDA *s, const int *valores, size_t n);
+int escrever_texto(SAIDA *s, const int *valores, size_t n);
+int finalizar_nada(SAIDA *s);
+int finalizar_texto(SAIDA *s);
+int despejar_texto(SAIDA *s);
+void liberar_vetor(SAIDA *s);
+void liberar_texto(SAIDA *s);
+SAIDA *criar_saida_texto(FILE *arquivo, int fd);
+
+// Principais
+SAIDA *saida_callback(int (*emitir)(void *ctx, const int *valores, size_t n),
+                      void *ctx);
+SAIDA *saida_vetor(size_t capacidade);
+SAIDA *saida_vetor_fixo(int *destino, size_t capacidade);
+SAIDA *saida_arquivo(FILE *arquivo);
+SAIDA *saida_descritor(int fd);
+int saida_escrever(SAIDA *saida, const int *valores, size_t n);
+int saida_finalizar(SAIDA *saida);
+int saida_linha(SAIDA *saida);
+size_t saida_quantidade(SAIDA *saida);
+int *saida_dados(SAIDA *saida, size_t *n);
+void saida_apagar(SAIDA **saida);
+size_t saida_formatar_int(char *destino, int valor);
+
+// Aloca uma saída zerada
+SAIDA *criar_saida(void) {
+  SAIDA *s = (SAIDA *)calloc(1, sizeof(SAIDA));
+  if (s)
+    s->fd = -1;
+  return s;
+}
+
+int finalizar_nada(SAIDA *s) {
+  (void)s;
+  return 1;
+}
+
+// Callback
+
+int escrever_callback(SAIDA *s, const int *valores, size_t n) {
+  // Um lote recusado não conta como aceito
+  if (!s->emitir(s->ctx, valores, n))
+    return 0;
+  s->quantidade += n;
+  return 1;
+}
+
+SAIDA *saida_callback(int (*emitir)(void *ctx, const int *valores, size_t n),
+                      void *ctx) {
+  if (!emitir)
+    return NULL;
+  SAIDA *s = criar_saida();
+  if (!s)
+    return NULL;
+  s->escrever = escrever_callback;
+  s->finalizar = finalizar_nada;
+  s->emitir = emitir;
+  s->ctx = ctx;
+  return s;
+}
+
+// Vetor
+
+int escrever_vetor(SAIDA *s, const int *valores, size_t n) {
+  if (s->capacidade - s->n < n) {
+    if (!s->cresce) {
+      // Copia o que couber e recusa o resto
+      size_t cabe = s->capacidade - s->n;
+      memcpy(s->vetor + s->n, valores, cabe * sizeof(int));
+      s->n += cabe;
+      s->quantidade += cabe;
+      return 0;
+    }
+    size_t nova = s->capacidade ? s->capacidade : 64;
+    while (nova - s->n < n)
+      nova *= 2;
+    int *v = (int *)realloc(s->vetor, nova * sizeof(int));
+    if (!v)
+      return 0;
+    s->vetor = v;
+    s->capacidade = nova;
+  }
+  memcpy(s->vetor + s->n, valores, n * sizeof(int));
+  s->n += n;
+  s->quantidade += n;
+  return 1;
+}
+
+void liberar_vetor(SAIDA *s) {
+  if (s->cresce)
+    free(s->vetor);
+}
+
+SAIDA *saida_vetor(size_t capacidade) {
+  SAIDA *s = criar_saida();
+  if (!s)
+    return NULL;
+  if (capacidade) {
+    s->vetor = (int *)malloc(capacidade * sizeof(int));
+    if (!s->vetor) {
+      free(s);
+      return NULL;
+    }
+  }
+  s->capacidade = capacidade;
+  s->cresce = 1;
+  s->escrever = escrever_vetor;
+  s->finalizar = finalizar_nada;
+  s->liberar = liberar_vetor;
+  return s;
+}
+
+SAIDA *saida_vetor_fixo(int *destino, size_t capacidade) {
+  if (!destino && capacidade)
+    return NULL;
+  SAIDA *s = criar_saida();
+  if (!s)
+    return NULL;
+  s->vetor = destino;
+  s->capacidade = capacidade;
+  s->escrever = escrever_vetor;
+  s->finalizar = finalizar_nada;
+  s->liberar = liberar_vetor;
+  return s;
+}
+
+// Texto
+
+/*
+    Conversão para decimal sem printf: os dígitos são gerados de trás para
+    frente, dois por vez (um resto por 100 indexa a tabela de pares), o que
+    corta pela metade as divisões e evita desvios por dígito.
+*/
+size_t saida_formatar_int(char *destino, int valor) {
+  char tmp[SAIDA_MAX_INT];
+  char *p = tmp + SAIDA_MAX_INT;
+  uint32_t u = valor < 0 ? 0u - (uint32_t)valor : (uint32_t)valor;
+
+  while (u >= 100) {
+    uint32_t par = (u % 100) * 2;
+    u /= 100;
+    p -= 2;
+    p[0] = DIGITOS_PARES[par];
+    p[1] = DIGITOS_PARES[par + 1];
+  }
+  if (u >= 10) {
+    p -= 2;
+    p[0] = DIGITOS_PARES[u * 2];
+    p[1] = DIGITOS_PARES[u * 2 + 1];
+  } else {
+    *--p = (char)('0' + u);
+  }
+  if (valor < 0)
+    *--p = '-';
+
+  size_t tamanho = (size_t)(tmp + SAIDA_MAX_INT - p);
+  memcpy(destino, p, tamanho);
+  return tamanho;
+}
+
+// Entrega o buffer de texto ao arquivo ou descritor
+int despejar_texto(SAIDA *s) {
+  size_t feito = 0;
+  if (s->arquivo) {
+    feito = fwrite(s->texto, 1, s->usado, s->arquivo);
+  } else {
+    while (feito < s->usado) {
+      ssize_t r = write(s->fd, s->texto + feito, s->usado - feito);
+      if (r < 0 && errno == EINTR)
+        continue;
+      if (r <= 0)
+        break;
+      feito += (size_t)r;
+    }
+  }
+  int ok = feito == s->usado;
+  s->usado = 0;
+  return ok;
+}
+
+int escrever_texto(SAIDA *s, const int *valores, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    if (SAIDA_TEXTO - s->usado < SAIDA_MAX_INT && !despejar_texto(s))
+      return 0;
+    s->usado += saida_formatar_int(s->texto + s->usado, valores[i]);
+    s->texto[s->usado++] = ' ';
+  }
+  if (n > 0)
+    s->registro_vazio = 0;
+  s->quantidade += n;
+  return 1;
+}
+
+int finalizar_texto(SAIDA *s) {
+  if (!s->registro_vazio) {
+    if (s->usado == SAIDA_TEXTO && !despejar_texto(s))
+      return 0;
+    s->texto[s->usado++] = '\n';
+  }
+  s->registro_vazio = 1;
+  int ok = despejar_texto(s);
+  if (s->arquivo)
+    ok = fflush(s->arquivo) == 0 && ok;
+  return ok;
+}
+
+void liberar_texto(SAIDA *s) {
+  despejar_texto(s);
+  if (s->arquivo)
+    fflush(s->arquivo);
+  free(s->texto);
+}
+
+SAIDA *criar_saida_texto(FILE *arquivo, int fd) {
+  SAIDA *s = criar_saida();
+  if (!s)
+    return NULL;
+  s->texto = (char *)malloc(SAIDA_TEXTO);
+  if (!s->texto) {
+    free(s);
+    return NULL;
+  }
+  s->arquivo = arquivo;
+  s->fd = fd;
+  s->registro_vazio = 1;
+  s->escrever = escrever_texto;
+  s->finalizar = finalizar_texto;
+  s->liberar = liberar_texto;
+  return s;
+}
+
+SAIDA *saida_arquivo(FILE *arquivo) {
+  if (!arquivo)
+    return NULL;
+  return criar_saida_texto(arquivo, -1);
+}
+
+SAIDA *saida_descritor(int fd) {
+  if (fd < 0)
+    return NULL;
+  return criar_saida_texto(NULL, fd);
+}
+
+// Genéricas
+
+int saida_escrever(SAIDA *saida, const int *valores, size_t n) {
+  if (!saida)
+    return 0;
+  return saida->escrever(saida, valores, n);
+}
+
+int saida_finalizar(SAIDA *saida) {
+  if (!saida)
+    return 0;
+  return saida->finalizar(saida);
+}
+
+int saida_linha(SAIDA *saida) {
+  if (!saida)
+    return 0;
+  if (saida->escrever != escrever_texto)
+    return 1;
+  if (saida->usado == SAIDA_TEXTO && !despejar_texto(saida))
+    return 0;
+  saida->texto[saida->usado++] = '\n';
+  saida->registro_vazio = 1;
+  return 1;
+}
+
+size_t saida_quantidade(SAIDA *saida) { return saida ? saida->quantidade : 0; }
+
+int *saida_dados(SAIDA *saida, size_t *n) {
+  if (!saida || saida->escrever != escrever_vetor) {
+    if (n)
+      *n = 0;
+    return NULL;
+  }
+  if (n)
+    *n = saida->n;
+  return saida->vetor;
+}
+
+void saida_apagar(SAIDA **saida) {
+  if (!saida || !*saida)
+    return;
+  if ((*saida)->liberar)
+    (*saida)->liberar(*saida);
+  free(*saida);
+  *saida = NULL;
+}
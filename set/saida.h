@@ -0,0 +1,180 @@
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+// Destino genérico para os elementos produzidos pelas operações do conjunto.
+typedef struct saida SAIDA;
+
+/**
+ * @brief Cria uma saída que entrega os elementos a uma função do usuário.
+ *
+ * Os elementos chegam em lotes, na ordem em que foram produzidos.
+ *
+ * @param emitir Função chamada a cada lote; deve retornar 1 para continuar ou
+ *               0 para interromper a operação que está produzindo.
+ * @param ctx Ponteiro repassado a cada chamada.
+ * @return Ponteiro para a saída criada ou NULL em caso de erro.
+ */
+SAIDA *saida_callback(int (*emitir)(void *ctx, const int *valores, size_t n),
+                      void *ctx);
+
+/**
+ * @brief Cria uma saída que acumula os elementos em um vetor que cresce.
+ *
+ * @param capacidade Capacidade inicial (pode ser 0).
+ * @return Ponteiro para a saída criada ou NULL em caso de erro.
+ */
+SAIDA *saida_vetor(size_t capacidade);
+
+/**
+ * @brief Cria uma saída que escreve em um vetor do chamador.
+ *
+ * Ao encher, a saída recusa novos elementos e a operação é interrompida.
+ *
+ * @param destino Vetor do chamador.
+ * @param capacidade Quantidade de posições de `destino`.
+ * @return Ponteiro para a saída criada ou NULL em caso de erro.
+ */
+SAIDA *saida_vetor_fixo(int *destino, size_t capacidade);
+
+/**
+ * @brief Cria uma saída de texto sobre um FILE* (ex.: stdout).
+ *
+ * Os elementos são formatados como "%d " por uma conversão própria, em um
+ * buffer grande, e despejados com fwrite(). Cada registro (ver
+ * saida_finalizar()) não vazio termina com uma quebra de linha.
+ *
+ * @param arquivo Arquivo aberto para escrita.
+ * @return Ponteiro para a saída criada ou NULL em caso de erro.
+ */
+SAIDA *saida_arquivo(FILE *arquivo);
+
+/**
+ * @brief Cria uma saída de texto sobre um descritor de arquivo.
+ *
+ * Mesmo formato de saida_arquivo(), mas escrevendo com write() diretamente,
+ * sem passar pelo stdio.
+ *
+ * @param fd Descritor aberto para escrita.
+ * @return Ponteiro para a saída criada ou NULL em caso de erro.
+ */
+SAIDA *saida_descritor(int fd);
+
+/**
+ * @brief Escreve um lote de elementos na saída.
+ *
+ * @param saida Ponteiro para a saída.
+ * @param valores Elementos a escrever.
+ * @param n Quantidade de elementos.
+ * @return 1 se a operação produtora deve continuar, 0 se a saída recusou
+ *         (erro, vetor cheio ou callback pediu para parar).
+ */
+int saida_escrever(SAIDA *saida, const int *valores, size_t n);
+
+/**
+ * @brief Encerra um registro (ex.: o resultado de uma operação).
+ *
+ * Nas saídas de texto escreve a quebra de linha (se o registro tiver
+ * elementos) e despeja o buffer.
+ *
+ * @param saida Ponteiro para a saída.
+ * @return 1 em caso de sucesso, 0 em caso de erro de escrita.
+ */
+int saida_finalizar(SAIDA *saida);
+
+/**
+ * @brief Encerra um registro sem despejar o buffer.
+ *
+ * Nas saídas de texto escreve a quebra de linha mesmo em registro vazio, então
+ * cada registro ocupa exatamente uma linha (útil para respostas casadas com
+ * pedidos). O buffer só é despejado quando enche ou em saida_finalizar().
+ * Nas demais saídas não faz nada.
+ *
+ * @param saida Ponteiro para a saída.
+ * @return 1 em caso de sucesso, 0 em caso de erro de escrita.
+ */
+int saida_linha(SAIDA *saida);
+
+/**
+ * @brief Quantidade total de elementos aceitos pela saída.
+ *
+ * @param saida Ponteiro para a saída.
+ * @return Quantidade de elementos escritos desde a criação.
+ */
+size_t saida_quantidade(SAIDA *saida);
+
+/**
+ * @brief Acessa os elementos acumulados por saida_vetor() ou
+ * saida_vetor_fixo().
+ *
+ * @param saida Ponteiro para a saída.
+ * @param n Recebe a quantidade de elementos.
+ * @return Ponteiro para os elementos (válido até a próxima escrita), ou NULL
+ *         se a saída não for de vetor.
+ */
+int *saida_dados(SAIDA *saida, size_t *n);
+
+/**
+ * @brief Libera a saída (despejando antes o que estiver pendente).
+ *
+ * O vetor de saida_vetor() é liberado junto; o de saida_vetor_fixo() não.
+ *
+ * @param saida Endereço do ponteiro para a saída. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void saida_apagar(SAIDA **saida);
+
+/**
+ * @brief Converte um inteiro para texto decimal.
+ *
+ * Processa dois dígitos por vez com uma tabela, sem divisões por 10 nem
+ * printf.
+ *
+ * @param destino Buffer com pelo menos 11 posições livres.
+ * @param valor Inteiro a converter.
+ * @return Quantidade de caracteres escritos (sem terminador).
+ */
+size_t saida_formatar_int(char *destino, int valor);
+
+// Tamanho do lote acumulado antes de chamar a saída
+#define LOTE_SAIDA_TAMANHO 256
+
+/**
+ * @brief Acumulador local de elementos para uma saída.
+ *
+ * Evita uma chamada indireta por elemento: os produtores anexam no lote e a
+ * saída só é chamada a cada LOTE_SAIDA_TAMANHO elementos.
+ */
+typedef struct lote_saida {
+  SAIDA *saida;  /**< Saída de destino. */
+  int aceita;    /**< 0 depois que a saída recusou um lote. */
+  size_t n;      /**< Elementos pendentes. */
+  int valores[LOTE_SAIDA_TAMANHO]; /**< Elementos pendentes. */
+} LOTE_SAIDA;
+
+// Prepara o lote sobre uma saída
+static inline void lote_iniciar(LOTE_SAIDA *lote, SAIDA *saida) {
+  lote->saida = saida;
+  lote->aceita = 1;
+  lote->n = 0;
+}
+
+// Entrega os pendentes à saída; retorna 0 se a saída recusou
+static inline int lote_descarregar(LOTE_SAIDA *lote) {
+  if (lote->n > 0 && lote->aceita)
+    lote->aceita = saida_escrever(lote->saida, lote->valores, lote->n);
+  lote->n = 0;
+  return lote->aceita;
+}
+
+// Anexa um elemento; retorna 0 se a saída recusou e a produção deve parar
+static inline int lote_anexar(LOTE_SAIDA *lote, int valor) {
+  lote->valores[lote->n++] = valor;
+  if (lote->n == LOTE_SAIDA_TAMANHO)
+    return lote_descarregar(lote);
+  return lote->aceita;
+}
+
+#endif // SAIDA_H
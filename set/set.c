@@ -1,14 +1,31 @@
 #include <../ARVORE_LLRB/arvore_llrb.h>
 #include <../AVL/bst_avl.h>
+#include <../COMPRIMIDO/comprimido.h>
+#include <../SPLAY/splay.h>
+#include <../WAVL/wavl.h>
+#include <../EYTZINGER/eytzinger.h>
+#include <../INTERVALOS/intervalos.h>
+#include <../SKIPLIST/skiplist.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "buffer.h"
+#include "contagem.h"
+#include "esboco.h"
+#include "estatisticas.h"
+#include "filtro.h"
+#include "ordenacao.h"
+#include "saida.h"
+#include "set.h"
 
 /**
  * @brief Estrutura de operações genéricas para árvores.
  *
  * Esta estrutura define um conjunto de ponteiros de função que abstraem
  * operações fundamentais, como inserir, remover, buscar, criar, apagar
- * e imprimir elementos de uma árvore.
+ * e percorrer em ordem os elementos de uma árvore.
  */
 typedef struct arvore {
   int (*inserir)(void *arv,
@@ -20,68 +37,364 @@ typedef struct arvore {
   void *(*criar)(void);     /**< Função para criar uma nova árvore. */
   void (*apagar)(
       void **arv); /**< Função para apagar a árvore e liberar memória. */
-  void (*imprimir)(
-      void *arv);  /**< Função para imprimir os elementos da árvore. */
+  void (*iterador)(void *arv,
+                   ITERADOR *it); /**< Prepara o percurso em ordem. */
+  int (*iterador_proximo)(
+      ITERADOR *it, int *valor); /**< Próxima chave do percurso. */
+  int (*iterador_buscar)(ITERADOR *it, int alvo,
+                         int *valor); /**< Avança até a chave >= alvo. */
+  size_t (*iterador_lote)(ITERADOR *it, int *destino,
+                          size_t capacidade); /**< Próximas chaves de uma
+                                                   vez (ou NULL). */
+  int (*construir)(void *arv, const int *chaves, size_t n,
+                   int threads); /**< Constrói a partir de chaves ordenadas. */
+  int (*altura)(void *arv); /**< Altura atual da estrutura. */
+  int (*dividir)(void *arv, int chave, void *menores,
+                 void *maiores); /**< Divide pela chave (ou NULL). */
+  int (*juntar)(void *arv, void *maiores); /**< Junta ao fim (ou NULL). */
+  int (*extremos)(void *arv, int *menor,
+                  int *maior); /**< Menor e maior chave (ou NULL). */
   void *estrutura; /**< Ponteiro genérico para a estrutura da árvore. */
 } Arvore;
 
+/*
+    Modo bufferizado (ver set_bufferizar()): o buffer só é consolidado quando
+    passa de max(limite, tamanho / SET_BUFFER_FRACAO) chaves, de modo que o
+    custo da reconstrução (linear no conjunto) se dilui entre as alterações:
+    numa ingestão o buffer chega ao tamanho da árvore antes de ser aplicado,
+    e o trabalho total de reconstrução fica em O(n).
+    Consolidações forçadas por leituras ordenadas com poucas chaves pendentes
+    aplicam as alterações uma a uma, em ordem, em vez de reconstruir.
+*/
+#define SET_BUFFER_FRACAO 2
+#define SET_BUFFER_RECONSTRUIR 8 // Reconstrói se pendentes * 8 >= tamanho
+
+/*
+    Contagem sem materializar (ver set_tamanho_interseccao()): os percursos
+    são lidos em lotes de SET_CONTAGEM_LOTE chaves na pilha, e um conjunto
+    SET_CONTAGEM_SALTOS vezes menor que o outro troca a intercalação por
+    saltos no maior.
+*/
+#define SET_CONTAGEM_LOTE 256
+#define SET_CONTAGEM_SALTOS 32
+
+/*
+    Recolha da skip list (ver set_recolher()): liberar os nós retirados
+    exige varrer a lista inteira, então a varredura só acontece quando eles
+    passam de max(SET_RECOLHER_MIN, tamanho / SET_RECOLHER_FRACAO). O custo
+    fica O(1) amortizado por remoção e a memória presa em nós retirados
+    fica limitada a uma fração do conjunto.
+*/
+#define SET_RECOLHER_MIN 1024
+#define SET_RECOLHER_FRACAO 4
+
+// Capacidade mínima do filtro de Bloom de um conjunto (ver set_filtrar())
+#define SET_FILTRO_CAPACIDADE_MIN 64
+
+// Observador registrado em um conjunto (ver set_observar())
+typedef struct observador {
+  SET_OBSERVADOR notificar;
+  void *ctx;
+  struct observador *prox;
+} OBSERVADOR;
+
 /**
  * @brief Estrutura que representa um conjunto utilizando árvores.
  *
- * O conjunto é implementado como uma abstração que utiliza árvores AVL
- * ou Red-Black internamente, permitindo operações típicas de conjuntos,
+ * O conjunto é implementado como uma abstração que utiliza árvores AVL,
+ * Red-Black ou uma skip list internamente, permitindo operações típicas de conjuntos,
  * como união, interseção, inserção e busca de elementos.
  */
 typedef struct set {
   struct arvore
       *SET; /**< Estrutura de operações e dados da árvore subjacente. */
-  int opt;  /**< Identificador do tipo de árvore: AVL ou Red-Black. */
+  int opt;  /**< Identificador da estrutura: AVL, Red-Black ou Skip List. */
+  atomic_size_t tamanho; /**< Quantidade de elementos (atômica por causa da
+                            skip list concorrente). */
+  _Atomic uint64_t assinatura; /**< Soma do hash de cada elemento (ver
+                                   set_assinatura()). */
+  atomic_int resumo_incerto; /**< `tamanho` e `assinatura` precisam ser
+                                recalculados (depois de set_dividir()). */
+  atomic_int assinatura_incerta; /**< Só `assinatura` precisa ser recalculada
+                                    (conjuntos montados por faixas). */
+  uint64_t id; /**< Identificador único, nunca reutilizado. */
+  _Atomic uint64_t versao; /**< Alterações sofridas (ver set_versao()). */
+  OBSERVADOR *observadores; /**< Avisados a cada alteração do conjunto. */
+  BUFFER *buffer; /**< Alterações pendentes (modo bufferizado) ou NULL. */
+  size_t buffer_limite; /**< Pendentes mínimas antes de consolidar. */
+  FILTRO *filtro; /**< Pré-filtro de pertinência (ver set_filtrar()) ou
+                       NULL. */
+  int filtro_desatualizado; /**< O filtro não cobre todos os elementos e é
+                                 ignorado até ser reconstruído. */
+  ESBOCO *esboco; /**< Esboço de cardinalidade (ver set_esbocar()) ou
+                       NULL. */
+#ifdef SET_ESTATISTICAS
+  ESTATISTICAS estat; /**< Contadores estruturais do conjunto. */
+#endif
 } SET;
 
+// Próximo identificador de conjunto (ver set_id())
+static _Atomic uint64_t proximo_id = 1;
+
+// Heap de iteradores usado na união de k conjuntos
+typedef struct fonte_uniao {
+  ITERADOR it;
+  int valor; // Elemento corrente (ainda não emitido) desta fonte
+} FONTE_UNIAO;
+
 // Protocolos das funções
 
+int definir_operacoes(Arvore *arv, int opt);
 SET *criar_set(int opt);
 void set_apagar(SET **set);
 void set_imprimir(SET *set);
+int set_emitir(SET *set, SAIDA *saida);
+void imprimir_operacao(SET *set1, SET *set2,
+                       int (*operacao)(SET **sets, size_t k, SAIDA *saida));
 
 int set_pertence(SET *set, int valor);
 
-void in_order_uniao(void *no, SET *set_origem, SET *set_verificados);
 void set_uniao(SET *set1, SET *set2);
-
 void set_interseccao(SET *set1, SET *set2);
-void in_order_interseccao(void *no, SET *set_origem, SET *set_destino,
-                          SET *set_interseccao);
 
 int set_remover(SET *set, int valor);
 
 int set_inserir(SET *set, int valor);
 
-void *obter_esquerda(void *no, int opt);
-void *obter_direita(void *no, int opt);
-int obter_valor(void *no, int opt);
+uint64_t hash_elemento(int valor);
+uint64_t assinatura_chaves(const int *chaves, size_t n);
+void registrar_insercao(SET *set, int valor);
+void registrar_remocao(SET *set, int valor);
+void recalcular_resumo(SET *set);
+void recalcular_assinatura(SET *set);
+uint64_t set_assinatura(SET *set);
+uint64_t set_id(SET *set);
+uint64_t set_versao(SET *set);
+int set_estrutura(SET *set);
+int set_igual(SET *a, SET *b);
+int set_subconjunto(SET *a, SET *b);
+int set_disjuntos(SET *a, SET *b);
+size_t ler_lote(ITERADOR *it, int *destino, size_t capacidade);
+void completar_lote(ITERADOR *it, int *lote, size_t *inicio, size_t *n,
+                    int *fim);
+size_t contar_interseccao(SET *a, SET *b);
+size_t set_tamanho_interseccao(SET *a, SET *b);
+size_t set_tamanho_uniao(SET *a, SET *b);
+size_t set_tamanho_diferenca(SET *a, SET *b);
 
-// Wrapper usado para funções menos importantes das estruturas
-void *obter_esquerda(void *no, int opt) {
-  // escolhe-se de acordo com a opt de estrutura escolhida
-  // se for verdadeira a expressão de ser igual à 0, então é AVL
-  // se falsa então é a Rubro-Negra
-  return (opt == 0) ? obter_esquerda_avl(no) : obter_esquerda_llrb(no);
-}
+void set_iterador(SET *set, ITERADOR *it);
+int set_iterador_proximo(ITERADOR *it, int *valor);
+int set_iterador_buscar(ITERADOR *it, int alvo, int *valor);
 
-void *obter_direita(void *no, int opt) {
-  return (opt == 0) ? obter_direita_avl(no) : obter_direita_llrb(no);
-}
+int skiplist_construir_lote(SKIPLIST *lista, const int *chaves, size_t n,
+                            int threads);
+int eytzinger_construir_lote(EYTZINGER *E, const int *chaves, size_t n,
+                             int threads);
+int set_congelar(SET *set);
+int set_converter(SET *set, int opt);
+int set_compressao(SET *set, struct set_compressao *relatorio);
+int set_autoajuste(SET *set, int ligar);
+int set_recolher(SET *set);
+SET *set_construir(int opt, const int *valores, size_t n, int threads);
+SET *set_construir_ordenado(int opt, const int *chaves, size_t n);
+int set_preencher(SET *set, const int *valores, size_t n, int threads);
+size_t set_tamanho(SET *set);
+int set_estatisticas(SET *set, struct set_stats *stats);
 
-int obter_valor(void *no, int opt) {
-  if (!no) {
-    return -1;
-  }
-  if (opt == 0) {
-    return obter_valor_avl((NO *)no);
+int set_bufferizar(SET *set, size_t limite);
+int set_consolidar(SET *set);
+int inserir_bufferizado(SET *set, int valor);
+int remover_bufferizado(SET *set, int valor);
+int reconstruir_bufferizado(SET *set, const int *inseridos, size_t ni,
+                            const int *removidos, size_t nr);
+
+int set_dividir(SET *set, int chave, SET **menores, SET **maiores);
+int set_juntar(SET *a, SET *b);
+int set_concatenar(SET **sets, size_t k);
+int set_migravel(SET *set, int opt);
+
+int set_filtrar(SET *set, int ligar);
+int *coletar_chaves(SET *set, size_t *n);
+int reconstruir_filtro(SET *set);
+int filtro_permite(SET *set, int valor);
+
+int set_esbocar(SET *set, int ligar);
+int reconstruir_esboco(SET *set);
+int esbocos_dos_sets(SET **sets, size_t k, const ESBOCO **esbocos);
+double set_estimar_uniao(SET **sets, size_t k);
+double set_estimar_jaccard(SET **sets, size_t k);
+double set_estimar_interseccao(SET **sets, size_t k);
+
+int set_observar(SET *set, SET_OBSERVADOR notificar, void *ctx);
+int set_desobservar(SET *set, SET_OBSERVADOR notificar, void *ctx);
+void notificar_observadores(SET *set, int evento, int valor);
+
+void descer_heap_uniao(FONTE_UNIAO **heap, size_t k, size_t i);
+int comparar_tamanho_set(const void *a, const void *b);
+int set_uniao_k_emitir(SET **sets, size_t k, SAIDA *saida);
+int set_interseccao_k_emitir(SET **sets, size_t k, SAIDA *saida);
+SET *construir_resultado(int opt, SAIDA *saida, int completo);
+int todos_intervalos(SET **sets, size_t k);
+int *copiar_faixas(SET *set, size_t *r);
+size_t unir_faixas(const int *ai, const int *af, size_t ra, const int *bi,
+                   const int *bf, size_t rb, int *ci, int *cf);
+size_t cruzar_faixas(const int *ai, const int *af, size_t ra, const int *bi,
+                     const int *bf, size_t rb, int *ci, int *cf);
+SET *set_de_faixas(const int *ini, const int *fim, size_t r);
+SET *operar_faixas(SET **sets, size_t k, int uniao);
+int contar_interseccao_faixas(SET *a, SET *b, size_t *total);
+SET *set_uniao_k(SET **sets, size_t k);
+SET *set_interseccao_k(SET **sets, size_t k);
+
+// Preenche as operações da estrutura escolhida (0 se a opção for inválida)
+int definir_operacoes(Arvore *arv, int opt) {
+  /*
+    De acordo com a opção escolhida pelo usuário que podemos
+    colocar as funções de atributo (característica) do set
+    na estrutura de operações
+  */
+
+  if (opt == SET_AVL) {
+    // AVL
+    arv->inserir = (int (*)(void *, int))avl_inserir;
+    arv->remover = (int (*)(void *, int))avl_remover;
+    arv->buscar = (int (*)(void *, int))avl_buscar;
+    arv->criar = (void *(*)(void))criar_avl;
+    arv->apagar = (void (*)(void **))avl_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))avl_iterador;
+    arv->iterador_proximo = avl_iterador_proximo;
+    arv->iterador_buscar = avl_iterador_buscar;
+    arv->iterador_lote = NULL;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))avl_construir;
+    arv->altura = (int (*)(void *))avl_altura;
+    arv->dividir = (int (*)(void *, int, void *, void *))avl_dividir;
+    arv->juntar = (int (*)(void *, void *))avl_juntar;
+    arv->extremos = (int (*)(void *, int *, int *))avl_extremos;
+  } else if (opt == SET_LLRB) {
+    // LL-Red-Black
+    arv->inserir = (int (*)(void *, int))arvllrb_inserir;
+    arv->remover = (int (*)(void *, int))arvllrb_remover;
+    arv->buscar = (int (*)(void *, int))arvllrb_consultar;
+    arv->criar = (void *(*)(void))arvllrb_criar;
+    arv->apagar = (void (*)(void **))arvllrb_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))arvllrb_iterador;
+    arv->iterador_proximo = arvllrb_iterador_proximo;
+    arv->iterador_buscar = arvllrb_iterador_buscar;
+    arv->iterador_lote = NULL;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))arvllrb_construir;
+    arv->altura = (int (*)(void *))arvllrb_altura;
+    arv->dividir = (int (*)(void *, int, void *, void *))arvllrb_dividir;
+    arv->juntar = (int (*)(void *, void *))arvllrb_juntar;
+    arv->extremos = (int (*)(void *, int *, int *))arvllrb_extremos;
+  } else if (opt == SET_SKIPLIST) {
+    // Skip List lock-free (várias threads escrevendo ao mesmo tempo)
+    arv->inserir = (int (*)(void *, int))skiplist_inserir;
+    arv->remover = (int (*)(void *, int))skiplist_remover;
+    arv->buscar = (int (*)(void *, int))skiplist_consultar;
+    arv->criar = (void *(*)(void))skiplist_criar;
+    arv->apagar = (void (*)(void **))skiplist_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))skiplist_iterador;
+    arv->iterador_proximo = skiplist_iterador_proximo;
+    arv->iterador_buscar = skiplist_iterador_buscar;
+    arv->iterador_lote = NULL;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))skiplist_construir_lote;
+    arv->altura = (int (*)(void *))skiplist_altura;
+    arv->dividir = NULL;
+    arv->juntar = NULL;
+    arv->extremos = NULL;
+  } else if (opt == SET_CONGELADO) {
+    // Vetor de Eytzinger imutável (ver set_congelar())
+    arv->inserir = (int (*)(void *, int))eytzinger_inserir;
+    arv->remover = (int (*)(void *, int))eytzinger_remover;
+    arv->buscar = (int (*)(void *, int))eytzinger_consultar;
+    arv->criar = (void *(*)(void))eytzinger_criar;
+    arv->apagar = (void (*)(void **))eytzinger_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))eytzinger_iterador;
+    arv->iterador_proximo = eytzinger_iterador_proximo;
+    arv->iterador_buscar = eytzinger_iterador_buscar;
+    arv->iterador_lote = eytzinger_iterador_lote;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))eytzinger_construir_lote;
+    arv->altura = (int (*)(void *))eytzinger_altura;
+    arv->dividir = NULL;
+    arv->juntar = NULL;
+    arv->extremos = NULL;
+  } else if (opt == SET_INTERVALOS) {
+    // Faixas de chaves consecutivas em uma AVL
+    arv->inserir = (int (*)(void *, int))intervalos_inserir;
+    arv->remover = (int (*)(void *, int))intervalos_remover;
+    arv->buscar = (int (*)(void *, int))intervalos_consultar;
+    arv->criar = (void *(*)(void))intervalos_criar;
+    arv->apagar = (void (*)(void **))intervalos_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))intervalos_iterador;
+    arv->iterador_proximo = intervalos_iterador_proximo;
+    arv->iterador_buscar = intervalos_iterador_buscar;
+    arv->iterador_lote = intervalos_iterador_lote;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))intervalos_construir;
+    arv->altura = (int (*)(void *))intervalos_altura;
+    arv->dividir = (int (*)(void *, int, void *, void *))intervalos_dividir;
+    arv->juntar = (int (*)(void *, void *))intervalos_juntar;
+    arv->extremos = (int (*)(void *, int *, int *))intervalos_extremos;
+  } else if (opt == SET_WAVL) {
+    // AVL fraca (balanceada por postos)
+    arv->inserir = (int (*)(void *, int))wavl_inserir;
+    arv->remover = (int (*)(void *, int))wavl_remover;
+    arv->buscar = (int (*)(void *, int))wavl_buscar;
+    arv->criar = (void *(*)(void))wavl_criar;
+    arv->apagar = (void (*)(void **))wavl_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))wavl_iterador;
+    arv->iterador_proximo = wavl_iterador_proximo;
+    arv->iterador_buscar = wavl_iterador_buscar;
+    arv->iterador_lote = NULL;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))wavl_construir;
+    arv->altura = (int (*)(void *))wavl_altura;
+    arv->dividir = (int (*)(void *, int, void *, void *))wavl_dividir;
+    arv->juntar = (int (*)(void *, void *))wavl_juntar;
+    arv->extremos = (int (*)(void *, int *, int *))wavl_extremos;
+  } else if (opt == SET_SPLAY) {
+    // Splay: consultas trazem a chave para a raiz (ver set_autoajuste())
+    arv->inserir = (int (*)(void *, int))splay_inserir;
+    arv->remover = (int (*)(void *, int))splay_remover;
+    arv->buscar = (int (*)(void *, int))splay_buscar;
+    arv->criar = (void *(*)(void))splay_criar;
+    arv->apagar = (void (*)(void **))splay_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))splay_iterador;
+    arv->iterador_proximo = splay_iterador_proximo;
+    arv->iterador_buscar = splay_iterador_buscar;
+    arv->iterador_lote = NULL;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))splay_construir;
+    arv->altura = (int (*)(void *))splay_altura;
+    arv->dividir = (int (*)(void *, int, void *, void *))splay_dividir;
+    arv->juntar = (int (*)(void *, void *))splay_juntar;
+    arv->extremos = (int (*)(void *, int *, int *))splay_extremos;
+  } else if (opt == SET_COMPRIMIDO) {
+    // Blocos comprimidos somente leitura (ver set_converter())
+    arv->inserir = (int (*)(void *, int))comprimido_inserir;
+    arv->remover = (int (*)(void *, int))comprimido_remover;
+    arv->buscar = (int (*)(void *, int))comprimido_consultar;
+    arv->criar = (void *(*)(void))comprimido_criar;
+    arv->apagar = (void (*)(void **))comprimido_apagar;
+    arv->iterador = (void (*)(void *, ITERADOR *))comprimido_iterador;
+    arv->iterador_proximo = comprimido_iterador_proximo;
+    arv->iterador_buscar = comprimido_iterador_buscar;
+    arv->iterador_lote = comprimido_iterador_lote;
+    arv->construir =
+        (int (*)(void *, const int *, size_t, int))comprimido_construir;
+    arv->altura = (int (*)(void *))comprimido_altura;
+    arv->dividir = NULL;
+    arv->juntar = NULL;
+    arv->extremos = NULL;
   } else {
-    return obter_valor_llrb((NO *)no);
+    return 0;
   }
+
+  return 1;
 }
 
 // Função para criar o set
@@ -97,50 +410,80 @@ SET *criar_set(int opt) {
   }
 
   s->opt = opt;
+  atomic_init(&s->tamanho, 0);
+  atomic_init(&s->assinatura, 0);
+  atomic_init(&s->resumo_incerto, 0);
+  atomic_init(&s->assinatura_incerta, 0);
+  s->id = atomic_fetch_add_explicit(&proximo_id, 1, memory_order_relaxed);
+  atomic_init(&s->versao, 0);
+  s->observadores = NULL;
+  s->buffer = NULL;
+  s->buffer_limite = 0;
+  s->filtro = NULL;
+  s->filtro_desatualizado = 0;
+  s->esboco = NULL;
+#ifdef SET_ESTATISTICAS
+  estatisticas_iniciar(&s->estat);
+#endif
 
-  /*
-    De acordo com a opção escolhida pelo usuário que podemos
-    colocar as funções de atributo (característica) do set
-    no proprio s(set) criado agora
-  */
-
-  if (opt == 0) {
-    // AVL
-    s->SET->inserir = (int (*)(void *, int))avl_inserir;
-    s->SET->remover = (int (*)(void *, int))avl_remover;
-    s->SET->buscar = (int (*)(void *, int))avl_buscar;
-    s->SET->criar = (void *(*)(void))criar_avl;
-    s->SET->apagar = (void (*)(void **))avl_apagar;
-    s->SET->imprimir = (void (*)(void *))avl_imprimir;
-  } else if (opt == 1) {
-    // LL-Red-Black
-    s->SET->inserir = (int (*)(void *, int))arvllrb_inserir;
-    s->SET->remover = (int (*)(void *, int))arvllrb_remover;
-    s->SET->buscar = (int (*)(void *, int))arvllrb_consultar;
-    s->SET->criar = (void *(*)(void))arvllrb_criar;
-    s->SET->apagar = (void (*)(void **))arvllrb_apagar;
-    s->SET->imprimir = (void (*)(void *))arvllrb_imprimir;
-  } else {
+  if (!definir_operacoes(s->SET, opt)) {
     free(s->SET);
     free(s);
     return NULL;
   }
 
+  ESTAT_USAR(&s->estat);
   s->SET->estrutura = s->SET->criar();
+  ESTAT_USAR(NULL);
   return s;
 }
 
+// Imprime o conjunto na saída padrão (uma linha, em ordem crescente)
 void set_imprimir(SET *set) {
   if (!set)
     return;
 
-  return set->SET->imprimir(set->SET->estrutura);
+  SAIDA *saida = saida_arquivo(stdout);
+  if (!saida)
+    return;
+  set_emitir(set, saida);
+  saida_finalizar(saida);
+  saida_apagar(&saida);
+}
+
+// Envia os elementos do conjunto, em ordem, para a saída
+int set_emitir(SET *set, SAIDA *saida) {
+  if (!set || !saida)
+    return 0;
+
+  LOTE_SAIDA lote;
+  ITERADOR it;
+  int valor, aceita = 1;
+
+  lote_iniciar(&lote, saida);
+  set_iterador(set, &it);
+  while (aceita && set_iterador_proximo(&it, &valor))
+    aceita = lote_anexar(&lote, valor);
+  iterador_finalizar(&it);
+  return lote_descarregar(&lote);
 }
 
 // Apaga todo o set existente
 void set_apagar(SET **set) {
   if (!set || !*set)
     return;
+
+  // Quem depende do conjunto é avisado antes de ele deixar de existir
+  notificar_observadores(*set, SET_EVENTO_APAGADO, 0);
+  while ((*set)->observadores) {
+    OBSERVADOR *o = (*set)->observadores;
+    (*set)->observadores = o->prox;
+    free(o);
+  }
+
+  buffer_apagar(&(*set)->buffer);
+  filtro_apagar(&(*set)->filtro);
+  esboco_apagar(&(*set)->esboco);
   (*set)->SET->apagar(&((*set)->SET->estrutura));
   free((*set)->SET);
   free(*set);
@@ -151,22 +494,125 @@ void set_apagar(SET **set) {
 int set_pertence(SET *set, int valor) {
   if (!set || !set->SET)
     return 0;
-  return set->SET->buscar(set->SET->estrutura, valor);
+  // A maioria das ausências para aqui, sem descer a árvore
+  if (!filtro_permite(set, valor))
+    return 0;
+  if (set->buffer) {
+    // Uma alteração pendente é mais nova que a árvore
+    int estado = buffer_consultar(set->buffer, valor);
+    if (estado != BUFFER_AUSENTE)
+      return estado == BUFFER_INSERIDO;
+  }
+  ESTAT_USAR(&set->estat);
+  int resp = set->SET->buscar(set->SET->estrutura, valor);
+  ESTAT_USAR(NULL);
+  return resp;
+}
+
+/*
+    Assinatura do conjunto: soma (mod 2^64) de um hash de cada elemento. A
+    soma não depende da ordem, e inserir ou remover um elemento custa uma
+    adição, então conjuntos diferentes quase sempre se distinguem em O(1)
+    (ver set_igual()). O hash é o finalizador do splitmix64, que espalha
+    chaves vizinhas por todos os bits.
+*/
+uint64_t hash_elemento(int valor) {
+  uint64_t x = (uint64_t)(uint32_t)valor + 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+uint64_t assinatura_chaves(const int *chaves, size_t n) {
+  uint64_t soma = 0;
+  for (size_t i = 0; i < n; i++)
+    soma += hash_elemento(chaves[i]);
+  return soma;
+}
+
+// Contabiliza um elemento que entrou no conjunto e avisa os observadores
+void registrar_insercao(SET *set, int valor) {
+  atomic_fetch_add_explicit(&set->versao, 1, memory_order_release);
+  atomic_fetch_add_explicit(&set->tamanho, 1, memory_order_relaxed);
+  atomic_fetch_add_explicit(&set->assinatura, hash_elemento(valor),
+                            memory_order_relaxed);
+  if (set->filtro && !set->filtro_desatualizado) {
+    filtro_adicionar(set->filtro, valor);
+    set->filtro_desatualizado = filtro_saturado(set->filtro);
+  }
+  if (set->esboco)
+    esboco_adicionar(set->esboco, valor);
+  notificar_observadores(set, SET_EVENTO_INSERIDO, valor);
+}
+
+void registrar_remocao(SET *set, int valor) {
+  atomic_fetch_add_explicit(&set->versao, 1, memory_order_release);
+  atomic_fetch_sub_explicit(&set->tamanho, 1, memory_order_relaxed);
+  atomic_fetch_sub_explicit(&set->assinatura, hash_elemento(valor),
+                            memory_order_relaxed);
+  if (set->filtro && !set->filtro_desatualizado) {
+    filtro_remover(set->filtro);
+    set->filtro_desatualizado = filtro_saturado(set->filtro);
+  }
+  if (set->esboco)
+    esboco_remover(set->esboco);
+  notificar_observadores(set, SET_EVENTO_REMOVIDO, valor);
 }
 
 // Se utiliza da estrutura especificada para remover um valor
 int set_remover(SET *set, int valor) {
   if (!set || !set->SET)
     return -1;
-  return set->SET->remover(set->SET->estrutura, valor);
+  int resp;
+  if (set->buffer) {
+    resp = remover_bufferizado(set, valor);
+  } else {
+    ESTAT_USAR(&set->estat);
+    resp = set->SET->remover(set->SET->estrutura, valor);
+    ESTAT_USAR(NULL);
+    if (resp == 1)
+      registrar_remocao(set, valor);
+  }
+  if (set->filtro_desatualizado)
+    reconstruir_filtro(set);
+  if (set->esboco && esboco_saturado(set->esboco))
+    reconstruir_esboco(set);
+  return resp;
 }
 
 // Se utiliza da estrutura especificada para inserir um valor
 int set_inserir(SET *set, int valor) {
   if (!set)
     return 0;
+  int resp;
+  if (set->buffer) {
+    resp = inserir_bufferizado(set, valor);
+  } else {
+    ESTAT_USAR(&set->estat);
+    resp = set->SET->inserir(set->SET->estrutura, valor);
+    ESTAT_USAR(NULL);
+    if (resp == 1)
+      registrar_insercao(set, valor);
+  }
+  if (set->filtro_desatualizado)
+    reconstruir_filtro(set);
+  if (set->esboco && esboco_saturado(set->esboco))
+    reconstruir_esboco(set);
+  return resp;
+}
 
-  return set->SET->inserir(set->SET->estrutura, valor);
+// Imprime na saída padrão o resultado de uma operação entre dois conjuntos
+void imprimir_operacao(SET *set1, SET *set2,
+                       int (*operacao)(SET **sets, size_t k, SAIDA *saida)) {
+  SET *sets[2] = {set1, set2};
+  SAIDA *saida = saida_arquivo(stdout);
+  if (!saida) {
+    printf("Erro: Falha ao criar a saída.\n");
+    return;
+  }
+  operacao(sets, 2, saida);
+  saida_finalizar(saida);
+  saida_apagar(&saida);
 }
 
 // Função para imprimir a união de dois conjuntos
@@ -177,94 +623,1467 @@ void set_uniao(SET *set1, SET *set2) {
     return;
   }
 
-  // Criação de um conjunto temporário para evitar duplicações
-  SET *conjunto_verificados = criar_set(set1->opt);
-  if (!conjunto_verificados) {
-    printf("Erro: Falha ao criar o conjunto temporário.\n");
+  // Intercala os dois percursos em ordem direto na saída, sem conjunto
+  // temporário
+  imprimir_operacao(set1, set2, set_uniao_k_emitir);
+}
+
+// Função de intersecção entre dois conjuntos
+void set_interseccao(SET *set1, SET *set2) {
+  if (!set1 || !set2) {
+    printf("Erro: Conjuntos inválidos.\n");
     return;
   }
 
-  // printf("União dos conjuntos: ");
+  imprimir_operacao(set1, set2, set_interseccao_k_emitir);
+}
 
-  // Realiza o percurso in-order para inserir os elementos únicos no conjunto
-  // temporário
-  in_order_uniao(set1->SET->estrutura, set1, conjunto_verificados);
-  in_order_uniao(set2->SET->estrutura, set2, conjunto_verificados);
+// Prepara um iterador em ordem sobre a estrutura do conjunto
+void set_iterador(SET *set, ITERADOR *it) {
+  if (!set || !set->SET) {
+    iterador_iniciar(it, NULL);
+    return;
+  }
+  // Percursos em ordem precisam da árvore em dia
+  if (set->buffer)
+    set_consolidar(set);
+  set->SET->iterador(set->SET->estrutura, it);
+  it->origem = set->SET; // Guarda as operações para o despacho
+}
 
-  // Imprime os elementos únicos armazenados no conjunto temporário
-  conjunto_verificados->SET->imprimir(conjunto_verificados->SET->estrutura);
+int set_iterador_proximo(ITERADOR *it, int *valor) {
+  if (!it->origem)
+    return 0;
+  return ((Arvore *)it->origem)->iterador_proximo(it, valor);
+}
 
-  // Libera o espaço alocado para o conjunto temporário
-  set_apagar(&conjunto_verificados);
+int set_iterador_buscar(ITERADOR *it, int alvo, int *valor) {
+  if (!it->origem)
+    return 0;
+  return ((Arvore *)it->origem)->iterador_buscar(it, alvo, valor);
 }
 
-// Função auxiliar para percorrer e imprimir elementos únicos
-void in_order_uniao(void *no, SET *set_origem, SET *set_verificados) {
-  if (!no)
-    return;
+// A skip list é ligada sequencialmente: o número de threads não se aplica
+int skiplist_construir_lote(SKIPLIST *lista, const int *chaves, size_t n,
+                            int threads) {
+  (void)threads;
+  return skiplist_construir(lista, chaves, n);
+}
 
-  // Percorre a subárvore esquerda
-  in_order_uniao(obter_esquerda(no, set_origem->opt), set_origem,
-                 set_verificados);
+// A montagem do vetor de Eytzinger também é sequencial
+int eytzinger_construir_lote(EYTZINGER *E, const int *chaves, size_t n,
+                             int threads) {
+  (void)threads;
+  return eytzinger_construir(E, chaves, n);
+}
+
+/*
+    Construção em lote: copia os valores, ordena e remove repetidos em
+    paralelo (radix sort) e então monta a estrutura já balanceada, também
+    em paralelo, em vez de n chamadas a set_inserir.
+*/
+SET *set_construir(int opt, const int *valores, size_t n, int threads) {
+  if (!valores && n > 0)
+    return NULL;
+
+  SET *s = criar_set(opt);
+  if (!s)
+    return NULL;
+  if (n == 0)
+    return s;
 
-  // Obtém o valor do nó atual
-  int valor = obter_valor(no, set_origem->opt);
+  int *chaves = (int *)malloc(n * sizeof(int));
+  if (!chaves) {
+    set_apagar(&s);
+    return NULL;
+  }
+  memcpy(chaves, valores, n * sizeof(int));
 
-  // Insere e imprime apenas valores únicos
-  if (valor > 0 && !set_pertence(set_verificados, valor)) {
-    set_inserir(set_verificados, valor);
+  threads = ordenacao_threads(threads);
+  size_t unicos = ordenar_unicos(chaves, n, threads);
+  ESTAT_USAR(&s->estat);
+  int resp = unicos > 0 &&
+             s->SET->construir(s->SET->estrutura, chaves, unicos, threads) == 1;
+  ESTAT_ALTURA((uint64_t)s->SET->altura(s->SET->estrutura));
+  ESTAT_USAR(NULL);
+  if (!resp) {
+    free(chaves);
+    set_apagar(&s);
+    return NULL;
   }
 
-  // Percorre a subárvore direita
-  in_order_uniao(obter_direita(no, set_origem->opt), set_origem,
-                 set_verificados);
+  atomic_store(&s->tamanho, unicos);
+  atomic_store(&s->assinatura, assinatura_chaves(chaves, unicos));
+  free(chaves);
+  return s;
 }
 
-// Função de intersecção entre dois conjuntos
-void set_interseccao(SET *set1, SET *set2) {
-  if (!set1 || !set2) {
-    printf("Erro: Conjuntos inválidos.\n");
-    return;
+// Cria um conjunto a partir de chaves já ordenadas e sem repetição
+SET *set_construir_ordenado(int opt, const int *chaves, size_t n) {
+  SET *s = criar_set(opt);
+  if (!s)
+    return NULL;
+  ESTAT_USAR(&s->estat);
+  int resp = n == 0 || s->SET->construir(s->SET->estrutura, chaves, n, 1) == 1;
+  ESTAT_ALTURA((uint64_t)s->SET->altura(s->SET->estrutura));
+  ESTAT_USAR(NULL);
+  if (!resp) {
+    set_apagar(&s);
+    return NULL;
   }
+  atomic_store(&s->tamanho, n);
+  atomic_store(&s->assinatura, assinatura_chaves(chaves, n));
+  return s;
+}
 
-  // Cria um conjunto temporário para armazenar a interseção
-  SET *conjunto_interseccao = criar_set(set1->opt);
-  if (!conjunto_interseccao) {
-    printf("Erro: Falha ao criar conjunto de interseção.\n");
-    return;
+/*
+    Construção em lote dentro de um conjunto vazio já existente: a
+    estrutura atual é preenchida no lugar, então o conjunto mantém
+    identidade, filtro, esboço, modo bufferizado, observadores e as opções
+    da própria estrutura (como o autoajuste da splay).
+*/
+int set_preencher(SET *set, const int *valores, size_t n, int threads) {
+  if (!set || !set->SET || (!valores && n > 0) ||
+      set->opt == SET_CONGELADO || set->opt == SET_COMPRIMIDO)
+    return -1;
+  // Remoções pendentes podem esconder chaves da árvore
+  if (set->buffer && set_consolidar(set) != 1)
+    return 0;
+  if (set_tamanho(set) != 0)
+    return 0;
+  if (n == 0)
+    return 1;
+
+  int *chaves = (int *)malloc(n * sizeof(int));
+  if (!chaves)
+    return 0;
+  memcpy(chaves, valores, n * sizeof(int));
+
+  threads = ordenacao_threads(threads);
+  size_t unicos = ordenar_unicos(chaves, n, threads);
+  ESTAT_USAR(&set->estat);
+  int resp = unicos > 0 && set->SET->construir(set->SET->estrutura, chaves,
+                                                unicos, threads) == 1;
+  ESTAT_ALTURA((uint64_t)set->SET->altura(set->SET->estrutura));
+  ESTAT_USAR(NULL);
+  if (!resp) {
+    free(chaves);
+    return 0;
   }
 
-  // Percorre o primeiro conjunto e verifica quais valores estão no segundo
-  in_order_interseccao(set1->SET->estrutura, set1, set2, conjunto_interseccao);
+  atomic_fetch_add_explicit(&set->versao, unicos, memory_order_release);
+  atomic_store(&set->tamanho, unicos);
+  atomic_store(&set->assinatura, assinatura_chaves(chaves, unicos));
+  if (set->filtro)
+    reconstruir_filtro(set);
+  if (set->esboco)
+    reconstruir_esboco(set);
+  for (size_t i = 0; i < unicos && set->observadores; i++)
+    notificar_observadores(set, SET_EVENTO_INSERIDO, chaves[i]);
+  free(chaves);
+  return 1;
+}
 
-  // Imprime os elementos do conjunto de interseção
-  set_imprimir(conjunto_interseccao);
+// Congela o conjunto em um vetor de Eytzinger
+int set_congelar(SET *set) { return set_converter(set, SET_CONGELADO); }
 
-  // Apaga o conjunto de interseção
-  set_apagar(&conjunto_interseccao);
+/*
+    Troca a estrutura: as chaves são copiadas em ordem para a estrutura
+    nova e as operações do conjunto passam a ser as dela. A estrutura
+    antiga só é apagada depois que a nova está pronta, então uma falha
+    deixa o conjunto como estava.
+*/
+int set_converter(SET *set, int opt) {
+  if (!set || !set->SET)
+    return -1;
+  if (set->opt == opt)
+    return 1;
+
+  Arvore nova;
+  if (!definir_operacoes(&nova, opt))
+    return -1;
+
+  SAIDA *saida = saida_vetor(set_tamanho(set));
+  if (!saida)
+    return 0;
+  if (!set_emitir(set, saida)) {
+    saida_apagar(&saida);
+    return 0;
+  }
+
+  size_t n;
+  int *chaves = saida_dados(saida, &n);
+
+  ESTAT_USAR(&set->estat);
+  nova.estrutura = nova.criar();
+  if (!nova.estrutura ||
+      (n > 0 && nova.construir(nova.estrutura, chaves, n, 1) != 1)) {
+    if (nova.estrutura)
+      nova.apagar(&nova.estrutura);
+    ESTAT_USAR(NULL);
+    saida_apagar(&saida);
+    return 0;
+  }
+  set->SET->apagar(&set->SET->estrutura);
+  ESTAT_USAR(NULL);
+
+  // set_emitir() já consolidou o buffer; só as árvores continuam com ele
+  if (opt != SET_AVL && opt != SET_LLRB && opt != SET_WAVL)
+    buffer_apagar(&set->buffer);
+  *set->SET = nova;
+  set->opt = opt;
+  atomic_store(&set->tamanho, n);
+  saida_apagar(&saida);
+  // A skip list aceita escritores concorrentes, que disputariam o filtro e
+  // o esboço sem sincronização: ela fica sem os dois, como em set_filtrar()
+  if (opt == SET_SKIPLIST) {
+    filtro_apagar(&set->filtro);
+    set->filtro_desatualizado = 0;
+    esboco_apagar(&set->esboco);
+  }
+  // Estruturas somente leitura trocam o Bloom por um filtro xor, menor e
+  // mais preciso (e o inverso ao voltar a uma estrutura mutável)
+  if (set->filtro)
+    reconstruir_filtro(set);
+  return 1;
 }
 
-// Função auxiliar para percorrer em ordem e verificar interseção
-void in_order_interseccao(void *no, SET *set_origem, SET *set_destino,
-                          SET *set_interseccao) {
-  if (!no)
+// Liga ou desliga o splay nas consultas de um conjunto SET_SPLAY
+int set_autoajuste(SET *set, int ligar) {
+  if (!set || !set->SET || set->opt != SET_SPLAY)
+    return -1;
+  return splay_autoajuste((SPLAY *)set->SET->estrutura, ligar);
+}
+
+// Libera os nós retirados da skip list, se já forem muitos
+int set_recolher(SET *set) {
+  if (!set || !set->SET)
+    return -1;
+  if (set->opt != SET_SKIPLIST)
+    return 0;
+  SKIPLIST *lista = (SKIPLIST *)set->SET->estrutura;
+  size_t retirados = skiplist_retirados(lista);
+  if (retirados < SET_RECOLHER_MIN ||
+      retirados < set_tamanho(set) / SET_RECOLHER_FRACAO)
+    return 0;
+  skiplist_recolher(lista);
+  return 1;
+}
+
+/*
+    Relatório de compressão: o tamanho real de um conjunto comprimido, ou,
+    para as outras estruturas, o que a compressão produziria, medido bloco
+    a bloco sobre o percurso sem montar nada.
+*/
+int set_compressao(SET *set, struct set_compressao *relatorio) {
+  if (!set || !set->SET || !relatorio)
+    return -1;
+
+  memset(relatorio, 0, sizeof(*relatorio));
+  relatorio->elementos = set_tamanho(set);
+  if (set->opt == SET_COMPRIMIDO) {
+    COMPRIMIDO *C = (COMPRIMIDO *)set->SET->estrutura;
+    relatorio->blocos = comprimido_blocos(C);
+    relatorio->bytes = comprimido_bytes(C);
+  } else {
+    int lote[COMPRIMIDO_BLOCO];
+    size_t q;
+    ITERADOR it;
+    set_iterador(set, &it);
+    while ((q = ler_lote(&it, lote, COMPRIMIDO_BLOCO)) > 0) {
+      relatorio->blocos++;
+      relatorio->bytes += comprimido_bytes_bloco(lote, q);
+    }
+    iterador_finalizar(&it);
+  }
+  relatorio->bytes_vetor = relatorio->elementos * sizeof(int);
+  if (relatorio->bytes > 0) {
+    relatorio->razao = (double)relatorio->bytes_vetor / relatorio->bytes;
+    relatorio->bits_por_chave =
+        8.0 * (double)relatorio->bytes / (double)relatorio->elementos;
+  }
+  return 1;
+}
+
+/*
+    As árvores não guardam o tamanho das subárvores, então os pedaços de
+    set_dividir() só conhecem o próprio tamanho e assinatura quando alguém
+    pergunta: a primeira consulta percorre os elementos e as seguintes
+    voltam a ser O(1).
+*/
+void recalcular_resumo(SET *set) {
+  if (set->opt == SET_INTERVALOS) {
+    // O tamanho sai das faixas; a assinatura fica para quem pedir
+    size_t n = intervalos_tamanho((INTERVALOS *)set->SET->estrutura);
+    atomic_store_explicit(&set->tamanho, n, memory_order_relaxed);
+    atomic_store_explicit(&set->assinatura_incerta, 1, memory_order_relaxed);
+    atomic_store_explicit(&set->resumo_incerto, 0, memory_order_release);
     return;
+  }
+
+  ITERADOR it;
+  int valor;
+  size_t n = 0;
+  uint64_t soma = 0;
+  set->SET->iterador(set->SET->estrutura, &it);
+  while (set->SET->iterador_proximo(&it, &valor)) {
+    n++;
+    soma += hash_elemento(valor);
+  }
+  iterador_finalizar(&it);
+  atomic_store_explicit(&set->tamanho, n, memory_order_relaxed);
+  atomic_store_explicit(&set->assinatura, soma, memory_order_relaxed);
+  atomic_store_explicit(&set->resumo_incerto, 0, memory_order_release);
+}
+
+/*
+    Conjuntos de faixas montados sem passar pelas chaves (ver
+    operar_faixas()) só calculam a assinatura, que precisa do hash de cada
+    elemento, quando alguém a consulta. Alterações feitas nesse meio tempo
+    somam o seu hash normalmente e são cobertas pelo recálculo.
+*/
+void recalcular_assinatura(SET *set) {
+  ITERADOR it;
+  int lote[SET_CONTAGEM_LOTE];
+  size_t n;
+  uint64_t soma = 0;
+  set->SET->iterador(set->SET->estrutura, &it);
+  it.origem = set->SET;
+  while ((n = ler_lote(&it, lote, SET_CONTAGEM_LOTE)) > 0)
+    soma += assinatura_chaves(lote, n);
+  iterador_finalizar(&it);
+  atomic_store_explicit(&set->assinatura, soma, memory_order_relaxed);
+  atomic_store_explicit(&set->assinatura_incerta, 0, memory_order_release);
+}
+
+// Quantidade de elementos do conjunto, em O(1)
+size_t set_tamanho(SET *set) {
+  if (!set)
+    return 0;
+  if (atomic_load_explicit(&set->resumo_incerto, memory_order_acquire))
+    recalcular_resumo(set);
+  return atomic_load_explicit(&set->tamanho, memory_order_relaxed);
+}
+
+// Identificador do conjunto (único durante toda a execução)
+uint64_t set_id(SET *set) { return set ? set->id : 0; }
 
-  // Fica mais óbvio que estamos pegando a sub-árvore esquerda
-  void *esquerda = obter_esquerda(no, set_origem->opt);
-  in_order_interseccao(esquerda, set_origem, set_destino, set_interseccao);
+// Quantidade de alterações do conteúdo desde a criação
+uint64_t set_versao(SET *set) {
+  if (!set)
+    return 0;
+  return atomic_load_explicit(&set->versao, memory_order_acquire);
+}
 
-  // valor da raiz obtido
-  int valor = obter_valor(no, set_origem->opt);
+int set_estrutura(SET *set) { return set ? set->opt : -1; }
+
+// Assinatura dos elementos do conjunto, em O(1)
+uint64_t set_assinatura(SET *set) {
+  if (!set)
+    return 0;
+  if (atomic_load_explicit(&set->resumo_incerto, memory_order_acquire))
+    recalcular_resumo(set);
+  if (atomic_load_explicit(&set->assinatura_incerta, memory_order_acquire))
+    recalcular_assinatura(set);
+  return atomic_load_explicit(&set->assinatura, memory_order_relaxed);
+}
+
+/*
+    Copia os contadores do conjunto. A altura atual é calculada na hora
+    (O(1) na AVL, O(n) na LLRB, que não guarda alturas) e também entra no
+    máximo. Sem -DSET_ESTATISTICAS só as alturas são preenchidas.
+*/
+int set_estatisticas(SET *set, struct set_stats *stats) {
+  if (!set || !stats)
+    return -1;
 
-  // Verifica se o valor está presente no outro conjunto
-  // e se pertence adicionamos
-  if (valor > 0 && set_pertence(set_destino, valor)) {
-    if (!set_pertence(set_interseccao, valor)) {
-      set_inserir(set_interseccao, valor);
+  memset(stats, 0, sizeof(*stats));
+  if (set->buffer)
+    set_consolidar(set);
+  stats->altura_atual = (uint64_t)set->SET->altura(set->SET->estrutura);
+  stats->altura_max = stats->altura_atual;
+
+#ifdef SET_ESTATISTICAS
+  estatisticas_registrar_altura(&set->estat, stats->altura_atual);
+  estatisticas_copiar(&set->estat, stats);
+  stats->altura_max = atomic_load(&set->estat.altura_max);
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+// Restaura o heap mínimo (por valor corrente) a partir da posição i
+void descer_heap_uniao(FONTE_UNIAO **heap, size_t k, size_t i) {
+  for (;;) {
+    size_t menor = i, e = 2 * i + 1, d = 2 * i + 2;
+    if (e < k && heap[e]->valor < heap[menor]->valor)
+      menor = e;
+    if (d < k && heap[d]->valor < heap[menor]->valor)
+      menor = d;
+    if (menor == i)
+      return;
+    FONTE_UNIAO *aux = heap[i];
+    heap[i] = heap[menor];
+    heap[menor] = aux;
+    i = menor;
+  }
+}
+
+/*
+    União de k conjuntos: intercalação dos k percursos em ordem usando um
+    heap mínimo. Cada elemento sai do heap em O(log(k)) e repetidos são
+    descartados comparando com o último emitido, então a saída recebe o
+    resultado já ordenado e sem repetições.
+*/
+int set_uniao_k_emitir(SET **sets, size_t k, SAIDA *saida) {
+  if (!sets || k == 0 || !saida)
+    return 0;
+
+  FONTE_UNIAO *fontes = (FONTE_UNIAO *)malloc(k * sizeof(FONTE_UNIAO));
+  FONTE_UNIAO **heap = (FONTE_UNIAO **)malloc(k * sizeof(FONTE_UNIAO *));
+  if (!fontes || !heap) {
+    free(fontes);
+    free(heap);
+    return 0;
+  }
+
+  // O heap guarda ponteiros: trocar iteradores inteiros de lugar é caro
+  size_t ativos = 0;
+  for (size_t i = 0; i < k; i++) {
+    set_iterador(sets[i], &fontes[i].it);
+    if (set_iterador_proximo(&fontes[i].it, &fontes[i].valor))
+      heap[ativos++] = &fontes[i];
+    else
+      iterador_finalizar(&fontes[i].it);
+  }
+
+  for (size_t i = ativos; i-- > 0;)
+    descer_heap_uniao(heap, ativos, i);
+
+  LOTE_SAIDA lote;
+  int aceita = 1, emitiu = 0, ultimo = 0;
+  lote_iniciar(&lote, saida);
+
+  while (ativos > 0 && aceita) {
+    int valor = heap[0]->valor;
+    if (!emitiu || ultimo != valor) {
+      aceita = lote_anexar(&lote, valor);
+      ultimo = valor;
+      emitiu = 1;
+    }
+
+    if (!set_iterador_proximo(&heap[0]->it, &heap[0]->valor)) {
+      iterador_finalizar(&heap[0]->it);
+      heap[0] = heap[--ativos];
+    }
+    descer_heap_uniao(heap, ativos, 0);
+  }
+
+  for (size_t i = 0; i < ativos; i++)
+    iterador_finalizar(&heap[i]->it);
+  free(heap);
+  free(fontes);
+  return lote_descarregar(&lote);
+}
+
+int comparar_tamanho_set(const void *a, const void *b) {
+  size_t x = set_tamanho(*(SET *const *)a), y = set_tamanho(*(SET *const *)b);
+  return (x > y) - (x < y);
+}
+
+/*
+    Intersecção de k conjuntos (leapfrog): os conjuntos são ordenados do
+    menor para o maior e o menor propõe candidatos. Cada outro conjunto
+    salta com set_iterador_buscar() até o candidato; se parar num valor
+    maior, esse valor vira o novo candidato e o menor conjunto salta até
+    ele. Conjuntos pequenos descartam faixas inteiras dos grandes em
+    O(log(n)) por salto, e um conjunto vazio encerra tudo imediatamente.
+    Um conjunto com filtro (ver set_filtrar()) recusa a maioria dos
+    candidatos ausentes numa consulta ao filtro, sem saltar o iterador.
+*/
+int set_interseccao_k_emitir(SET **sets, size_t k, SAIDA *saida) {
+  if (!sets || k == 0 || !saida)
+    return 0;
+
+  SET **ordem = (SET **)malloc(k * sizeof(SET *));
+  ITERADOR *its = (ITERADOR *)malloc(k * sizeof(ITERADOR));
+  int *atual = (int *)malloc(k * sizeof(int));
+  if (!ordem || !its || !atual) {
+    free(ordem);
+    free(its);
+    free(atual);
+    return 0;
+  }
+  memcpy(ordem, sets, k * sizeof(SET *));
+  qsort(ordem, k, sizeof(SET *), comparar_tamanho_set);
+
+  size_t iniciados = 0;
+  int vivo = 1;
+  for (size_t i = 0; i < k && vivo; i++) {
+    set_iterador(ordem[i], &its[i]);
+    iniciados++;
+    vivo = set_iterador_proximo(&its[i], &atual[i]);
+  }
+
+  LOTE_SAIDA lote;
+  lote_iniciar(&lote, saida);
+
+  int candidato = vivo ? atual[0] : 0;
+  while (vivo) {
+    size_t j;
+    int recusado = 0;
+    for (j = 1; j < k; j++) {
+      if (atual[j] < candidato && !filtro_permite(ordem[j], candidato)) {
+        recusado = 1;
+        break;
+      }
+      if (atual[j] < candidato &&
+          !set_iterador_buscar(&its[j], candidato, &atual[j])) {
+        vivo = 0;
+        break;
+      }
+      if (atual[j] != candidato)
+        break;
+    }
+    if (!vivo)
+      break;
+
+    if (j == k) {
+      // Todos concordam: o candidato está na intersecção
+      if (!lote_anexar(&lote, candidato))
+        break;
+      vivo = set_iterador_proximo(&its[0], &atual[0]);
+    } else if (recusado) {
+      // O filtro de j descartou o candidato: segue o menor conjunto
+      vivo = set_iterador_proximo(&its[0], &atual[0]);
+    } else {
+      // O conjunto j saltou além: o menor conjunto salta até ele
+      vivo = set_iterador_buscar(&its[0], atual[j], &atual[0]);
     }
+    candidato = atual[0];
   }
 
-  void *direita = obter_direita(no, set_origem->opt);
-  in_order_interseccao(direita, set_origem, set_destino, set_interseccao);
+  for (size_t i = 0; i < iniciados; i++)
+    iterador_finalizar(&its[i]);
+  free(ordem);
+  free(its);
+  free(atual);
+  return lote_descarregar(&lote);
+}
+
+// Monta um conjunto com o que uma operação escreveu em uma saída de vetor
+SET *construir_resultado(int opt, SAIDA *saida, int completo) {
+  SET *resultado = NULL;
+  if (completo) {
+    size_t n;
+    int *chaves = saida_dados(saida, &n);
+    resultado = set_construir_ordenado(opt, chaves, n);
+  }
+  saida_apagar(&saida);
+  return resultado;
+}
+
+// 1 se todos os conjuntos guardam faixas (SET_INTERVALOS)
+int todos_intervalos(SET **sets, size_t k) {
+  for (size_t i = 0; i < k; i++)
+    if (!sets[i] || sets[i]->opt != SET_INTERVALOS)
+      return 0;
+  return 1;
+}
+
+/*
+    Faixas do conjunto em ordem: os inícios em v[0..r) e os fins em
+    v[r..2r). O vetor devolvido deve ser liberado com free().
+*/
+int *copiar_faixas(SET *set, size_t *r) {
+  INTERVALOS *T = (INTERVALOS *)set->SET->estrutura;
+  size_t n = intervalos_faixas(T);
+  int *v = (int *)malloc((2 * n + 1) * sizeof(int));
+  if (!v)
+    return NULL;
+  *r = intervalos_copiar(T, v, v + n, n);
+  return v;
+}
+
+// União de duas listas de faixas; vizinhas que se encostam viram uma só
+size_t unir_faixas(const int *ai, const int *af, size_t ra, const int *bi,
+                   const int *bf, size_t rb, int *ci, int *cf) {
+  size_t i = 0, j = 0, k = 0;
+  while (i < ra || j < rb) {
+    int ini, fim;
+    if (j == rb || (i < ra && ai[i] <= bi[j])) {
+      ini = ai[i];
+      fim = af[i++];
+    } else {
+      ini = bi[j];
+      fim = bf[j++];
+    }
+    if (k > 0 && (int64_t)cf[k - 1] + 1 >= ini) {
+      if (fim > cf[k - 1])
+        cf[k - 1] = fim;
+    } else {
+      ci[k] = ini;
+      cf[k++] = fim;
+    }
+  }
+  return k;
+}
+
+/*
+    Intersecção de duas listas de faixas: cada par que se sobrepõe produz
+    uma faixa, e avança a lista cuja faixa acaba primeiro. As faixas
+    produzidas já são maximais, porque entre duas delas sempre sobra a
+    chave que faltava em uma das entradas.
+*/
+size_t cruzar_faixas(const int *ai, const int *af, size_t ra, const int *bi,
+                     const int *bf, size_t rb, int *ci, int *cf) {
+  size_t i = 0, j = 0, k = 0;
+  while (i < ra && j < rb) {
+    int ini = ai[i] > bi[j] ? ai[i] : bi[j];
+    int fim = af[i] < bf[j] ? af[i] : bf[j];
+    if (ini <= fim) {
+      ci[k] = ini;
+      cf[k++] = fim;
+    }
+    if (af[i] < bf[j])
+      i++;
+    else
+      j++;
+  }
+  return k;
+}
+
+// Conjunto de faixas montado direto das faixas, sem passar pelas chaves
+SET *set_de_faixas(const int *ini, const int *fim, size_t r) {
+  SET *s = criar_set(SET_INTERVALOS);
+  if (!s)
+    return NULL;
+  ESTAT_USAR(&s->estat);
+  int resp = intervalos_construir_faixas((INTERVALOS *)s->SET->estrutura, ini,
+                                         fim, r);
+  ESTAT_ALTURA((uint64_t)s->SET->altura(s->SET->estrutura));
+  ESTAT_USAR(NULL);
+  if (resp != 1) {
+    set_apagar(&s);
+    return NULL;
+  }
+  size_t n = 0;
+  for (size_t i = 0; i < r; i++)
+    n += (size_t)((int64_t)fim[i] - ini[i] + 1);
+  atomic_store(&s->tamanho, n);
+  atomic_store(&s->assinatura_incerta, 1);
+  return s;
+}
+
+/*
+    União ou intersecção de k conjuntos de faixas sem passar pelas chaves:
+    as listas de faixas são combinadas duas a duas, em O(faixas) cada, e o
+    resultado é montado direto das faixas. O custo não depende de quantas
+    chaves cada faixa tem.
+*/
+SET *operar_faixas(SET **sets, size_t k, int uniao) {
+  size_t r;
+  int *atual = copiar_faixas(sets[0], &r);
+  if (!atual)
+    return NULL;
+
+  for (size_t i = 1; i < k; i++) {
+    size_t rb;
+    int *b = copiar_faixas(sets[i], &rb);
+    size_t capacidade = r + rb; // Vale para as duas operações
+    int *c = b ? (int *)malloc((2 * capacidade + 1) * sizeof(int)) : NULL;
+    if (!c) {
+      free(b);
+      free(atual);
+      return NULL;
+    }
+    size_t rc = uniao ? unir_faixas(atual, atual + r, r, b, b + rb, rb, c,
+                                    c + capacidade)
+                      : cruzar_faixas(atual, atual + r, r, b, b + rb, rb, c,
+                                      c + capacidade);
+    // Os fins vão para logo depois dos inícios, no formato de copiar_faixas()
+    memmove(c + rc, c + capacidade, rc * sizeof(int));
+    free(b);
+    free(atual);
+    atual = c;
+    r = rc;
+  }
+
+  SET *resultado = set_de_faixas(atual, atual + r, r);
+  free(atual);
+  return resultado;
+}
+
+// União de k conjuntos montada de uma vez, já ordenada, em um novo conjunto
+SET *set_uniao_k(SET **sets, size_t k) {
+  if (!sets || k == 0 || !sets[0])
+    return NULL;
+  if (todos_intervalos(sets, k))
+    return operar_faixas(sets, k, 1);
+
+  size_t capacidade = 0;
+  for (size_t i = 0; i < k; i++)
+    capacidade += set_tamanho(sets[i]);
+
+  SAIDA *saida = saida_vetor(capacidade);
+  if (!saida)
+    return NULL;
+  return construir_resultado(sets[0]->opt, saida,
+                             set_uniao_k_emitir(sets, k, saida));
+}
+
+// Intersecção de k conjuntos em um novo conjunto
+SET *set_interseccao_k(SET **sets, size_t k) {
+  if (!sets || k == 0 || !sets[0])
+    return NULL;
+  if (todos_intervalos(sets, k))
+    return operar_faixas(sets, k, 0);
+
+  // A intersecção não passa do tamanho do menor conjunto
+  size_t capacidade = set_tamanho(sets[0]);
+  for (size_t i = 1; i < k; i++)
+    if (set_tamanho(sets[i]) < capacidade)
+      capacidade = set_tamanho(sets[i]);
+
+  SAIDA *saida = saida_vetor(capacidade);
+  if (!saida)
+    return NULL;
+  return construir_resultado(sets[0]->opt, saida,
+                             set_interseccao_k_emitir(sets, k, saida));
+}
+
+// Liga (limite > 0) ou desliga (limite 0) o modo bufferizado
+int set_bufferizar(SET *set, size_t limite) {
+  if (!set ||
+      (set->opt != SET_AVL && set->opt != SET_LLRB && set->opt != SET_WAVL))
+    return -1;
+
+  if (limite == 0) {
+    if (set->buffer && set_consolidar(set) != 1)
+      return 0;
+    buffer_apagar(&set->buffer);
+    return 1;
+  }
+  if (!set->buffer && !(set->buffer = buffer_criar()))
+    return 0;
+  set->buffer_limite = limite;
+  return 1;
+}
+
+/*
+    No modo bufferizado a árvore só é consultada, nunca alterada: o
+    resultado de set_inserir()/set_remover() (e o tamanho) continua exato,
+    mas a inserção ou remoção de fato fica para a consolidação.
+*/
+int inserir_bufferizado(SET *set, int valor) {
+  int estado = buffer_consultar(set->buffer, valor);
+  if (estado == BUFFER_INSERIDO)
+    return 0;
+  if (estado == BUFFER_AUSENTE) {
+    ESTAT_USAR(&set->estat);
+    int existe = set->SET->buscar(set->SET->estrutura, valor);
+    ESTAT_USAR(NULL);
+    if (existe)
+      return 0;
+  }
+
+  if (!buffer_marcar(set->buffer, valor, BUFFER_INSERIDO)) {
+    // Sem memória para o buffer (a chave estava ausente de ambos): vai
+    // direto para a árvore
+    ESTAT_USAR(&set->estat);
+    int resp = set->SET->inserir(set->SET->estrutura, valor);
+    ESTAT_USAR(NULL);
+    if (resp != 1)
+      return resp;
+  }
+  registrar_insercao(set, valor);
+
+  size_t limite = set_tamanho(set) / SET_BUFFER_FRACAO;
+  if (limite < set->buffer_limite)
+    limite = set->buffer_limite;
+  if (buffer_tamanho(set->buffer) >= limite)
+    set_consolidar(set);
+  return 1;
+}
+
+int remover_bufferizado(SET *set, int valor) {
+  int estado = buffer_consultar(set->buffer, valor);
+  if (estado == BUFFER_REMOVIDO)
+    return 0;
+  if (estado == BUFFER_AUSENTE) {
+    ESTAT_USAR(&set->estat);
+    int existe = set->SET->buscar(set->SET->estrutura, valor);
+    ESTAT_USAR(NULL);
+    if (!existe)
+      return 0;
+  }
+
+  if (!buffer_marcar(set->buffer, valor, BUFFER_REMOVIDO)) {
+    ESTAT_USAR(&set->estat);
+    int resp = set->SET->remover(set->SET->estrutura, valor);
+    ESTAT_USAR(NULL);
+    if (resp != 1)
+      return resp;
+  }
+  registrar_remocao(set, valor);
+
+  size_t limite = set_tamanho(set) / SET_BUFFER_FRACAO;
+  if (limite < set->buffer_limite)
+    limite = set->buffer_limite;
+  if (buffer_tamanho(set->buffer) >= limite)
+    set_consolidar(set);
+  return 1;
+}
+
+/*
+    Intercala o percurso da árvore com as inserções pendentes, pulando as
+    remoções, e monta uma árvore nova já balanceada com o resultado. Custa
+    O(n + m) e nenhuma rotação.
+*/
+int reconstruir_bufferizado(SET *set, const int *inseridos, size_t ni,
+                            const int *removidos, size_t nr) {
+  size_t n = set_tamanho(set);
+  int *chaves = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+  if (!chaves)
+    return 0;
+
+  ITERADOR it;
+  int valor;
+  size_t i = 0, r = 0, k = 0;
+  set->SET->iterador(set->SET->estrutura, &it);
+  int tem = set->SET->iterador_proximo(&it, &valor);
+  while (tem || i < ni) {
+    int x;
+    if (!tem || (i < ni && inseridos[i] < valor)) {
+      x = inseridos[i++];
+    } else {
+      x = valor;
+      if (i < ni && inseridos[i] == valor)
+        i++;
+      tem = set->SET->iterador_proximo(&it, &valor);
+    }
+    while (r < nr && removidos[r] < x)
+      r++;
+    if ((r < nr && removidos[r] == x) || k == n)
+      continue;
+    chaves[k++] = x;
+  }
+  iterador_finalizar(&it);
+
+  ESTAT_USAR(&set->estat);
+  void *nova = set->SET->criar();
+  int resp = nova != NULL &&
+             (k == 0 || set->SET->construir(nova, chaves, k,
+                                                ordenacao_threads(0)) == 1);
+  if (resp) {
+    set->SET->apagar(&set->SET->estrutura);
+    set->SET->estrutura = nova;
+    ESTAT_ALTURA((uint64_t)set->SET->altura(nova));
+  } else if (nova) {
+    set->SET->apagar(&nova);
+  }
+  ESTAT_USAR(NULL);
+  free(chaves);
+  return resp;
+}
+
+// Aplica à árvore todas as alterações pendentes do buffer
+int set_consolidar(SET *set) {
+  if (!set || !set->SET)
+    return -1;
+  size_t m = set->buffer ? buffer_tamanho(set->buffer) : 0;
+  if (m == 0)
+    return 1;
+
+  int *chaves = (int *)malloc(2 * m * sizeof(int));
+  if (!chaves)
+    return 0;
+  int *inseridos = chaves, *removidos = chaves + m;
+  size_t ni, nr;
+  buffer_extrair(set->buffer, inseridos, &ni, removidos, &nr);
+
+  // As chaves do buffer já são únicas: ordenar_unicos() só as ordena
+  int resp = (ni == 0 || ordenar_unicos(inseridos, ni, 0) == ni) &&
+             (nr == 0 || ordenar_unicos(removidos, nr, 0) == nr);
+  if (resp && m * SET_BUFFER_RECONSTRUIR >= set_tamanho(set)) {
+    resp = reconstruir_bufferizado(set, inseridos, ni, removidos, nr);
+  } else if (resp) {
+    // Poucas pendências: em ordem, cada descida reaproveita o caminho
+    // da anterior na cache
+    ESTAT_USAR(&set->estat);
+    for (size_t i = 0; i < ni; i++)
+      set->SET->inserir(set->SET->estrutura, inseridos[i]);
+    for (size_t i = 0; i < nr; i++)
+      set->SET->remover(set->SET->estrutura, removidos[i]);
+    ESTAT_USAR(NULL);
+  }
+
+  free(chaves);
+  if (resp)
+    buffer_limpar(set->buffer);
+  return resp;
+}
+
+/*
+    Divisão e junção movem subárvores inteiras, sem um evento por elemento:
+    por isso valem só para as árvores (que sabem fazer isso em O(log(n))) e
+    recusam conjuntos observados, cujas visões ficariam desatualizadas.
+*/
+int set_migravel(SET *set, int opt) {
+  return set && set->SET && set->opt == opt && set->SET->juntar &&
+         !set->observadores && (!set->buffer || set_consolidar(set) == 1);
+}
+
+// Divide o conjunto pela chave em dois conjuntos novos; ele fica vazio
+int set_dividir(SET *set, int chave, SET **menores, SET **maiores) {
+  if (!set || !menores || !maiores || !set_migravel(set, set->opt))
+    return -1;
+
+  SET *m = criar_set(set->opt), *M = criar_set(set->opt);
+  if (!m || !M || !m->SET->estrutura || !M->SET->estrutura) {
+    set_apagar(&m);
+    set_apagar(&M);
+    return 0;
+  }
+
+  // Sem forçar a contagem: um tamanho incerto passa adiante
+  size_t n = atomic_load(&set->tamanho);
+  uint64_t assinatura = atomic_load(&set->assinatura);
+  int incerto = atomic_load(&set->resumo_incerto);
+  int assinatura_incerta = atomic_load(&set->assinatura_incerta);
+  ESTAT_USAR(&set->estat);
+  int resp = set->SET->dividir(set->SET->estrutura, chave, m->SET->estrutura,
+                               M->SET->estrutura);
+  ESTAT_USAR(NULL);
+  if (resp != 1) {
+    // Só as faixas alocam na divisão (para partir a faixa da chave)
+    set_apagar(&m);
+    set_apagar(&M);
+    return 0;
+  }
+
+  // Se um lado ficou vazio o outro tem tudo; senão os dois são recontados
+  // sob demanda (ver set_tamanho())
+  int a, b;
+  if (!m->SET->extremos(m->SET->estrutura, &a, &b)) {
+    atomic_store(&M->tamanho, n);
+    atomic_store(&M->assinatura, assinatura);
+    atomic_store(&M->resumo_incerto, incerto);
+    atomic_store(&M->assinatura_incerta, assinatura_incerta);
+  } else if (!M->SET->extremos(M->SET->estrutura, &a, &b)) {
+    atomic_store(&m->tamanho, n);
+    atomic_store(&m->assinatura, assinatura);
+    atomic_store(&m->resumo_incerto, incerto);
+    atomic_store(&m->assinatura_incerta, assinatura_incerta);
+  } else {
+    atomic_store(&m->resumo_incerto, 1);
+    atomic_store(&M->resumo_incerto, 1);
+  }
+  atomic_store(&set->tamanho, 0);
+  atomic_store(&set->assinatura, 0);
+  atomic_store(&set->resumo_incerto, 0);
+  atomic_store(&set->assinatura_incerta, 0);
+  atomic_fetch_add(&set->versao, 1);
+  if (set->filtro)
+    reconstruir_filtro(set); // Vazio: O(1)
+  if (set->esboco)
+    esboco_limpar(set->esboco);
+
+  *menores = m;
+  *maiores = M;
+  return 1;
+}
+
+// Junta b ao fim de a (todas as chaves de a menores que as de b)
+int set_juntar(SET *a, SET *b) {
+  SET *par[2] = {a, b};
+  return set_concatenar(par, 2);
+}
+
+/*
+    Concatena k conjuntos em ordem no primeiro, os demais ficam vazios. A
+    ordem é verificada por inteiro antes de qualquer mudança (menor e maior
+    chave de cada conjunto, em O(log(n))), então uma ordem errada não altera
+    nada.
+*/
+int set_concatenar(SET **sets, size_t k) {
+  if (!sets || k == 0 || !sets[0])
+    return -1;
+  for (size_t i = 0; i < k; i++)
+    if (!set_migravel(sets[i], sets[0]->opt) ||
+        (i > 0 && sets[i] == sets[0]))
+      return -1;
+
+  int tem_anterior = 0, maior_anterior = 0;
+  for (size_t i = 0; i < k; i++) {
+    int menor, maior;
+    if (!sets[i]->SET->extremos(sets[i]->SET->estrutura, &menor, &maior))
+      continue;
+    if (tem_anterior && menor <= maior_anterior)
+      return 0;
+    tem_anterior = 1;
+    maior_anterior = maior;
+  }
+
+  SET *destino = sets[0];
+  int refazer_esboco = 0;
+  for (size_t i = 1; i < k; i++) {
+    SET *s = sets[i];
+    ESTAT_USAR(&destino->estat);
+    int resp = destino->SET->juntar(destino->SET->estrutura, s->SET->estrutura);
+    ESTAT_USAR(NULL);
+    if (resp != 1) {
+      // Sem memória: os conjuntos anteriores já foram juntados
+      if (refazer_esboco)
+        reconstruir_esboco(destino);
+      return resp;
+    }
+
+    int incerto = atomic_load(&destino->resumo_incerto) ||
+                  atomic_load(&s->resumo_incerto);
+    atomic_fetch_add(&destino->tamanho, atomic_load(&s->tamanho));
+    atomic_fetch_add(&destino->assinatura, atomic_load(&s->assinatura));
+    atomic_store(&destino->resumo_incerto, incerto);
+    if (atomic_load(&s->assinatura_incerta))
+      atomic_store(&destino->assinatura_incerta, 1);
+    atomic_store(&s->tamanho, 0);
+    atomic_store(&s->assinatura, 0);
+    atomic_fetch_add(&destino->versao, 1);
+    atomic_fetch_add(&s->versao, 1);
+    atomic_store(&s->resumo_incerto, 0);
+    atomic_store(&s->assinatura_incerta, 0);
+    if (s->filtro)
+      reconstruir_filtro(s); // Vazio: O(1)
+    // Reconstruir agora custaria O(n): fica para a próxima escrita
+    destino->filtro_desatualizado = destino->filtro != NULL;
+    // Esboços se juntam sem tocar nos elementos; sem o esboço de s, só
+    // refazendo
+    if (destino->esboco && s->esboco)
+      esboco_juntar(destino->esboco, s->esboco);
+    else
+      refazer_esboco = destino->esboco != NULL;
+    if (s->esboco)
+      esboco_limpar(s->esboco);
+  }
+  if (refazer_esboco)
+    reconstruir_esboco(destino);
+  return 1;
+}
+
+/*
+    Igualdade: tamanho ou assinatura diferentes decidem em O(1), sem tocar
+    as árvores. Só conjuntos com o mesmo resumo são percorridos juntos, e o
+    percurso para na primeira diferença.
+*/
+int set_igual(SET *a, SET *b) {
+  if (!a || !b)
+    return -1;
+  if (a == b)
+    return 1;
+  if (set_tamanho(a) != set_tamanho(b) ||
+      set_assinatura(a) != set_assinatura(b))
+    return 0;
+
+  ITERADOR ia, ib;
+  int x, y, igual = 1;
+  set_iterador(a, &ia);
+  set_iterador(b, &ib);
+  while (igual && set_iterador_proximo(&ia, &x))
+    igual = set_iterador_proximo(&ib, &y) && x == y;
+  iterador_finalizar(&ia);
+  iterador_finalizar(&ib);
+  return igual;
+}
+
+/*
+    a ⊆ b: cada elemento de a é procurado em b com set_iterador_buscar(),
+    que só avança, então trechos de b sem elementos de a são saltados em
+    O(log(n)). Um a maior que b é recusado sem percurso, e com tamanhos
+    iguais a pergunta vira igualdade (que usa a assinatura). O filtro de b,
+    se houver, recusa um elemento ausente sem o salto.
+*/
+int set_subconjunto(SET *a, SET *b) {
+  if (!a || !b)
+    return -1;
+  size_t na = set_tamanho(a), nb = set_tamanho(b);
+  if (na > nb)
+    return 0;
+  if (na == nb)
+    return set_igual(a, b);
+
+  ITERADOR ia, ib;
+  int x, y, contido = 1;
+  set_iterador(a, &ia);
+  set_iterador(b, &ib);
+  if (set_iterador_proximo(&ia, &x)) {
+    contido = set_iterador_proximo(&ib, &y);
+    do {
+      if (contido && y < x)
+        contido = filtro_permite(b, x) && set_iterador_buscar(&ib, x, &y);
+      contido = contido && y == x;
+    } while (contido && set_iterador_proximo(&ia, &x));
+  }
+  iterador_finalizar(&ia);
+  iterador_finalizar(&ib);
+  return contido;
+}
+
+// Disjunção: intersecção (leapfrog) que para no primeiro elemento comum
+int set_disjuntos(SET *a, SET *b) {
+  if (!a || !b)
+    return -1;
+  if (a == b)
+    return set_tamanho(a) == 0;
+
+  ITERADOR ia, ib;
+  int x, y;
+  set_iterador(a, &ia);
+  set_iterador(b, &ib);
+  int vivo = set_iterador_proximo(&ia, &x) && set_iterador_proximo(&ib, &y);
+  while (vivo && x != y) {
+    if (x < y)
+      vivo = set_iterador_buscar(&ia, y, &x);
+    else
+      vivo = set_iterador_buscar(&ib, x, &y);
+  }
+  iterador_finalizar(&ia);
+  iterador_finalizar(&ib);
+  return !vivo;
+}
+
+// Próximas chaves do percurso, de uma vez quando a estrutura sabe
+size_t ler_lote(ITERADOR *it, int *destino, size_t capacidade) {
+  Arvore *arv = (Arvore *)it->origem;
+  if (!arv)
+    return 0;
+  if (arv->iterador_lote)
+    return arv->iterador_lote(it, destino, capacidade);
+  size_t n = 0;
+  while (n < capacidade && arv->iterador_proximo(it, &destino[n]))
+    n++;
+  return n;
+}
+
+// Leva o resto do lote para o início e completa com o percurso
+void completar_lote(ITERADOR *it, int *lote, size_t *inicio, size_t *n,
+                    int *fim) {
+  size_t resto = *n - *inicio;
+  memmove(lote, lote + *inicio, resto * sizeof(int));
+  size_t lidos = ler_lote(it, lote + resto, SET_CONTAGEM_LOTE - resto);
+  *fim = lidos < SET_CONTAGEM_LOTE - resto;
+  *inicio = 0;
+  *n = resto + lidos;
+}
+
+/*
+    |a ∩ b| sem montar o resultado. Com tamanhos parecidos, os dois
+    percursos são lidos em lotes e contados de 4 em 4 chaves por
+    contar_comuns_blocos(); só as últimas chaves (menos de 4 num lado que
+    acabou) passam pela intercalação comum. Com um conjunto muito menor,
+    cada chave dele salta o maior com set_iterador_buscar(), depois de
+    consultar o filtro do maior, se houver.
+*/
+size_t contar_interseccao(SET *a, SET *b) {
+  size_t na = set_tamanho(a), nb = set_tamanho(b);
+  if (na == 0 || nb == 0)
+    return 0;
+  if (a == b)
+    return na;
+  size_t total = 0;
+  if (a->opt == SET_INTERVALOS && b->opt == SET_INTERVALOS &&
+      contar_interseccao_faixas(a, b, &total))
+    return total;
+  if (na > nb) {
+    SET *t = a;
+    a = b;
+    b = t;
+    size_t tn = na;
+    na = nb;
+    nb = tn;
+  }
+
+  ITERADOR ia, ib;
+  set_iterador(a, &ia);
+  set_iterador(b, &ib);
+  if (na * SET_CONTAGEM_SALTOS < nb) {
+    int x, y;
+    int vivo = set_iterador_proximo(&ib, &y);
+    while (vivo && set_iterador_proximo(&ia, &x)) {
+      if (y < x) {
+        if (!filtro_permite(b, x))
+          continue;
+        vivo = set_iterador_buscar(&ib, x, &y);
+      }
+      total += vivo && y == x;
+    }
+  } else {
+    int lote_a[SET_CONTAGEM_LOTE], lote_b[SET_CONTAGEM_LOTE];
+    size_t ia0 = 0, na0 = 0, ib0 = 0, nb0 = 0;
+    int fim_a = 0, fim_b = 0;
+    for (;;) {
+      if (na0 - ia0 < 4 && !fim_a)
+        completar_lote(&ia, lote_a, &ia0, &na0, &fim_a);
+      if (nb0 - ib0 < 4 && !fim_b)
+        completar_lote(&ib, lote_b, &ib0, &nb0, &fim_b);
+      if (na0 - ia0 >= 4 && nb0 - ib0 >= 4) {
+        total += contar_comuns_blocos(lote_a, &ia0, na0, lote_b, &ib0, nb0);
+        continue;
+      }
+      // Um lado acabou com menos de 4 chaves
+      while (ia0 < na0 && ib0 < nb0) {
+        int x = lote_a[ia0], y = lote_b[ib0];
+        total += x == y;
+        ia0 += x <= y;
+        ib0 += y <= x;
+      }
+      if ((ia0 == na0 && fim_a) || (ib0 == nb0 && fim_b))
+        break;
+    }
+  }
+  iterador_finalizar(&ia);
+  iterador_finalizar(&ib);
+  return total;
+}
+
+// |a ∩ b| somando as sobreposições das faixas, em O(faixas) (0 sem memória)
+int contar_interseccao_faixas(SET *a, SET *b, size_t *total) {
+  size_t ra, rb;
+  int *fa = copiar_faixas(a, &ra);
+  int *fb = fa ? copiar_faixas(b, &rb) : NULL;
+  int *c = fb ? (int *)malloc((2 * (ra + rb) + 1) * sizeof(int)) : NULL;
+  int ok = c != NULL;
+  if (ok) {
+    size_t rc = cruzar_faixas(fa, fa + ra, ra, fb, fb + rb, rb, c, c + ra + rb);
+    for (size_t i = 0; i < rc; i++)
+      *total += (size_t)((int64_t)c[ra + rb + i] - c[i] + 1);
+  }
+  free(fa);
+  free(fb);
+  free(c);
+  return ok;
+}
+
+size_t set_tamanho_interseccao(SET *a, SET *b) {
+  if (!a || !b)
+    return 0;
+  return contar_interseccao(a, b);
+}
+
+// |a ∪ b| = |a| + |b| - |a ∩ b|
+size_t set_tamanho_uniao(SET *a, SET *b) {
+  if (!a || !b)
+    return 0;
+  size_t comuns = contar_interseccao(a, b);
+  return set_tamanho(a) + set_tamanho(b) - comuns;
+}
+
+// |a \ b| = |a| - |a ∩ b|
+size_t set_tamanho_diferenca(SET *a, SET *b) {
+  if (!a || !b)
+    return 0;
+  size_t comuns = contar_interseccao(a, b);
+  return set_tamanho(a) - comuns;
+}
+
+// Liga (ligar != 0) ou desliga o pré-filtro de pertinência
+int set_filtrar(SET *set, int ligar) {
+  if (!set || !set->SET || set->opt == SET_SKIPLIST)
+    return -1;
+  if (!ligar) {
+    filtro_apagar(&set->filtro);
+    set->filtro_desatualizado = 0;
+    return 1;
+  }
+  return reconstruir_filtro(set);
+}
+
+/*
+    Elementos atuais do conjunto, sem ordem: o percurso da estrutura sem as
+    remoções pendentes do buffer, mais as inserções pendentes. Não
+    consolida o buffer, então serve aos caminhos de escrita do modo
+    bufferizado. O vetor devolvido deve ser liberado com free().
+*/
+int *coletar_chaves(SET *set, size_t *n) {
+  size_t tamanho = set_tamanho(set);
+  size_t pendentes = set->buffer ? buffer_tamanho(set->buffer) : 0;
+  int *chaves = (int *)malloc((tamanho + pendentes + 1) * sizeof(int));
+  int *removidos = (int *)malloc((pendentes + 1) * sizeof(int));
+  if (!chaves || !removidos) {
+    free(chaves);
+    free(removidos);
+    return NULL;
+  }
+
+  size_t ni = 0, nr = 0, k = 0;
+  if (pendentes > 0)
+    buffer_extrair(set->buffer, chaves + tamanho, &ni, removidos, &nr);
+
+  ITERADOR it;
+  int valor;
+  set->SET->iterador(set->SET->estrutura, &it);
+  while (k < tamanho && set->SET->iterador_proximo(&it, &valor))
+    if (nr == 0 || buffer_consultar(set->buffer, valor) != BUFFER_REMOVIDO)
+      chaves[k++] = valor;
+  iterador_finalizar(&it);
+  // Inserções pendentes não estão na árvore; vão para logo depois dela
+  memmove(chaves + k, chaves + tamanho, ni * sizeof(int));
+  free(removidos);
+  *n = k + ni;
+  return chaves;
+}
+
+/*
+    Refaz o filtro com os elementos atuais: xor para o conjunto congelado,
+    Bloom com folga para o dobro de elementos para os demais. Se faltar
+    memória o conjunto fica sem filtro.
+*/
+int reconstruir_filtro(SET *set) {
+  size_t k;
+  int *chaves = coletar_chaves(set, &k);
+  FILTRO *novo = NULL;
+  if (chaves && (set->opt == SET_CONGELADO || set->opt == SET_COMPRIMIDO)) {
+    novo = filtro_xor(chaves, k);
+  } else if (chaves) {
+    size_t capacidade = 2 * k;
+    if (capacidade < SET_FILTRO_CAPACIDADE_MIN)
+      capacidade = SET_FILTRO_CAPACIDADE_MIN;
+    novo = filtro_bloom(capacidade);
+    for (size_t i = 0; novo && i < k; i++)
+      filtro_adicionar(novo, chaves[i]);
+  }
+  free(chaves);
+
+  filtro_apagar(&set->filtro);
+  set->filtro = novo;
+  set->filtro_desatualizado = 0;
+  return novo != NULL;
+}
+
+// 0 se o filtro garante que o valor está fora do conjunto
+int filtro_permite(SET *set, int valor) {
+  return !set->filtro || set->filtro_desatualizado ||
+         filtro_contem(set->filtro, valor);
+}
+
+// Liga (ligar != 0) ou desliga o esboço de cardinalidade
+int set_esbocar(SET *set, int ligar) {
+  if (!set || !set->SET || set->opt == SET_SKIPLIST)
+    return -1;
+  if (!ligar) {
+    esboco_apagar(&set->esboco);
+    return 1;
+  }
+  return reconstruir_esboco(set);
+}
+
+// Refaz o esboço com os elementos atuais (sem memória, fica sem esboço)
+int reconstruir_esboco(SET *set) {
+  if (!set->esboco && !(set->esboco = esboco_criar()))
+    return 0;
+  size_t n;
+  int *chaves = coletar_chaves(set, &n);
+  if (!chaves) {
+    esboco_apagar(&set->esboco);
+    return 0;
+  }
+  esboco_limpar(set->esboco);
+  for (size_t i = 0; i < n; i++)
+    esboco_adicionar(set->esboco, chaves[i]);
+  free(chaves);
+  return 1;
+}
+
+// Esboços dos k conjuntos (0 se algum for inválido ou não tiver esboço)
+int esbocos_dos_sets(SET **sets, size_t k, const ESBOCO **esbocos) {
+  if (!sets || k == 0)
+    return 0;
+  for (size_t i = 0; i < k; i++) {
+    if (!sets[i] || !sets[i]->esboco)
+      return 0;
+    esbocos[i] = sets[i]->esboco;
+  }
+  return 1;
+}
+
+/*
+    As estimativas são presas aos limites que os tamanhos exatos (O(1))
+    garantem: a união fica entre o maior conjunto e a soma de todos, e a
+    intersecção não passa do menor.
+*/
+double set_estimar_uniao(SET **sets, size_t k) {
+  const ESBOCO **esbocos = (const ESBOCO **)malloc((k + 1) * sizeof(ESBOCO *));
+  if (!esbocos || !esbocos_dos_sets(sets, k, esbocos)) {
+    free(esbocos);
+    return -1.0;
+  }
+  double maior = 0.0, soma = 0.0;
+  for (size_t i = 0; i < k; i++) {
+    double n = (double)set_tamanho(sets[i]);
+    soma += n;
+    if (n > maior)
+      maior = n;
+  }
+  double estimativa = k == 1 ? soma : esboco_uniao(esbocos, k);
+  free(esbocos);
+  if (estimativa < maior)
+    estimativa = maior;
+  return estimativa > soma ? soma : estimativa;
+}
+
+double set_estimar_jaccard(SET **sets, size_t k) {
+  const ESBOCO **esbocos = (const ESBOCO **)malloc((k + 1) * sizeof(ESBOCO *));
+  if (!esbocos || !esbocos_dos_sets(sets, k, esbocos)) {
+    free(esbocos);
+    return -1.0;
+  }
+  double j = esboco_jaccard(esbocos, k);
+  free(esbocos);
+  return j;
+}
+
+double set_estimar_interseccao(SET **sets, size_t k) {
+  double uniao = set_estimar_uniao(sets, k);
+  double j = set_estimar_jaccard(sets, k);
+  if (uniao < 0.0 || j < 0.0)
+    return -1.0;
+  double estimativa = j * uniao, menor = (double)set_tamanho(sets[0]);
+  for (size_t i = 1; i < k; i++)
+    if ((double)set_tamanho(sets[i]) < menor)
+      menor = (double)set_tamanho(sets[i]);
+  return estimativa > menor ? menor : estimativa;
+}
+
+// Registra uma função a ser chamada a cada alteração do conjunto
+int set_observar(SET *set, SET_OBSERVADOR notificar, void *ctx) {
+  if (!set || !notificar)
+    return -1;
+  OBSERVADOR *o = (OBSERVADOR *)malloc(sizeof(OBSERVADOR));
+  if (!o)
+    return 0;
+  o->notificar = notificar;
+  o->ctx = ctx;
+  o->prox = set->observadores;
+  set->observadores = o;
+  return 1;
+}
+
+// Remove um registro feito por set_observar() (o primeiro que coincidir)
+int set_desobservar(SET *set, SET_OBSERVADOR notificar, void *ctx) {
+  if (!set)
+    return -1;
+  for (OBSERVADOR **p = &set->observadores; *p; p = &(*p)->prox) {
+    if ((*p)->notificar == notificar && (*p)->ctx == ctx) {
+      OBSERVADOR *o = *p;
+      *p = o->prox;
+      free(o);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+void notificar_observadores(SET *set, int evento, int valor) {
+  for (OBSERVADOR *o = set->observadores; o; o = o->prox)
+    o->notificar(o->ctx, set, evento, valor);
 }
@@ -3,19 +3,114 @@
 
 #include "../ARVORE_LLRB/arvore_llrb.h"
 #include "../AVL/bst_avl.h"
+#include "../EYTZINGER/eytzinger.h"
+#include "../SKIPLIST/skiplist.h"
+#include "estatisticas.h"
+#include "iterador.h"
+#include "saida.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// Estruturas disponíveis para representar o conjunto
+#define SET_AVL 0      // Árvore AVL
+#define SET_LLRB 1     // Árvore Rubro-Negra caída à esquerda
+#define SET_SKIPLIST 2 // Skip list lock-free (escrita concorrente)
+#define SET_CONGELADO 3 // Vetor de Eytzinger somente leitura
+#define SET_INTERVALOS 4 // Faixas de chaves consecutivas
+#define SET_COMPRIMIDO 5 // Blocos de diferenças comprimidas, somente leitura
+#define SET_WAVL 6 // Árvore AVL fraca (balanceada por postos)
+#define SET_SPLAY 7 // Árvore splay (chaves acessadas sobem para a raiz)
+
+/*
+    O SET guarda chaves `int`. Chaves uint32_t, int64_t e uint64_t têm
+    conjuntos próprios em set_chave.h, sempre em AVL e só com as operações
+    básicas, união e intersecção (ver a lista do que não suportam lá).
+*/
 typedef struct set SET;
 
+// Eventos entregues aos observadores de um conjunto (ver set_observar())
+#define SET_EVENTO_INSERIDO 0 // `valor` foi inserido
+#define SET_EVENTO_REMOVIDO 1 // `valor` foi removido
+#define SET_EVENTO_APAGADO 2  // O conjunto está sendo apagado
+
+// Função chamada a cada alteração de um conjunto observado
+typedef void (*SET_OBSERVADOR)(void *ctx, SET *set, int evento, int valor);
+
 /**
- * @brief Cria um novo conjunto com base no tipo de árvore escolhido.
+ * @brief Cria um novo conjunto com base no tipo de estrutura escolhido.
+ *
+ * Com SET_SKIPLIST, set_inserir(), set_remover() e set_pertence() podem ser
+ * chamadas por várias threads ao mesmo tempo sobre o mesmo conjunto. As demais
+ * operações (impressão, união, intersecção) percorrem o conjunto sem travas e
+ * enxergam um retrato fracamente consistente.
+ * Os nós removidos só são liberados por set_recolher(), em um momento em
+ * que nenhuma outra thread usa o conjunto.
+ *
+ * Com SET_CONGELADO o conjunto é somente leitura: set_inserir() e
+ * set_remover() retornam -1. Normalmente ele é obtido com set_congelar(),
+ * set_construir() ou como resultado de operações sobre conjuntos congelados.
+ *
+ * Com SET_INTERVALOS o conjunto guarda faixas [a, b] de chaves consecutivas
+ * em vez de chaves: memória e tempo das operações dependem da quantidade de
+ * faixas. set_uniao_k(), set_interseccao_k() e as contagens entre conjuntos
+ * de faixas combinam as faixas diretamente, sem passar pelas chaves.
+ *
+ * SET_COMPRIMIDO também é somente leitura e guarda as chaves em blocos de
+ * diferenças empacotadas, para conjuntos frios que ocupariam memória demais
+ * em árvore; é obtido com set_converter() ou set_construir().
+ *
+ * SET_WAVL é uma AVL fraca: mesma altura da AVL enquanto só há inserções,
+ * mas cada inserção ou remoção faz no máximo duas rotações e O(1) ajustes
+ * de posto amortizados, contra O(log(n)) rotações de uma remoção na AVL.
+ * Serve para conjuntos com muitas inserções e remoções alternadas.
  *
- * @param opt Identificador do tipo de árvore: 1 para AVL, 2 para Red-Black.
+ * Com SET_SPLAY cada acesso traz a chave para a raiz: quando poucas chaves
+ * recebem a maior parte das consultas, elas ficam a poucos passos do topo.
+ * Por isso set_pertence() altera a árvore e não pode rodar em paralelo com
+ * nada, nem com outras consultas, a menos que o autoajuste seja desligado
+ * (ver set_autoajuste()).
+ *
+ * @param opt Identificador da estrutura: SET_AVL (0), SET_LLRB (1),
+ *            SET_SKIPLIST (2), SET_CONGELADO (3), SET_INTERVALOS (4),
+ *            SET_COMPRIMIDO (5), SET_WAVL (6) ou SET_SPLAY (7).
  * @return Ponteiro para o conjunto criado ou NULL em caso de erro.
  */
 SET *criar_set(int opt);
 
+/**
+ * @brief Cria um conjunto já preenchido a partir de um vetor de valores.
+ *
+ * Os valores não precisam estar ordenados e podem ter repetições. Eles são
+ * ordenados e deduplicados em paralelo (radix sort) e a estrutura é montada
+ * já balanceada, com as subárvores independentes construídas em paralelo.
+ * É bem mais rápido que chamar set_inserir() para cada valor.
+ *
+ * @param opt Identificador da estrutura (ver criar_set()).
+ * @param valores Vetor de valores (não é modificado).
+ * @param n Quantidade de valores.
+ * @param threads Quantidade de threads; valores <= 0 usam todos os núcleos.
+ * @return Ponteiro para o conjunto criado ou NULL em caso de erro.
+ */
+SET *set_construir(int opt, const int *valores, size_t n, int threads);
+
+/**
+ * @brief Preenche um conjunto vazio com um vetor de valores, em lote.
+ *
+ * Como set_construir(), mas dentro de um conjunto que já existe: ele
+ * mantém o filtro, o esboço, o modo bufferizado, os observadores (que
+ * recebem um SET_EVENTO_INSERIDO por elemento) e o autoajuste da splay.
+ * Não pode rodar junto com outras operações sobre o conjunto.
+ *
+ * @param set Ponteiro para o conjunto, que deve estar vazio.
+ * @param valores Vetor de valores (não é modificado).
+ * @param n Quantidade de valores.
+ * @param threads Quantidade de threads; valores <= 0 usam todos os núcleos.
+ * @return 1 se o conjunto foi preenchido, 0 se ele não estava vazio ou em
+ *         caso de falha de alocação (o conjunto continua vazio), ou -1 se o
+ *         conjunto for inválido ou somente leitura.
+ */
+int set_preencher(SET *set, const int *valores, size_t n, int threads);
+
 /**
  * @brief Libera a memória associada a um conjunto.
  *
@@ -63,10 +158,26 @@ int set_inserir(SET *set, int valor);
 /**
  * @brief Imprime todos os elementos de um conjunto.
  *
+ * Equivale a set_emitir() sobre saida_arquivo(stdout), seguido de
+ * saida_finalizar().
+ *
  * @param set Ponteiro para o conjunto.
  */
 void set_imprimir(SET *set);
 
+/**
+ * @brief Envia todos os elementos do conjunto, em ordem crescente, para uma
+ * saída.
+ *
+ * Os elementos são entregues em lotes. O registro não é finalizado: o
+ * chamador decide quando chamar saida_finalizar().
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param saida Saída de destino (ver saida.h).
+ * @return 1 se todos os elementos foram aceitos, 0 se a saída interrompeu.
+ */
+int set_emitir(SET *set, SAIDA *saida);
+
 /**
  * @brief Imprime a união de dois conjuntos.
  *
@@ -88,4 +199,552 @@ void set_uniao(SET *set1, SET *set2);
  */
 void set_interseccao(SET *set1, SET *set2);
 
+/**
+ * @brief Cria um conjunto a partir de chaves já ordenadas e sem repetição.
+ *
+ * Monta a estrutura balanceada diretamente em O(n).
+ *
+ * @param opt Identificador da estrutura (ver criar_set()).
+ * @param chaves Vetor em ordem estritamente crescente.
+ * @param n Quantidade de chaves.
+ * @return Ponteiro para o conjunto criado ou NULL em caso de erro.
+ */
+SET *set_construir_ordenado(int opt, const int *chaves, size_t n);
+
+/**
+ * @brief Congela o conjunto em um vetor imutável otimizado para consultas.
+ *
+ * As chaves são copiadas para um vetor contíguo na ordem de Eytzinger (a
+ * árvore binária completa disposta em largura), alinhado à linha de cache.
+ * set_pertence() passa a ser uma busca sem desvios, com os próximos níveis
+ * pré-carregados, e união, intersecção e iteradores funcionam normalmente
+ * sobre a forma congelada. Depois disso set_inserir() e set_remover()
+ * retornam -1.
+ *
+ * Não pode ser chamada enquanto outras threads usam o conjunto, e iteradores
+ * abertos antes da chamada deixam de ser válidos.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return 1 se o conjunto foi congelado (ou já estava), 0 em caso de falha
+ *         de alocação (o conjunto não muda), ou -1 se o conjunto for inválido.
+ */
+int set_congelar(SET *set);
+
+/**
+ * @brief Troca a estrutura do conjunto, mantendo as chaves.
+ *
+ * Generaliza set_congelar(): as chaves são percorridas em ordem e a nova
+ * estrutura é montada de uma vez. Serve para comprimir um conjunto frio
+ * (SET_COMPRIMIDO) e para devolvê-lo a uma árvore quando voltar a receber
+ * escritas. O filtro, se ligado, é refeito no tipo adequado à estrutura
+ * nova; o modo bufferizado só sobrevive se o destino for SET_AVL, SET_LLRB
+ * ou SET_WAVL. Convertido para SET_SKIPLIST, o conjunto perde o filtro e o
+ * esboço, que não suportam os escritores concorrentes da skip list (ver
+ * set_filtrar() e set_esbocar()).
+ *
+ * Mesmas restrições de set_congelar() quanto a threads e iteradores.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param opt Estrutura de destino (ver criar_set()).
+ * @return 1 se o conjunto foi convertido (ou já usava `opt`), 0 em caso de
+ *         falha de alocação (o conjunto não muda), ou -1 se o conjunto ou a
+ *         estrutura forem inválidos.
+ */
+int set_converter(SET *set, int opt);
+
+/**
+ * @brief Libera a memória dos elementos removidos de um SET_SKIPLIST.
+ *
+ * Na skip list, outras threads podem estar lendo um nó enquanto ele é
+ * removido, então set_remover() apenas o retira da lista e a memória fica
+ * presa até esta chamada. Ela só pode ser feita quando nenhuma outra thread
+ * estiver usando o conjunto (nem com iteradores abertos), por exemplo sob a
+ * trava de escrita que protege o conjunto, e precisa ser repetida de tempos
+ * em tempos: sem ela, inserções e remoções alternadas fazem a memória
+ * crescer sem limite. O motor de comandos (comandos.h) e os conjuntos
+ * particionados (particao.h) a chamam sozinhos depois das remoções.
+ *
+ * A chamada é barata: a lista só é varrida quando os nós retirados passam
+ * de um quarto do tamanho do conjunto (e de um mínimo fixo), o que mantém
+ * o custo O(1) amortizado por remoção.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return 1 se os nós retirados foram liberados, 0 se ainda eram poucos (ou
+ *         o conjunto não é SET_SKIPLIST), ou -1 se o conjunto for inválido.
+ */
+int set_recolher(SET *set);
+
+/**
+ * @brief Relatório de compressão de um conjunto (ver set_compressao()).
+ */
+struct set_compressao {
+  size_t elementos;      /**< Chaves do conjunto. */
+  size_t blocos;         /**< Blocos de até 128 chaves. */
+  size_t bytes;          /**< Bytes da forma comprimida, com o índice. */
+  size_t bytes_vetor;    /**< Bytes das mesmas chaves num vetor de int. */
+  double razao;          /**< bytes_vetor / bytes (0 se vazio). */
+  double bits_por_chave; /**< 8 * bytes / elementos (0 se vazio). */
+};
+
+/**
+ * @brief Mede a compressão do conjunto.
+ *
+ * Para SET_COMPRIMIDO, informa o tamanho real. Para as demais estruturas,
+ * estima o que set_converter(set, SET_COMPRIMIDO) produziria, percorrendo
+ * as chaves em O(n) sem montar a forma comprimida.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param relatorio Estrutura que recebe os valores.
+ * @return 1 com o relatório preenchido, ou -1 em caso de erro.
+ */
+int set_compressao(SET *set, struct set_compressao *relatorio);
+
+/**
+ * @brief Liga ou desliga o autoajuste das consultas de um conjunto SET_SPLAY.
+ *
+ * Ligado (o padrão), set_pertence() faz o splay da chave consultada, e o
+ * conjunto se adapta às chaves quentes. Desligado, set_pertence() é uma
+ * busca sem escrita: várias threads podem consultar ao mesmo tempo (sem
+ * alterações concorrentes), na forma que a árvore tinha ao desligar.
+ * Inserções e remoções sempre fazem o splay.
+ *
+ * Conjuntos novos (inclusive os de set_dividir() e set_converter()) começam
+ * com o autoajuste ligado. Um splay invalida os iteradores abertos sobre o
+ * conjunto.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param ligar 1 para ligar, 0 para desligar.
+ * @return 1 em caso de sucesso, ou -1 se o conjunto for inválido ou não for
+ *         SET_SPLAY.
+ */
+int set_autoajuste(SET *set, int ligar);
+
+/**
+ * @brief Liga ou desliga o modo bufferizado, para fases de muita escrita.
+ *
+ * No modo bufferizado, set_inserir() e set_remover() não alteram a árvore:
+ * a alteração vai para um buffer (hash de chaves inseridas e marcas de
+ * remoção), e set_pertence() consulta o buffer antes da árvore. Os retornos
+ * e set_tamanho() continuam exatos. O buffer é ordenado e aplicado de uma
+ * vez (reconstruindo a árvore já balanceada) quando passa do limite ou de
+ * uma fração do tamanho do conjunto, e também antes de qualquer percurso
+ * em ordem (iteradores, impressão, união, intersecção, set_congelar()).
+ *
+ * Só vale para SET_AVL, SET_LLRB e SET_WAVL. Como um percurso pode alterar
+ * a árvore, nem consultas podem rodar em paralelo com outras operações no
+ * modo bufferizado.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param limite Mínimo de alterações pendentes antes de consolidar, ou 0
+ *               para consolidar e desligar o modo.
+ * @return 1 em caso de sucesso, 0 em caso de falha de alocação, ou -1 se o
+ *         conjunto for inválido ou não for AVL/LLRB/WAVL.
+ */
+int set_bufferizar(SET *set, size_t limite);
+
+/**
+ * @brief Aplica à árvore as alterações pendentes do modo bufferizado.
+ *
+ * Não é necessária para a corretude (os percursos já consolidam), mas
+ * permite escolher o momento do custo, por exemplo ao fim de uma ingestão.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return 1 em caso de sucesso (ou nada pendente), 0 em caso de falha de
+ *         alocação (as alterações continuam pendentes), ou -1 se o conjunto
+ *         for inválido.
+ */
+int set_consolidar(SET *set);
+
+/**
+ * @brief Liga ou desliga o pré-filtro de pertinência do conjunto.
+ *
+ * Com o filtro, set_pertence() responde a maioria das ausências sem descer
+ * a árvore, e as intersecções (set_interseccao_k_emitir() e as que a usam)
+ * e set_subconjunto() descartam candidatos ausentes sem saltar o iterador
+ * deste conjunto. Conjuntos mutáveis usam um Bloom em blocos, alimentado a
+ * cada inserção e reconstruído na escrita seguinte quando fica cheio ou
+ * acumula remoções demais; o conjunto congelado usa um filtro xor
+ * (set_congelar() troca um pelo outro).
+ *
+ * Depois de set_juntar()/set_concatenar() o filtro do destino é ignorado
+ * até a próxima inserção ou remoção (ou nova chamada com `ligar`), para
+ * não pagar O(n) na junção. Os pedaços de set_dividir() nascem sem filtro.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param ligar Diferente de 0 para (re)construir o filtro, 0 para removê-lo.
+ * @return 1 em caso de sucesso, 0 em caso de falha de alocação (o conjunto
+ *         fica sem filtro), ou -1 se o conjunto for inválido ou SET_SKIPLIST.
+ */
+int set_filtrar(SET *set, int ligar);
+
+/**
+ * @brief Liga ou desliga o esboço de cardinalidade do conjunto.
+ *
+ * O esboço (HyperLogLog + MinHash, ver esboco.h) recebe cada inserção em
+ * O(1) e permite estimar tamanhos de uniões e intersecções de muitos
+ * conjuntos em microssegundos, sem percorrer nenhum deles. Remoções não
+ * saem do esboço: ele é reconstruído na escrita que passar de
+ * 1/ESBOCO_TOLERANCIA de chaves removidas. set_juntar()/set_concatenar()
+ * juntam os esboços em O(1) quando todos os conjuntos têm um; os pedaços
+ * de set_dividir() nascem sem esboço.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param ligar Diferente de 0 para (re)construir o esboço, 0 para removê-lo.
+ * @return 1 em caso de sucesso, 0 em caso de falha de alocação (o conjunto
+ *         fica sem esboço), ou -1 se o conjunto for inválido ou SET_SKIPLIST.
+ */
+int set_esbocar(SET *set, int ligar);
+
+/**
+ * @brief Estima o tamanho da união de k conjuntos.
+ *
+ * Erro típico de ~1.6% (HyperLogLog com 4096 registradores), e o resultado
+ * fica sempre entre o maior conjunto e a soma dos tamanhos.
+ *
+ * @param sets Vetor de ponteiros para os conjuntos, todos com esboço.
+ * @param k Quantidade de conjuntos.
+ * @return Tamanho estimado, ou -1 se algum conjunto for inválido ou não
+ *         tiver esboço.
+ */
+double set_estimar_uniao(SET **sets, size_t k);
+
+/**
+ * @brief Estima a similaridade de Jaccard |∩| / |∪| de k conjuntos.
+ *
+ * Erro absoluto típico de sqrt(J (1 - J) / 256), no máximo ~3.1%.
+ *
+ * @param sets Vetor de ponteiros para os conjuntos, todos com esboço.
+ * @param k Quantidade de conjuntos.
+ * @return Similaridade estimada entre 0 e 1, ou -1 se algum conjunto for
+ *         inválido ou não tiver esboço.
+ */
+double set_estimar_jaccard(SET **sets, size_t k);
+
+/**
+ * @brief Estima o tamanho da intersecção de k conjuntos.
+ *
+ * Jaccard estimado vezes a união estimada, limitado pelo menor conjunto.
+ * O erro relativo é de ~3.1% / J + 1.6%: bom quando a intersecção é uma
+ * fração razoável da união, grosseiro quando é muito menor.
+ *
+ * @param sets Vetor de ponteiros para os conjuntos, todos com esboço.
+ * @param k Quantidade de conjuntos.
+ * @return Tamanho estimado, ou -1 se algum conjunto for inválido ou não
+ *         tiver esboço.
+ */
+double set_estimar_interseccao(SET **sets, size_t k);
+
+/**
+ * @brief Divide o conjunto em dois pela chave, em O(log(n)).
+ *
+ * As árvores são cortadas ao longo do caminho da busca, usando as alturas
+ * (AVL) ou alturas negras (LLRB) já guardadas, sem copiar nem realocar nós.
+ * O tamanho de cada pedaço é contado na primeira chamada a set_tamanho()
+ * sobre ele (O(n) uma única vez), já que as árvores não guardam o tamanho
+ * das subárvores; com SET_INTERVALOS a contagem soma as faixas.
+ *
+ * Só vale para SET_AVL, SET_LLRB, SET_WAVL, SET_SPLAY e SET_INTERVALOS sem
+ * observadores (visões ficariam desatualizadas). Um conjunto bufferizado é consolidado antes; os
+ * pedaços saem sem buffer.
+ *
+ * @param set Ponteiro para o conjunto; fica vazio (mas continua válido).
+ * @param chave Chave de corte.
+ * @param menores Recebe um conjunto novo com os elementos < chave.
+ * @param maiores Recebe um conjunto novo com os elementos >= chave.
+ * @return 1 em caso de sucesso, 0 em caso de falha de alocação (nada
+ *         muda), ou -1 se o conjunto for inválido ou não puder ser dividido.
+ */
+int set_dividir(SET *set, int chave, SET **menores, SET **maiores);
+
+/**
+ * @brief Move todos os elementos de b para a, em O(log(n)).
+ *
+ * Todos os elementos de a devem ser menores que todos os de b. A árvore
+ * mais baixa é pendurada na borda da mais alta e só esse caminho é
+ * rebalanceado. Mesmas restrições de set_dividir(); os dois conjuntos
+ * devem usar a mesma estrutura.
+ *
+ * @param a Conjunto que recebe os elementos.
+ * @param b Conjunto de elementos maiores; fica vazio.
+ * @return 1 em caso de sucesso, 0 se a ordem não for respeitada ou faltar
+ *         memória (nada muda), ou -1 se algum conjunto for inválido ou não
+ *         puder ser juntado.
+ */
+int set_juntar(SET *a, SET *b);
+
+/**
+ * @brief Junta k conjuntos, em ordem, no primeiro, em O(k log(n)).
+ *
+ * Os conjuntos devem estar em ordem crescente de chaves (vazios são
+ * ignorados); a ordem é verificada antes de qualquer mudança. Mesmas
+ * restrições de set_juntar().
+ *
+ * @param sets Vetor de ponteiros para os conjuntos; sets[0] recebe tudo e os
+ *             demais ficam vazios.
+ * @param k Quantidade de conjuntos.
+ * @return 1 em caso de sucesso, 0 se a ordem não for respeitada (nada muda)
+ *         ou faltar memória (os conjuntos anteriores já foram juntados), ou
+ *         -1 se algum conjunto for inválido ou não puder ser juntado.
+ */
+int set_concatenar(SET **sets, size_t k);
+
+/**
+ * @brief Retorna a quantidade de elementos do conjunto, em O(1).
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return Quantidade de elementos (0 para conjunto inválido).
+ */
+size_t set_tamanho(SET *set);
+
+/**
+ * @brief Retorna a assinatura dos elementos do conjunto, em O(1).
+ *
+ * A assinatura é a soma (mod 2^64) de um hash de cada elemento, mantida a
+ * cada inserção e remoção. Não depende da ordem das operações nem da
+ * estrutura: conjuntos iguais têm sempre a mesma assinatura, e conjuntos
+ * diferentes quase nunca (serve como chave de cache, com confirmação por
+ * set_igual()).
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return Assinatura (0 para conjunto vazio ou inválido).
+ */
+uint64_t set_assinatura(SET *set);
+
+/**
+ * @brief Identificador único do conjunto.
+ *
+ * Atribuído na criação e nunca reutilizado durante a execução, mesmo depois
+ * que o conjunto é apagado: junto com set_versao() identifica um estado do
+ * conteúdo (ver cache.h).
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return Identificador (0 para conjunto inválido).
+ */
+uint64_t set_id(SET *set);
+
+/**
+ * @brief Versão do conteúdo do conjunto.
+ *
+ * Incrementada a cada set_inserir() ou set_remover() bem-sucedido e pelas
+ * operações que movem elementos (set_dividir(), set_juntar(),
+ * set_concatenar()). Operações sem efeito, consolidações do buffer e
+ * set_congelar() não mudam o conteúdo e não mudam a versão.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return Versão atual (0 para conjunto inválido ou nunca alterado).
+ */
+uint64_t set_versao(SET *set);
+
+/**
+ * @brief Estrutura que representa o conjunto.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @return SET_AVL, SET_LLRB, SET_SKIPLIST, SET_CONGELADO, SET_INTERVALOS,
+ *         SET_COMPRIMIDO, SET_WAVL ou SET_SPLAY (-1 para conjunto inválido).
+ */
+int set_estrutura(SET *set);
+
+/**
+ * @brief Verifica se dois conjuntos têm os mesmos elementos.
+ *
+ * Tamanhos ou assinaturas diferentes respondem em O(1); senão os dois
+ * conjuntos são percorridos juntos até a primeira diferença.
+ *
+ * @param a Ponteiro para o primeiro conjunto.
+ * @param b Ponteiro para o segundo conjunto.
+ * @return 1 se forem iguais, 0 se não, ou -1 se algum for inválido.
+ */
+int set_igual(SET *a, SET *b);
+
+/**
+ * @brief Verifica se todo elemento de a pertence a b.
+ *
+ * Percorre a saltando em b até cada elemento (O(log(n)) por salto) e para
+ * no primeiro que faltar. Se a for maior que b a resposta sai em O(1).
+ *
+ * @param a Ponteiro para o possível subconjunto.
+ * @param b Ponteiro para o conjunto que o conteria.
+ * @return 1 se a ⊆ b, 0 se não, ou -1 se algum for inválido.
+ */
+int set_subconjunto(SET *a, SET *b);
+
+/**
+ * @brief Verifica se dois conjuntos não têm elementos em comum.
+ *
+ * Intersecção por saltos (como set_interseccao_k_emitir()) que para no
+ * primeiro elemento comum.
+ *
+ * @param a Ponteiro para o primeiro conjunto.
+ * @param b Ponteiro para o segundo conjunto.
+ * @return 1 se forem disjuntos, 0 se não, ou -1 se algum for inválido.
+ */
+int set_disjuntos(SET *a, SET *b);
+
+/**
+ * @brief Tamanho exato da intersecção de dois conjuntos, sem montá-la.
+ *
+ * Os percursos são lidos em lotes na pilha (o conjunto congelado copia o
+ * lote direto do vetor) e contados de 4 em 4 chaves com SSE2. Se um
+ * conjunto for 32 vezes menor que o outro, cada chave dele salta o maior
+ * em O(log(n)). Não aloca memória, salvo a consolidação de um conjunto em
+ * modo bufferizado (como qualquer percurso).
+ *
+ * @param a Ponteiro para o primeiro conjunto.
+ * @param b Ponteiro para o segundo conjunto.
+ * @return |a ∩ b|, ou 0 se algum for inválido.
+ */
+size_t set_tamanho_interseccao(SET *a, SET *b);
+
+/**
+ * @brief Tamanho exato da união de dois conjuntos, sem montá-la.
+ *
+ * |a| + |b| - |a ∩ b|, com a intersecção contada como em
+ * set_tamanho_interseccao().
+ *
+ * @param a Ponteiro para o primeiro conjunto.
+ * @param b Ponteiro para o segundo conjunto.
+ * @return |a ∪ b|, ou 0 se algum for inválido.
+ */
+size_t set_tamanho_uniao(SET *a, SET *b);
+
+/**
+ * @brief Tamanho exato da diferença a \ b, sem montá-la.
+ *
+ * |a| - |a ∩ b|, com a intersecção contada como em
+ * set_tamanho_interseccao().
+ *
+ * @param a Ponteiro para o conjunto de onde se tiram os elementos.
+ * @param b Ponteiro para o conjunto com os elementos tirados.
+ * @return |a \ b|, ou 0 se algum for inválido.
+ */
+size_t set_tamanho_diferenca(SET *a, SET *b);
+
+/**
+ * @brief Lê os contadores estruturais do conjunto.
+ *
+ * Com -DSET_ESTATISTICAS (`make ESTATISTICAS=1`), cada conjunto conta
+ * comparações, nós visitados, rotações, trocas de cor, alocações e bytes
+ * vivos das suas inserções, remoções, buscas e construções (ver
+ * estatisticas.h). A altura atual é sempre calculada.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param stats Estrutura que recebe os valores.
+ * @return 1 com os contadores preenchidos, 0 se eles não foram compilados
+ *         (só as alturas são preenchidas), ou -1 em caso de erro.
+ */
+int set_estatisticas(SET *set, struct set_stats *stats);
+
+/**
+ * @brief Calcula a união de k conjuntos.
+ *
+ * Intercala os k percursos em ordem com um heap, sem conjuntos temporários
+ * intermediários, e monta o resultado de uma só vez.
+ *
+ * @param sets Vetor de ponteiros para os conjuntos.
+ * @param k Quantidade de conjuntos.
+ * @return Novo conjunto (mesma estrutura de sets[0]) com a união, ou NULL em
+ *         caso de erro. Deve ser liberado com set_apagar().
+ */
+SET *set_uniao_k(SET **sets, size_t k);
+
+/**
+ * @brief Calcula a intersecção de k conjuntos.
+ *
+ * Processa os conjuntos do menor para o maior com saltos (leapfrog): cada
+ * candidato do menor conjunto é procurado nos demais com buscas em
+ * O(log(n)), então conjuntos pequenos podam os grandes logo no início.
+ *
+ * @param sets Vetor de ponteiros para os conjuntos.
+ * @param k Quantidade de conjuntos.
+ * @return Novo conjunto (mesma estrutura de sets[0]) com a intersecção, ou
+ *         NULL em caso de erro. Deve ser liberado com set_apagar().
+ */
+SET *set_interseccao_k(SET **sets, size_t k);
+
+/**
+ * @brief Envia a união de k conjuntos, em ordem crescente, para uma saída.
+ *
+ * Mesmo algoritmo de set_uniao_k(), sem montar conjunto: útil para escrever
+ * o resultado direto em um vetor do chamador ou em um arquivo.
+ *
+ * @param sets Vetor de ponteiros para os conjuntos.
+ * @param k Quantidade de conjuntos.
+ * @param saida Saída de destino.
+ * @return 1 se o resultado foi todo aceito, 0 se a saída interrompeu ou em
+ *         caso de erro.
+ */
+int set_uniao_k_emitir(SET **sets, size_t k, SAIDA *saida);
+
+/**
+ * @brief Envia a intersecção de k conjuntos, em ordem crescente, para uma
+ * saída.
+ *
+ * @param sets Vetor de ponteiros para os conjuntos.
+ * @param k Quantidade de conjuntos.
+ * @param saida Saída de destino.
+ * @return 1 se o resultado foi todo aceito, 0 se a saída interrompeu ou em
+ *         caso de erro.
+ */
+int set_interseccao_k_emitir(SET **sets, size_t k, SAIDA *saida);
+
+/**
+ * @brief Registra um observador das alterações do conjunto.
+ *
+ * `notificar` é chamada depois de cada set_inserir() ou set_remover()
+ * bem-sucedido, com o valor alterado, e uma última vez com
+ * SET_EVENTO_APAGADO dentro de set_apagar(). Com SET_SKIPLIST as chamadas
+ * podem vir de várias threads ao mesmo tempo e fora da ordem das alterações
+ * (a remoção de um valor pode ser notificada antes da inserção que ela
+ * desfaz); o observador deve tolerar isso. O registro não pode ser feito
+ * enquanto outras threads alteram o conjunto.
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param notificar Função a ser chamada.
+ * @param ctx Ponteiro repassado a cada chamada.
+ * @return 1 em caso de sucesso, 0 em caso de falha de alocação, ou -1 se os
+ *         parâmetros forem inválidos.
+ */
+int set_observar(SET *set, SET_OBSERVADOR notificar, void *ctx);
+
+/**
+ * @brief Remove um observador registrado com set_observar().
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param notificar Função registrada.
+ * @param ctx Ponteiro registrado junto.
+ * @return 1 se o registro foi removido, 0 se não existia, ou -1 se o
+ *         conjunto for inválido.
+ */
+int set_desobservar(SET *set, SET_OBSERVADOR notificar, void *ctx);
+
+/**
+ * @brief Prepara um iterador em ordem crescente sobre o conjunto.
+ *
+ * O iterador não aloca memória em casos normais, mas deve ser encerrado com
+ * iterador_finalizar().
+ *
+ * @param set Ponteiro para o conjunto.
+ * @param it Iterador a ser preparado (alocado pelo chamador).
+ */
+void set_iterador(SET *set, ITERADOR *it);
+
+/**
+ * @brief Obtém o próximo elemento do conjunto em ordem crescente.
+ *
+ * @param it Iterador preparado por set_iterador().
+ * @param valor Recebe o elemento visitado.
+ * @return 1 se um elemento foi obtido, 0 ao final do conjunto.
+ */
+int set_iterador_proximo(ITERADOR *it, int *valor);
+
+/**
+ * @brief Avança o iterador até o primeiro elemento maior ou igual a `alvo`.
+ *
+ * @param it Iterador preparado por set_iterador().
+ * @param alvo Menor elemento aceitável.
+ * @param valor Recebe o elemento encontrado.
+ * @return 1 se um elemento foi obtido, 0 se não houver elemento >= alvo.
+ */
+int set_iterador_buscar(ITERADOR *it, int alvo, int *valor);
+
 #endif // SET_H
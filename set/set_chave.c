@@ -0,0 +1,25 @@
+#include <stdlib.h>
+
+#include "set_chave.h"
+#include "ordenacao.h"
+#include "../AVL/bst_avl.h"
+
+// Uma instância do modelo por largura de chave
+
+#define CHAVE_TIPO uint32_t
+#define CHAVE_SUFIXO u32
+#define CHAVE_CONJUNTO SET_U32
+#define CHAVE_ARVORE AVL_U32
+#include "set_chave_modelo.h"
+
+#define CHAVE_TIPO int64_t
+#define CHAVE_SUFIXO i64
+#define CHAVE_CONJUNTO SET_I64
+#define CHAVE_ARVORE AVL_I64
+#include "set_chave_modelo.h"
+
+#define CHAVE_TIPO uint64_t
+#define CHAVE_SUFIXO u64
+#define CHAVE_CONJUNTO SET_U64
+#define CHAVE_ARVORE AVL_U64
+#include "set_chave_modelo.h"
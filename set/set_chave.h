@@ -0,0 +1,93 @@
+#ifndef SET_CHAVE_H
+#define SET_CHAVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "iterador.h"
+
+/*
+    Conjuntos com chaves de outras larguras. Chaves `int` continuam no SET
+    (set.h), com todas as estruturas; aqui cada largura usa a AVL de
+    AVL/bst_avl.c instanciada para o seu tipo de chave (o mesmo código da
+    SET_AVL), sem `void *` nem conversões, e o caminho de 32 bits não fica
+    maior nem mais lento.
+
+    Para cada largura, com <s> = u32, i64 ou u64 e <T> o tipo da chave:
+
+      SET_U32 (uint32_t)   SET_I64 (int64_t)   SET_U64 (uint64_t)
+
+    Todo o intervalo do tipo é válido; nenhum valor é reservado.
+
+    O escopo é só o das operações abaixo. Estes conjuntos não escolhem
+    estrutura (são sempre AVL) e não têm o que o SET acrescenta à árvore:
+    filtro e esboço, observadores e visões, modo bufferizado, congelamento
+    e conversão, divisão e junção, contadores (set_estatisticas()),
+    expressões, cache, operações assíncronas nem partições. Também não são
+    seguros para uso concorrente.
+*/
+
+/**
+ * @fn SET_<S> *set_<s>_criar(void)
+ * @brief Cria um conjunto vazio.
+ * @return Ponteiro para o conjunto ou NULL em caso de erro.
+ *
+ * @fn void set_<s>_apagar(SET_<S> **set)
+ * @brief Libera o conjunto; o ponteiro é definido como NULL.
+ *
+ * @fn int set_<s>_inserir(SET_<S> *set, <T> valor)
+ * @brief Insere um valor.
+ * @return 1 se inseriu, 0 se já existia (ou sem memória), -1 se inválido.
+ *
+ * @fn int set_<s>_remover(SET_<S> *set, <T> valor)
+ * @brief Remove um valor.
+ * @return 1 se removeu, 0 se não existia, -1 se inválido.
+ *
+ * @fn int set_<s>_pertence(SET_<S> *set, <T> valor)
+ * @brief Verifica se um valor pertence ao conjunto.
+ * @return 1 se pertence, 0 caso contrário.
+ *
+ * @fn size_t set_<s>_tamanho(SET_<S> *set)
+ * @brief Quantidade de elementos, em O(1).
+ *
+ * @fn void set_<s>_iterador(SET_<S> *set, ITERADOR *it)
+ * @brief Prepara um iterador em ordem crescente (finalizar com
+ * iterador_finalizar()).
+ *
+ * @fn int set_<s>_iterador_proximo(ITERADOR *it, <T> *valor)
+ * @brief Obtém o próximo elemento; retorna 0 ao final.
+ *
+ * @fn int set_<s>_iterador_buscar(ITERADOR *it, <T> alvo, <T> *valor)
+ * @brief Avança até o primeiro elemento >= alvo; retorna 0 se não houver.
+ *
+ * @fn SET_<S> *set_<s>_construir_ordenado(const <T> *chaves, size_t n)
+ * @brief Cria um conjunto a partir de chaves crescentes e sem repetição,
+ * em O(n) e já balanceado.
+ * @return Novo conjunto ou NULL em caso de erro.
+ *
+ * @fn SET_<S> *set_<s>_uniao(SET_<S> *a, SET_<S> *b)
+ * @brief Novo conjunto com a união, por intercalação em O(n + m).
+ *
+ * @fn SET_<S> *set_<s>_interseccao(SET_<S> *a, SET_<S> *b)
+ * @brief Novo conjunto com a intersecção, por intercalação com saltos.
+ */
+#define SET_CHAVE_DECLARAR(S, s, T)                                            \
+  typedef struct set_##s S;                                                    \
+  S *set_##s##_criar(void);                                                    \
+  void set_##s##_apagar(S **set);                                              \
+  int set_##s##_inserir(S *set, T valor);                                      \
+  int set_##s##_remover(S *set, T valor);                                      \
+  int set_##s##_pertence(S *set, T valor);                                     \
+  size_t set_##s##_tamanho(S *set);                                            \
+  void set_##s##_iterador(S *set, ITERADOR *it);                               \
+  int set_##s##_iterador_proximo(ITERADOR *it, T *valor);                      \
+  int set_##s##_iterador_buscar(ITERADOR *it, T alvo, T *valor);               \
+  S *set_##s##_construir_ordenado(const T *chaves, size_t n);                  \
+  S *set_##s##_uniao(S *a, S *b);                                              \
+  S *set_##s##_interseccao(S *a, S *b);
+
+SET_CHAVE_DECLARAR(SET_U32, u32, uint32_t)
+SET_CHAVE_DECLARAR(SET_I64, i64, int64_t)
+SET_CHAVE_DECLARAR(SET_U64, u64, uint64_t)
+
+#endif // SET_CHAVE_H
@@ -0,0 +1,188 @@
+/*
+    Modelo do conjunto com chave de largura fixa (ver set_chave.h). Este
+    arquivo não tem guarda de inclusão: set_chave.c o inclui uma vez por
+    largura, definindo antes
+
+      CHAVE_TIPO      tipo da chave (ex.: int64_t)
+      CHAVE_SUFIXO    sufixo dos nomes (ex.: i64 -> set_i64_inserir)
+      CHAVE_CONJUNTO  tipo público do conjunto (ex.: SET_I64)
+      CHAVE_ARVORE    instância da AVL com a mesma chave (ex.: AVL_I64)
+
+    A árvore é a de AVL/bst_avl.c, instanciada para a largura; aqui fica só
+    o tamanho do conjunto e as operações entre conjuntos.
+*/
+
+#ifndef CHAVE_JUNTAR
+#define CHAVE_COLAR(a, b) a##b
+#define CHAVE_JUNTAR(a, b) CHAVE_COLAR(a, b)
+#endif
+
+#define NOME(x) CHAVE_JUNTAR(CHAVE_JUNTAR(set_, CHAVE_SUFIXO), _##x)
+#define ARVORE(x) CHAVE_JUNTAR(CHAVE_JUNTAR(avl_, CHAVE_SUFIXO), _##x)
+
+struct CHAVE_JUNTAR(set_, CHAVE_SUFIXO) {
+  CHAVE_ARVORE *arvore;
+  size_t tamanho;
+};
+
+// Protocolo das Funções
+
+// Auxiliares
+CHAVE_CONJUNTO *NOME(intercalar)(CHAVE_CONJUNTO *a, CHAVE_CONJUNTO *b,
+                                 int interseccao);
+
+// Principais
+CHAVE_CONJUNTO *NOME(criar)(void);
+void NOME(apagar)(CHAVE_CONJUNTO **set);
+int NOME(inserir)(CHAVE_CONJUNTO *set, CHAVE_TIPO valor);
+int NOME(remover)(CHAVE_CONJUNTO *set, CHAVE_TIPO valor);
+int NOME(pertence)(CHAVE_CONJUNTO *set, CHAVE_TIPO valor);
+size_t NOME(tamanho)(CHAVE_CONJUNTO *set);
+void NOME(iterador)(CHAVE_CONJUNTO *set, ITERADOR *it);
+int NOME(iterador_proximo)(ITERADOR *it, CHAVE_TIPO *valor);
+int NOME(iterador_buscar)(ITERADOR *it, CHAVE_TIPO alvo, CHAVE_TIPO *valor);
+CHAVE_CONJUNTO *NOME(construir_ordenado)(const CHAVE_TIPO *chaves, size_t n);
+CHAVE_CONJUNTO *NOME(uniao)(CHAVE_CONJUNTO *a, CHAVE_CONJUNTO *b);
+CHAVE_CONJUNTO *NOME(interseccao)(CHAVE_CONJUNTO *a, CHAVE_CONJUNTO *b);
+
+/*
+    União e intersecção intercalam os dois iteradores em um vetor ordenado
+    e constroem o resultado de uma vez. Na intersecção o operando atrasado
+    salta direto até o elemento do outro.
+*/
+CHAVE_CONJUNTO *NOME(intercalar)(CHAVE_CONJUNTO *a, CHAVE_CONJUNTO *b,
+                                 int interseccao) {
+  if (a == NULL || b == NULL)
+    return NULL;
+
+  size_t cap = interseccao ? (a->tamanho < b->tamanho ? a->tamanho
+                                                       : b->tamanho)
+                           : a->tamanho + b->tamanho;
+  CHAVE_TIPO *chaves = (CHAVE_TIPO *)malloc((cap ? cap : 1) *
+                                            sizeof(CHAVE_TIPO));
+  if (chaves == NULL)
+    return NULL;
+
+  ITERADOR ia, ib;
+  CHAVE_TIPO x, y;
+  size_t n = 0;
+  NOME(iterador)(a, &ia);
+  NOME(iterador)(b, &ib);
+  int tem_x = NOME(iterador_proximo)(&ia, &x);
+  int tem_y = NOME(iterador_proximo)(&ib, &y);
+
+  if (interseccao) {
+    while (tem_x && tem_y) {
+      if (x < y) {
+        tem_x = NOME(iterador_buscar)(&ia, y, &x);
+      } else if (y < x) {
+        tem_y = NOME(iterador_buscar)(&ib, x, &y);
+      } else {
+        chaves[n++] = x;
+        tem_x = NOME(iterador_proximo)(&ia, &x);
+        tem_y = NOME(iterador_proximo)(&ib, &y);
+      }
+    }
+  } else {
+    while (tem_x || tem_y) {
+      if (tem_x && (!tem_y || x < y)) {
+        chaves[n++] = x;
+        tem_x = NOME(iterador_proximo)(&ia, &x);
+      } else {
+        if (tem_x && x == y)
+          tem_x = NOME(iterador_proximo)(&ia, &x);
+        chaves[n++] = y;
+        tem_y = NOME(iterador_proximo)(&ib, &y);
+      }
+    }
+  }
+  iterador_finalizar(&ia);
+  iterador_finalizar(&ib);
+
+  CHAVE_CONJUNTO *resultado = NOME(construir_ordenado)(chaves, n);
+  free(chaves);
+  return resultado;
+}
+
+CHAVE_CONJUNTO *NOME(criar)(void) {
+  CHAVE_CONJUNTO *set = (CHAVE_CONJUNTO *)malloc(sizeof(CHAVE_CONJUNTO));
+  if (set == NULL)
+    return NULL;
+  set->arvore = CHAVE_JUNTAR(criar_avl_, CHAVE_SUFIXO)();
+  if (set->arvore == NULL) {
+    free(set);
+    return NULL;
+  }
+  set->tamanho = 0;
+  return set;
+}
+
+void NOME(apagar)(CHAVE_CONJUNTO **set) {
+  if (set == NULL || *set == NULL)
+    return;
+  ARVORE(apagar)(&(*set)->arvore);
+  free(*set);
+  *set = NULL;
+}
+
+int NOME(inserir)(CHAVE_CONJUNTO *set, CHAVE_TIPO valor) {
+  if (set == NULL)
+    return -1;
+  int resp = ARVORE(inserir)(set->arvore, valor);
+  set->tamanho += resp == 1;
+  return resp;
+}
+
+int NOME(remover)(CHAVE_CONJUNTO *set, CHAVE_TIPO valor) {
+  if (set == NULL)
+    return -1;
+  int resp = ARVORE(remover)(set->arvore, valor);
+  set->tamanho -= resp == 1;
+  return resp;
+}
+
+int NOME(pertence)(CHAVE_CONJUNTO *set, CHAVE_TIPO valor) {
+  return set != NULL && ARVORE(buscar)(set->arvore, valor) == 1;
+}
+
+size_t NOME(tamanho)(CHAVE_CONJUNTO *set) { return set ? set->tamanho : 0; }
+
+void NOME(iterador)(CHAVE_CONJUNTO *set, ITERADOR *it) {
+  ARVORE(iterador)(set ? set->arvore : NULL, it);
+}
+
+int NOME(iterador_proximo)(ITERADOR *it, CHAVE_TIPO *valor) {
+  return ARVORE(iterador_proximo)(it, valor);
+}
+
+int NOME(iterador_buscar)(ITERADOR *it, CHAVE_TIPO alvo, CHAVE_TIPO *valor) {
+  return ARVORE(iterador_buscar)(it, alvo, valor);
+}
+
+CHAVE_CONJUNTO *NOME(construir_ordenado)(const CHAVE_TIPO *chaves, size_t n) {
+  CHAVE_CONJUNTO *set = NOME(criar)();
+  if (set == NULL)
+    return NULL;
+
+  if (ARVORE(construir)(set->arvore, chaves, n, ordenacao_threads(0)) != 1) {
+    NOME(apagar)(&set);
+    return NULL;
+  }
+  set->tamanho = n;
+  return set;
+}
+
+CHAVE_CONJUNTO *NOME(uniao)(CHAVE_CONJUNTO *a, CHAVE_CONJUNTO *b) {
+  return NOME(intercalar)(a, b, 0);
+}
+
+CHAVE_CONJUNTO *NOME(interseccao)(CHAVE_CONJUNTO *a, CHAVE_CONJUNTO *b) {
+  return NOME(intercalar)(a, b, 1);
+}
+
+#undef NOME
+#undef ARVORE
+#undef CHAVE_TIPO
+#undef CHAVE_SUFIXO
+#undef CHAVE_CONJUNTO
+#undef CHAVE_ARVORE
@@ -0,0 +1,239 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "visao.h"
+
+// Capacidade inicial da tabela de multiplicidades (potência de 2)
+#define MULTIPLICIDADE_MIN 64
+
+/*
+    Entrada da tabela: contagem 0 marca posição livre. A contagem é o saldo
+    de inserções e remoções notificadas; com operandos skip list a remoção
+    de uma chave pode chegar antes da inserção que ela desfaz, então o saldo
+    pode ficar negativo por um tempo, mas volta a ser exato quando todas as
+    notificações tiverem chegado.
+*/
+typedef struct entrada_mult {
+  int chave;
+  int32_t contagem; // Quantos operandos contêm `chave`
+} ENTRADA_MULT;
+
+/*
+    Tabela hash de endereçamento aberto (sondagem linear). A remoção
+    desloca as entradas seguintes para trás em vez de deixar marcas, então
+    a tabela nunca degrada com inserções e remoções alternadas.
+*/
+typedef struct visao {
+  int tipo;
+  SET **operandos;      // NULL depois que o operando é apagado
+  size_t k;
+  SET *resultado;
+  ENTRADA_MULT *tabela;
+  size_t capacidade;    // Potência de 2
+  size_t usados;
+  int erro;              // Alguma alteração dos operandos ficou de fora
+  pthread_mutex_t trava; // Serializa as notificações de cada operando
+} VISAO;
+
+// Protocolo das Funções
+
+// Auxiliares
+size_t posicao_mult(VISAO *v, int chave);
+int crescer_mult(VISAO *v);
+int somar_mult(VISAO *v, int chave, int delta, int32_t *contagem);
+void notificar_visao(void *ctx, SET *set, int evento, int valor);
+
+// Principais
+VISAO *visao_criar(int tipo, SET **sets, size_t k, int opt);
+SET *visao_conjunto(VISAO *visao);
+int visao_erro(VISAO *visao);
+void visao_apagar(VISAO **visao);
+
+// Posição inicial de uma chave (hash multiplicativo)
+size_t posicao_mult(VISAO *v, int chave) {
+  return (size_t)((uint32_t)chave * 2654435761u) & (v->capacidade - 1);
+}
+
+// Dobra a tabela e reposiciona as entradas
+int crescer_mult(VISAO *v) {
+  size_t antiga = v->capacidade;
+  ENTRADA_MULT *velha = v->tabela;
+  size_t nova = antiga ? antiga * 2 : MULTIPLICIDADE_MIN;
+
+  ENTRADA_MULT *t = (ENTRADA_MULT *)calloc(nova, sizeof(ENTRADA_MULT));
+  if (!t)
+    return 0;
+  v->tabela = t;
+  v->capacidade = nova;
+
+  for (size_t i = 0; i < antiga; i++) {
+    if (velha[i].contagem == 0)
+      continue;
+    size_t p = posicao_mult(v, velha[i].chave);
+    while (t[p].contagem != 0)
+      p = (p + 1) & (nova - 1);
+    t[p] = velha[i];
+  }
+  free(velha);
+  return 1;
+}
+
+/*
+    Soma `delta` (+1 ou -1) à contagem da chave e guarda a nova contagem em
+    `contagem`. Contagens que chegam a 0 saem da tabela. Retorna 0 se faltar
+    memória para uma chave nova.
+*/
+int somar_mult(VISAO *v, int chave, int delta, int32_t *contagem) {
+  size_t mascara = v->capacidade - 1;
+  size_t p = posicao_mult(v, chave);
+  while (v->tabela[p].contagem != 0 && v->tabela[p].chave != chave)
+    p = (p + 1) & mascara;
+
+  ENTRADA_MULT *e = &v->tabela[p];
+  if (e->contagem == 0) {
+    // Chave nova; carga máxima de 3/4
+    if ((v->usados + 1) * 4 > v->capacidade * 3) {
+      if (!crescer_mult(v))
+        return 0;
+      return somar_mult(v, chave, delta, contagem);
+    }
+    e->chave = chave;
+    v->usados++;
+  }
+  e->contagem += delta;
+  *contagem = e->contagem;
+  if (e->contagem != 0)
+    return 1;
+
+  // Remoção com deslocamento para trás: puxa as entradas seguintes do
+  // mesmo agrupamento que pertencem a posições anteriores
+  v->usados--;
+  size_t livre = p;
+  for (size_t q = (p + 1) & mascara; v->tabela[q].contagem != 0;
+       q = (q + 1) & mascara) {
+    size_t ideal = posicao_mult(v, v->tabela[q].chave);
+    // `q` pode ocupar `livre` se `ideal` não estiver entre livre e q
+    if (((q - ideal) & mascara) >= ((q - livre) & mascara)) {
+      v->tabela[livre] = v->tabela[q];
+      livre = q;
+    }
+  }
+  v->tabela[livre].contagem = 0;
+  return 1;
+}
+
+// Chamada pelos operandos a cada alteração
+void notificar_visao(void *ctx, SET *set, int evento, int valor) {
+  VISAO *v = (VISAO *)ctx;
+
+  pthread_mutex_lock(&v->trava);
+  if (evento == SET_EVENTO_APAGADO) {
+    for (size_t i = 0; i < v->k; i++)
+      if (v->operandos[i] == set)
+        v->operandos[i] = NULL;
+  } else if (evento == SET_EVENTO_INSERIDO || evento == SET_EVENTO_REMOVIDO) {
+    int32_t c;
+    if (!somar_mult(v, valor, evento == SET_EVENTO_INSERIDO ? +1 : -1, &c)) {
+      v->erro = 1;
+    } else {
+      // A pertinência sai da contagem atual, e não da transição que ela
+      // acabou de fazer: notificações fora de ordem se corrigem sozinhas
+      int pertence = c > 0 && (v->tipo == VISAO_UNIAO || (size_t)c == v->k);
+      int resp = pertence ? set_inserir(v->resultado, valor)
+                          : set_remover(v->resultado, valor);
+      if (resp < 0)
+        v->erro = 1;
+    }
+  }
+  pthread_mutex_unlock(&v->trava);
+}
+
+VISAO *visao_criar(int tipo, SET **sets, size_t k, int opt) {
+  if (!sets || k == 0 || k >= INT32_MAX || opt == SET_CONGELADO ||
+      opt == SET_COMPRIMIDO ||
+      (tipo != VISAO_UNIAO && tipo != VISAO_INTERSECCAO))
+    return NULL;
+  for (size_t i = 0; i < k; i++)
+    if (!sets[i])
+      return NULL;
+
+  VISAO *v = (VISAO *)calloc(1, sizeof(VISAO));
+  if (!v)
+    return NULL;
+  v->tipo = tipo;
+  v->k = k;
+  v->operandos = (SET **)malloc(k * sizeof(SET *));
+  if (!v->operandos || !crescer_mult(v)) {
+    free(v->operandos);
+    free(v->tabela);
+    free(v);
+    return NULL;
+  }
+  for (size_t i = 0; i < k; i++)
+    v->operandos[i] = sets[i];
+  pthread_mutex_init(&v->trava, NULL);
+
+  // Multiplicidade inicial de cada elemento
+  int ok = 1;
+  for (size_t i = 0; i < k && ok; i++) {
+    ITERADOR it;
+    int valor;
+    set_iterador(sets[i], &it);
+    int32_t c;
+    while (ok && set_iterador_proximo(&it, &valor))
+      ok = somar_mult(v, valor, +1, &c);
+    iterador_finalizar(&it);
+  }
+
+  // Resultado inicial calculado de uma vez pelas operações de k conjuntos
+  SAIDA *saida = ok ? saida_vetor(0) : NULL;
+  if (saida && (tipo == VISAO_UNIAO ? set_uniao_k_emitir(sets, k, saida)
+                                    : set_interseccao_k_emitir(sets, k, saida))) {
+    size_t n;
+    int *chaves = saida_dados(saida, &n);
+    v->resultado = set_construir_ordenado(opt, chaves, n);
+  }
+  saida_apagar(&saida);
+
+  // A partir daqui cada alteração dos operandos chega à visão
+  size_t registrados = 0;
+  while (v->resultado && registrados < k &&
+         set_observar(sets[registrados], notificar_visao, v) == 1)
+    registrados++;
+
+  if (!v->resultado || registrados < k) {
+    for (size_t i = 0; i < registrados; i++)
+      set_desobservar(sets[i], notificar_visao, v);
+    v->k = 0;
+    visao_apagar(&v);
+    return NULL;
+  }
+  return v;
+}
+
+SET *visao_conjunto(VISAO *visao) { return visao ? visao->resultado : NULL; }
+
+int visao_erro(VISAO *visao) {
+  if (!visao)
+    return 1;
+  pthread_mutex_lock(&visao->trava);
+  int erro = visao->erro;
+  pthread_mutex_unlock(&visao->trava);
+  return erro;
+}
+
+void visao_apagar(VISAO **visao) {
+  if (!visao || !*visao)
+    return;
+  VISAO *v = *visao;
+  for (size_t i = 0; i < v->k; i++)
+    if (v->operandos[i])
+      set_desobservar(v->operandos[i], notificar_visao, v);
+  pthread_mutex_destroy(&v->trava);
+  set_apagar(&v->resultado);
+  free(v->operandos);
+  free(v->tabela);
+  free(v);
+  *visao = NULL;
+}
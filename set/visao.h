@@ -0,0 +1,69 @@
+#ifndef VISAO_H
+#define VISAO_H
+
+#include <stddef.h>
+
+#include "set.h"
+
+// Resultado materializado de uma operação, mantido em dia com os operandos.
+typedef struct visao VISAO;
+
+// Operações disponíveis para uma visão
+#define VISAO_UNIAO 0
+#define VISAO_INTERSECCAO 1
+
+/**
+ * @brief Cria uma visão da união ou intersecção de k conjuntos.
+ *
+ * O resultado é calculado uma vez e, a partir daí, cada set_inserir() ou
+ * set_remover() bem-sucedido em um operando atualiza a visão em O(log(n)):
+ * a visão guarda quantos operandos contêm cada elemento e o elemento está no
+ * resultado enquanto essa contagem for ao menos 1 (união) ou igual a k
+ * (intersecção). Operandos SET_SKIPLIST podem ser alterados por várias
+ * threads; o resultado fica correto assim que as alterações terminam, mesmo
+ * que as notificações tenham chegado fora de ordem.
+ *
+ * Um operando apagado deixa de ser acompanhado; o resultado fica com o
+ * último estado conhecido.
+ *
+ * @param tipo VISAO_UNIAO ou VISAO_INTERSECCAO.
+ * @param sets Vetor de ponteiros para os operandos.
+ * @param k Quantidade de operandos.
+ * @param opt Estrutura do conjunto resultado (qualquer uma, menos
+ *            SET_CONGELADO e SET_COMPRIMIDO).
+ * @return Ponteiro para a visão criada ou NULL em caso de erro.
+ */
+VISAO *visao_criar(int tipo, SET **sets, size_t k, int opt);
+
+/**
+ * @brief Acessa o resultado da visão.
+ *
+ * O conjunto pode ser lido com qualquer função de consulta (inclusive como
+ * operando de outras visões), mas não deve ser alterado diretamente.
+ *
+ * @param visao Ponteiro para a visão.
+ * @return Conjunto resultado, ou NULL se a visão for inválida.
+ */
+SET *visao_conjunto(VISAO *visao);
+
+/**
+ * @brief Informa se a visão deixou de acompanhar os operandos.
+ *
+ * Uma falta de memória ao registrar uma alteração deixa o resultado
+ * desatualizado para sempre; a visão deve então ser apagada e recriada.
+ *
+ * @param visao Ponteiro para a visão.
+ * @return 1 se alguma alteração se perdeu (ou a visão for inválida), 0 caso
+ *         contrário.
+ */
+int visao_erro(VISAO *visao);
+
+/**
+ * @brief Apaga a visão, desligando-a dos operandos.
+ *
+ * @param visao Endereço do ponteiro para a visão. Após a execução, o ponteiro
+ * será definido como NULL.
+ */
+void visao_apagar(VISAO **visao);
+
+#endif // VISAO_H